@@ -1,3 +1,5 @@
-Xpanda .\shaders\BBMOD_ShDefault --x .\Xshaders\ ANIMATED=false BATCHED=false
-Xpanda .\shaders\BBMOD_ShDefaultAnimated --x .\Xshaders\ ANIMATED=true BATCHED=false
-Xpanda .\shaders\BBMOD_ShDefaultBatched --x .\Xshaders\ ANIMATED=false BATCHED=true
+Xpanda .\shaders\BBMOD_ShDefault --x .\Xshaders\ ANIMATED=false BATCHED=false INFLUENCES_1=false INFLUENCES_2=false
+Xpanda .\shaders\BBMOD_ShDefaultAnimated --x .\Xshaders\ ANIMATED=true BATCHED=false INFLUENCES_1=false INFLUENCES_2=false
+Xpanda .\shaders\BBMOD_ShDefaultAnimated1 --x .\Xshaders\ ANIMATED=true BATCHED=false INFLUENCES_1=true INFLUENCES_2=false
+Xpanda .\shaders\BBMOD_ShDefaultAnimated2 --x .\Xshaders\ ANIMATED=true BATCHED=false INFLUENCES_1=false INFLUENCES_2=true
+Xpanda .\shaders\BBMOD_ShDefaultBatched --x .\Xshaders\ ANIMATED=false BATCHED=true INFLUENCES_1=false INFLUENCES_2=false
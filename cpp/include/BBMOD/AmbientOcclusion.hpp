@@ -0,0 +1,43 @@
+#pragma once
+
+#include <BBMOD/Model.hpp>
+#include <BBMOD/JobSystem.hpp>
+
+/** Number of vertices processed by a single job when baking occlusion. */
+#define BBMOD_AO_BATCH_SIZE 64
+
+/**
+ * Distance of ray origins from vertices along their normals, relative to the
+ * size of the model, which prevents the rays from hitting the surface they
+ * start on.
+ */
+#define BBMOD_AO_BIAS 0.0001f
+
+/**
+ * Maximum distance of occluders used when none is given, relative to the size
+ * of the model.
+ */
+#define BBMOD_AO_DEFAULT_DISTANCE 0.1f
+
+/**
+ * Bakes ambient occlusion of a static model into its vertex colors by casting
+ * cosine-distributed rays from each vertex into the hemisphere around its
+ * normal. Existing vertex colors are multiplied by the unoccluded fraction
+ * of the rays, meshes without vertex colors get them enabled, starting from
+ * white. Vertices with the same position and normal share one result.
+ *
+ * Occlusion is computed in the space of the vertices, using the BVH of the
+ * model if it has one or a temporary one otherwise.
+ *
+ * @param model The model. Models with bones are not supported.
+ * @param rayCount Number of rays per vertex.
+ * @param distance Maximum distance of occluders or 0 to use
+ * BBMOD_AO_DEFAULT_DISTANCE.
+ * @param bentNormals Replace vertex normals with the average direction of the
+ * unoccluded rays.
+ * @param jobSystem A job system used to process vertices in parallel.
+ *
+ * @return False if the model has bones.
+ */
+bool BakeAmbientOcclusion(SModel* model, size_t rayCount, float distance, bool bentNormals,
+	SJobSystem& jobSystem);
@@ -11,6 +11,8 @@
 
 struct SAnimationKey
 {
+	virtual ~SAnimationKey() = default;
+
 	virtual bool Save(std::ofstream& file);
 
 	double Time = 0.0;
@@ -48,10 +50,14 @@ struct SRotationKey : public SAnimationKey
 
 struct SAnimationNode
 {
+	~SAnimationNode();
+
 	bool Save(std::ofstream& file);
 
 	static SAnimationNode* Load(std::ifstream& file);
 
+	size_t GetSize() const;
+
 	float Index = 0.0f;
 
 	std::vector<SPositionKey*> PositionKeys;
@@ -61,12 +67,16 @@ struct SAnimationNode
 
 struct SAnimation
 {
+	~SAnimation();
+
 	static SAnimation* FromAssimp(struct aiAnimation* animation, SModel* model, const struct SConfig& config);
 
 	bool Save(std::string path);
 
 	static SAnimation* Load(std::string path);
 
+	size_t GetSize() const;
+
 	uint8_t Version = BBMOD_VERSION;
 
 	std::string Name;
@@ -0,0 +1,161 @@
+#pragma once
+
+#include <BBMOD/Vector3.hpp>
+#include <BBMOD/JobSystem.hpp>
+
+#include <cstdint>
+#include <fstream>
+#include <vector>
+
+/** Maximum number of triangles in a leaf node of a BVH. */
+#define BBMOD_BVH_MAX_LEAF_SIZE 4
+
+/** Number of bins used to evaluate the surface area heuristic. */
+#define BBMOD_BVH_BIN_COUNT 12
+
+/** Number of queries run by a single job. */
+#define BBMOD_BVH_QUERY_BATCH_SIZE 64
+
+/** Number of floats of a ray passed to RaycastBatch. */
+#define BBMOD_BVH_RAY_SIZE 7
+
+/** Number of floats of a sphere passed to OverlapSphereBatch. */
+#define BBMOD_BVH_SPHERE_SIZE 4
+
+/**
+ * Number of floats of a hit written by RaycastBatch and OverlapSphereBatch:
+ * distance (or -1 if nothing was hit), point, normal, mesh and triangle
+ * index.
+ */
+#define BBMOD_BVH_HIT_SIZE 9
+
+/**
+ * A node of a BVH. Interior nodes have Count 0, their first child directly
+ * follows them and Offset is the index of the second child. Leaf nodes
+ * contain Count triangles starting at index Offset.
+ */
+struct SBVHNode
+{
+	SBVHNode()
+		: Min VEC3_ZERO
+		, Max VEC3_ZERO
+	{
+	}
+
+	vec3_t Min;
+
+	vec3_t Max;
+
+	uint32_t Offset = 0;
+
+	uint32_t Count = 0;
+};
+
+/** A triangle stored in a BVH. */
+struct SBVHTriangle
+{
+	SBVHTriangle()
+		: A VEC3_ZERO
+		, B VEC3_ZERO
+		, C VEC3_ZERO
+	{
+	}
+
+	vec3_t A;
+
+	vec3_t B;
+
+	vec3_t C;
+
+	/** An index of the mesh which the triangle belongs to. */
+	uint32_t Mesh = 0;
+
+	/** An index of the triangle in the mesh. */
+	uint32_t Index = 0;
+};
+
+/** A result of a BVH query. */
+struct SBVHHit
+{
+	SBVHHit()
+		: Point VEC3_ZERO
+		, Normal VEC3_ZERO
+	{
+	}
+
+	/** A distance from the origin of the ray or the center of the sphere. */
+	float Distance = 0.0f;
+
+	/** The closest point on the hit triangle. */
+	vec3_t Point;
+
+	/**
+	 * The normal of the hit triangle facing the ray or a direction from the
+	 * point to the center of the sphere.
+	 */
+	vec3_t Normal;
+
+	uint32_t Mesh = 0;
+
+	uint32_t Triangle = 0;
+};
+
+/** A bounding volume hierarchy of triangles of a model, built using SAH. */
+struct SBVH
+{
+	/**
+	 * Builds a BVH over all triangles of a model, in the space of the model's
+	 * vertices.
+	 */
+	static SBVH* FromModel(const struct SModel* model);
+
+	bool Save(std::ofstream& file);
+
+	/** Loads a BVH. Returns nullptr if the file does not contain any. */
+	static SBVH* Load(std::ifstream& file);
+
+	/** Returns the size of a BVH in a file, including when there is none. */
+	static size_t GetSize(const SBVH* bvh);
+
+	/**
+	 * Finds the closest triangle hit by a ray. Triangles are hit from both
+	 * sides.
+	 *
+	 * @param origin The origin of the ray.
+	 * @param direction The direction of the ray. Does not need to be
+	 * normalized.
+	 * @param maxDistance The maximum distance from the origin.
+	 * @param hit Receives the closest hit.
+	 *
+	 * @return True if a triangle was hit.
+	 */
+	bool Raycast(const vec3_t origin, const vec3_t direction, float maxDistance, SBVHHit& hit) const;
+
+	/**
+	 * Finds the triangle closest to the center of a sphere which intersects
+	 * the sphere.
+	 *
+	 * @return True if a triangle intersects the sphere.
+	 */
+	bool OverlapSphere(const vec3_t center, float radius, SBVHHit& hit) const;
+
+	std::vector<SBVHNode> Nodes;
+
+	std::vector<SBVHTriangle> Triangles;
+};
+
+/**
+ * Casts rays, each stored as its origin, direction and maximum distance,
+ * using a job system and writes a hit for each of them.
+ *
+ * @return Number of rays which hit a triangle.
+ */
+size_t RaycastBatch(const SBVH* bvh, const float* rays, size_t count, float* hits, SJobSystem& jobSystem);
+
+/**
+ * Tests spheres, each stored as its center and radius, using a job system
+ * and writes a hit for each of them.
+ *
+ * @return Number of spheres which intersect a triangle.
+ */
+size_t OverlapSphereBatch(const SBVH* bvh, const float* spheres, size_t count, float* hits, SJobSystem& jobSystem);
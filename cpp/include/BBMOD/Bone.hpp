@@ -15,6 +15,8 @@ struct SBone
 
 	static SBone* Load(std::ifstream& file);
 
+	size_t GetSize() const;
+
 	std::string Name;
 
 	float Index = 0.0f;
@@ -0,0 +1,50 @@
+#pragma once
+
+#include <BBMOD/Model.hpp>
+
+/**
+ * Removes bone weights smaller than a threshold from vertices of a model and
+ * renormalizes the remaining ones, so that they add up to 1 again. The largest
+ * weight of each vertex is always kept. Bone indices and weights of each
+ * vertex are also sorted from the largest weight.
+ *
+ * @param model The model.
+ * @param threshold The smallest kept weight. Use 0 to only sort the weights.
+ *
+ * @return Number of removed weights.
+ */
+size_t PruneBoneWeights(SModel* model, float threshold);
+
+/**
+ * Splits meshes with bones of a model by the number of bones which influence
+ * their vertices into meshes with 1, 2 and 4 influences per vertex, which take
+ * less memory and are skinned by cheaper shader variants. Each triangle goes
+ * to the class of its vertex with the most influences. Meshes whose triangles
+ * all fall into a single class are not split, only their vertex format is
+ * reduced. New meshes use the same material and are added to all nodes which
+ * contain the original mesh.
+ *
+ * Bone weights must be sorted from the largest first, see PruneBoneWeights.
+ *
+ * @param model The model.
+ *
+ * @return Number of added meshes.
+ */
+size_t SplitByBoneInfluences(SModel* model);
+
+/**
+ * Converts meshes without bones attached to bone nodes of a model into
+ * skinned meshes, where each vertex is influenced only by the bone, and merges
+ * all skinned meshes which use the same material and have the same vertex
+ * attributes into one. Meshes whose vertices differ only in the number of
+ * bone influences are merged too. Meshes of nodes
+ * which are not bones belong to the closest bone above them. The vertices are
+ * transformed into the bind pose, so they follow the bone like the rest of the
+ * model. Meshes left without any node are removed and new meshes are added to
+ * the root node.
+ *
+ * @param model The model.
+ *
+ * @return Number of converted meshes.
+ */
+size_t MergeRigidMeshes(SModel* model);
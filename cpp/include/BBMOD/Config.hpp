@@ -16,6 +16,21 @@
  * if the model doesn't have any. */
 #define BBMOD_NORMALS_SMOOTH 2
 
+/** Default maximum angle between normals of faces which are smoothed together
+ * when generating smooth normals, in degrees. */
+#define BBMOD_NORMALS_DEFAULT_ANGLE 175.0f
+
+/** Maximum number of instances in a dynamic batch, given by the size of the
+ * instance data array in shader BBMOD_ShDefaultBatched (128 vec4s, two per
+ * instance). */
+#define BBMOD_MAX_BATCH_SIZE 64
+
+/** Default maximum angle between normals of welded vertices, in degrees. */
+#define BBMOD_WELD_DEFAULT_ANGLE 1.0f
+
+/** Default maximum distance between texture coordinates of welded vertices. */
+#define BBMOD_WELD_DEFAULT_UV_DISTANCE 0.0001f
+
 /** Configuration structure. */
 struct SConfig
 {
@@ -41,6 +56,24 @@ struct SConfig
 	/** Disable saving bones and animations. */
 	bool DisableBones = false;
 
+	/**
+	 * Split skinned meshes into meshes with 1, 2 and 4 bone influences per
+	 * vertex, rendered by matching shader variants.
+	 */
+	bool SplitInfluences = false;
+
+	/**
+	 * Bone weights smaller than this are removed and the remaining weights
+	 * renormalized. Use 0 to keep all weights.
+	 */
+	float WeightThreshold = 0.0f;
+
+	/**
+	 * Skin meshes attached to bones to the bones and merge skinned meshes
+	 * which use the same material and have the same vertex attributes.
+	 */
+	bool MergeRigid = false;
+
 	/** Flip texture coordinates horizontally. */
 	bool FlipTextureHorizontally = false;
 
@@ -59,6 +92,9 @@ struct SConfig
 	/** Reduces number of meshes. */
 	bool OptimizeMeshes = true;
 
+	/** Reorders triangles of meshes to reduce overdraw. */
+	bool OptimizeOverdraw = false;
+
 	/**
 	 * Configures generation of normal vectors.
 	 * 
@@ -67,4 +103,104 @@ struct SConfig
 	 * @see BBMOD_NORMALS_SMOOTH
 	 */
 	size_t GenNormals = BBMOD_NORMALS_SMOOTH;
+
+	/**
+	 * Maximum angle between normals of faces which are smoothed together
+	 * when generating smooth normals, in degrees.
+	 */
+	float NormalAngle = BBMOD_NORMALS_DEFAULT_ANGLE;
+
+	/**
+	 * Generate normals and tangents, remove degenerate triangles and skip
+	 * joining identical vertices using the converter's own multi-threaded
+	 * implementations instead of Assimp's post-processing steps.
+	 */
+	bool NativePostProcess = false;
+
+	/**
+	 * Number of copies of each mesh saved with vertex ids, so the model can
+	 * be used in a dynamic batch without building it at runtime. Use 0 to
+	 * disable. Ignored for models with bones.
+	 *
+	 * @see BBMOD_MAX_BATCH_SIZE
+	 */
+	size_t BatchSize = 0;
+
+	/**
+	 * Store meshes which are identical up to a rotation and a translation
+	 * only once and save their transforms into a "*.bbinst" file. Disables
+	 * OptimizeMeshes, which would join the instances into one mesh.
+	 */
+	bool DetectInstances = false;
+
+	/**
+	 * Size of cells of a uniform grid into which static models are baked or
+	 * 0 to disable. Triangles are distributed into the cells, triangles with
+	 * the same material are joined within each cell and bounds of the cells
+	 * are saved into a "*.bbcell" file. Ignored with DetectInstances.
+	 */
+	float CellSize = 0.0f;
+
+	/** Build a BVH of triangles of the model for raycasts and other queries. */
+	bool BuildBVH = false;
+
+	/**
+	 * Maximum number of convex hulls into which each mesh is decomposed or 0
+	 * to disable. The hulls are saved into a "*.bbhull" file. If the model
+	 * has nodes with names starting with BBMOD_COLLISION_NODE_PREFIX, only
+	 * their meshes are decomposed and they are removed from the model.
+	 */
+	size_t HullCount = 0;
+
+	/** Maximum number of vertices of a convex hull. */
+	size_t HullVertexCount = 32;
+
+	/**
+	 * Number of rays per vertex used to bake ambient occlusion into vertex
+	 * colors or 0 to disable. Ignored for models with bones.
+	 */
+	size_t AORayCount = 0;
+
+	/**
+	 * Maximum distance of occluders when baking ambient occlusion or 0 to
+	 * use a tenth of the size of the model.
+	 */
+	float AODistance = 0.0f;
+
+	/**
+	 * Replace vertex normals with bent normals when baking ambient
+	 * occlusion.
+	 */
+	bool BentNormals = false;
+
+	/**
+	 * Save position-only meshes for depth-only passes into a "*.bbshdw" file,
+	 * one for each node with meshes. Ignored for models with bones.
+	 */
+	bool ShadowProxies = false;
+
+	/**
+	 * Number of cells of a grid along the longest side of a node, in which
+	 * vertices of shadow proxies are clustered, or 0 to disable
+	 * simplification.
+	 */
+	size_t ShadowGridSize = 0;
+
+	/**
+	 * Save meshes as triangle strips joined by degenerate triangles, where it
+	 * reduces their vertex count. Ignored for batched models.
+	 */
+	bool TriangleStrips = false;
+
+	/**
+	 * Maximum distance between positions of vertices which are welded into
+	 * one or 0 to disable welding.
+	 */
+	float WeldDistance = 0.0f;
+
+	/** Maximum angle between normals of welded vertices, in degrees. */
+	float WeldAngle = BBMOD_WELD_DEFAULT_ANGLE;
+
+	/** Maximum distance between texture coordinates of welded vertices. */
+	float WeldUVDistance = BBMOD_WELD_DEFAULT_UV_DISTANCE;
 };
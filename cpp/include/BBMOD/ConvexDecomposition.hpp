@@ -0,0 +1,65 @@
+#pragma once
+
+#include <BBMOD/Model.hpp>
+
+#include <cstdint>
+#include <string>
+#include <vector>
+
+/**
+ * Prefix of names of nodes which contain collision geometry. If a model has
+ * any, only their meshes are decomposed into convex hulls and they are
+ * removed from the model.
+ */
+#define BBMOD_COLLISION_NODE_PREFIX "COL_"
+
+/**
+ * Maximum depth of concavities of a convex hull, relative to the size of the
+ * mesh, under which the hull is not split any further.
+ */
+#define BBMOD_HULL_CONCAVITY 0.02f
+
+/**
+ * Number of directions in which extreme points of a mesh are searched when
+ * building a hull. Limits the number of vertices of a hull.
+ */
+#define BBMOD_HULL_DIRECTION_COUNT 128
+
+/** A convex hull created by DecomposeConvex. */
+struct SHull
+{
+	/** An index of the node which references the decomposed mesh. */
+	size_t Node = 0;
+
+	/** Vertices of the hull, three floats each. */
+	std::vector<float> Vertices;
+
+	/**
+	 * Indices of vertices of triangles of the hull, ordered so that the cross
+	 * product of B - A and C - A points out of the hull.
+	 */
+	std::vector<uint16_t> Indices;
+};
+
+/**
+ * Approximates meshes of a model by sets of convex hulls, which are cheaper
+ * to collide with than the meshes themselves. Each mesh starts as a single
+ * hull, which is repeatedly split by an axis-aligned plane through its deepest
+ * concavity until it is convex enough or the hull count is reached. Hulls
+ * are in the space of the mesh vertices.
+ *
+ * If the model has nodes with names starting with BBMOD_COLLISION_NODE_PREFIX,
+ * only their meshes are decomposed and they are removed from the model.
+ * Otherwise all meshes are decomposed. Flat meshes do not produce any hulls.
+ *
+ * @param model The model.
+ * @param maxHulls Maximum number of hulls per mesh.
+ * @param maxVertices Maximum number of vertices per hull, at least 4.
+ * @param hulls An array to write the created hulls into.
+ *
+ * @return Number of removed collision meshes.
+ */
+size_t DecomposeConvex(SModel* model, size_t maxHulls, size_t maxVertices, std::vector<SHull>& hulls);
+
+/** Saves hulls into a "*.bbhull" file. Returns false on fail. */
+bool SaveHulls(std::string path, const std::vector<SHull>& hulls);
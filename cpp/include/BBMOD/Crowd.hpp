@@ -0,0 +1,70 @@
+#pragma once
+
+#include <BBMOD/Pose.hpp>
+#include <BBMOD/JobSystem.hpp>
+
+#include <vector>
+
+/** Number of animation instances updated by a single job. */
+#define BBMOD_CROWD_BATCH_SIZE 4
+
+/** A looping animation played on an instance of a model. */
+struct SAnimationInstance
+{
+	SAnimationInstance(const SModel* model)
+		: Pose(model)
+		, PoseFrom(model)
+	{
+	}
+
+	/**
+	 * Starts playing an animation.
+	 *
+	 * @param animation The animation to play.
+	 * @param time The starting time (in seconds).
+	 * @param transition Duration of a crossfade from the current pose (in
+	 * seconds) or 0 for none.
+	 */
+	void Play(const SAnimation* animation, double time, double transition);
+
+	/**
+	 * Advances the animation time, samples the animation and writes the bone
+	 * transforms into Transform.
+	 *
+	 * @param deltaTime Time passed since the last update (in seconds).
+	 */
+	void Update(double deltaTime);
+
+	SPose Pose;
+
+	/** The pose from which a transition started. */
+	SPose PoseFrom;
+
+	/** Duration of the current transition (in seconds). */
+	double TransitionDuration = 0.0;
+
+	/** Time since the current transition started (in seconds). */
+	double TransitionTime = 0.0;
+
+	/** The played animation or nullptr. */
+	const SAnimation* Animation = nullptr;
+
+	/** The current time (in seconds). */
+	double Time = 0.0;
+
+	/** Playback speed multiplier. */
+	double Speed = 1.0;
+
+	/** An array of BoneCount * 16 floats to write the bone transforms into or nullptr. */
+	float* Transform = nullptr;
+};
+
+/**
+ * Updates animation instances in parallel. Use SJobSystem::Wait before
+ * reading their transforms.
+ *
+ * @param instances The instances to update. Can contain nullptr.
+ * @param deltaTime Time passed since the last update (in seconds).
+ * @param jobSystem The job system to update the instances in.
+ */
+void UpdateAnimationInstances(std::vector<SAnimationInstance*>& instances, double deltaTime, SJobSystem& jobSystem);
@@ -0,0 +1,45 @@
+#pragma once
+
+#include <BBMOD/Model.hpp>
+#include <BBMOD/Animation.hpp>
+
+#include <string>
+#include <vector>
+
+/** Frame rate used when estimating per-frame costs. */
+#define BBMOD_INSPECT_FPS 60.0
+
+/** A problem found in a model or an animation. */
+struct SFinding
+{
+	/** Description of the problem. */
+	std::string Message;
+
+	/** A converter option (or other action) which fixes the problem. */
+	std::string Recommendation;
+};
+
+/**
+ * Prints size breakdown, vertex statistics and rendering cost of a model
+ * and appends found problems into findings.
+ *
+ * @param model The model to inspect.
+ * @param path Path to the model file.
+ * @param findings A vector to append found problems into.
+ */
+void InspectModel(SModel* model, std::string path, std::vector<SFinding>& findings);
+
+/**
+ * Prints size breakdown, key statistics and an estimated per-frame cost of
+ * playing an animation and appends found problems into findings.
+ *
+ * @param animation The animation to inspect.
+ * @param model The model that the animation belongs to or nullptr if it is
+ * not known. This is used to print node names and to count bones.
+ * @param path Path to the animation file.
+ * @param findings A vector to append found problems into.
+ */
+void InspectAnimation(SAnimation* animation, SModel* model, std::string path, std::vector<SFinding>& findings);
+
+/** Prints found problems together with recommendations. */
+void PrintFindings(const std::vector<SFinding>& findings);
@@ -0,0 +1,50 @@
+#pragma once
+
+#include <BBMOD/Model.hpp>
+
+#include <string>
+#include <vector>
+
+/**
+ * Maximum distance of vertices of two meshes, relative to the size of the
+ * mesh, for them to be considered instances of the same mesh.
+ */
+#define BBMOD_INSTANCE_EPSILON 0.0001f
+
+/** Maximum distance of normal and tangent vectors of instanced vertices. */
+#define BBMOD_INSTANCE_NORMAL_EPSILON 0.001f
+
+/** A placement of a mesh found by FindInstances. */
+struct SInstance
+{
+	SInstance() : Transform MATRIX_IDENTITY
+	{
+	}
+
+	/** An index of the mesh in the model. */
+	size_t Mesh = 0;
+
+	/**
+	 * Transforms vertices of the mesh into the space of the model, including
+	 * transforms of all nodes under the root node.
+	 */
+	matrix_t Transform;
+};
+
+/**
+ * Finds meshes which are identical up to a rotation and a translation, with
+ * vertices in the same order, as produced by copying a mesh in a modeling
+ * tool or by aiProcess_OptimizeGraph pre-transforming instanced meshes.
+ * Removes all but the first one of them from the model and writes a
+ * transform of each mesh referenced by a node into instances. Models with
+ * bones are not changed.
+ *
+ * @param model The model.
+ * @param instances An array to write the instances into.
+ *
+ * @return Number of removed meshes.
+ */
+size_t FindInstances(SModel* model, std::vector<SInstance>& instances);
+
+/** Saves instances into a "*.bbinst" file. Returns false on fail. */
+bool SaveInstances(std::string path, const std::vector<SInstance>& instances);
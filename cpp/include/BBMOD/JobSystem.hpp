@@ -0,0 +1,104 @@
+#pragma once
+
+#include <atomic>
+#include <condition_variable>
+#include <deque>
+#include <functional>
+#include <mutex>
+#include <thread>
+#include <vector>
+
+/** A range of items processed by a single job. */
+struct SJob
+{
+	size_t Begin = 0;
+
+	size_t End = 0;
+};
+
+/** A queue of jobs owned by a worker thread. */
+struct SJobQueue
+{
+	std::mutex Mutex;
+
+	std::deque<SJob> Jobs;
+};
+
+/**
+ * A pool of worker threads which process ranges of items in parallel.
+ *
+ * Each worker takes jobs from its own queue and when it runs out of them, it
+ * steals jobs from queues of other workers. A thread waiting for the jobs to
+ * finish helps with processing them.
+ */
+struct SJobSystem
+{
+	/**
+	 * Creates a job system.
+	 *
+	 * @param threadCount Number of worker threads. Use 0 for one less than
+	 * the number of hardware threads, since the waiting thread works too.
+	 */
+	SJobSystem(size_t threadCount = 0);
+
+	~SJobSystem();
+
+	/**
+	 * Splits items into jobs and starts processing them. Waits for the
+	 * previously dispatched jobs first. Does not wait for the new jobs to
+	 * finish, use Wait for that.
+	 *
+	 * @param count Number of items.
+	 * @param batchSize Maximum number of items processed by a single job.
+	 * @param function A function called with a range of items [begin, end).
+	 */
+	void Dispatch(size_t count, size_t batchSize, std::function<void(size_t, size_t)> function);
+
+	/** Processes jobs until all dispatched jobs are finished. */
+	void Wait();
+
+	/** Returns true if all dispatched jobs are finished. */
+	bool IsFinished() const
+	{
+		return Pending == 0;
+	}
+
+	size_t GetThreadCount() const
+	{
+		return Threads.size();
+	}
+
+	/**
+	 * Takes a job from the queue of a worker or steals one from other
+	 * queues. A thread without a queue passes Queues.size().
+	 */
+	bool TakeJob(size_t queue, SJob& job);
+
+	/** Takes and processes a single job. Returns false if there was none. */
+	bool RunJob(size_t queue);
+
+	void WorkerMain(size_t queue);
+
+	std::vector<std::thread> Threads;
+
+	/** One queue per worker thread. */
+	std::vector<SJobQueue> Queues;
+
+	std::function<void(size_t, size_t)> Function;
+
+	/** Number of dispatched jobs which are not finished yet. */
+	std::atomic<size_t> Pending{ 0 };
+
+	/** Incremented on each Dispatch to wake up workers. */
+	size_t Generation = 0;
+
+	bool Stop = false;
+
+	std::mutex WakeMutex;
+
+	std::condition_variable WakeCondition;
+
+	std::mutex DoneMutex;
+
+	std::condition_variable DoneCondition;
+};
@@ -0,0 +1,50 @@
+#pragma once
+
+#include <BBMOD/Model.hpp>
+
+#include <string>
+#include <vector>
+
+/** A cell of a uniform grid created by BakeCells. */
+struct SCell
+{
+	SCell()
+		: Min VEC3_ZERO
+		, Max VEC3_ZERO
+	{
+	}
+
+	/** Coordinates of the cell in the grid. */
+	int X = 0;
+
+	int Y = 0;
+
+	int Z = 0;
+
+	/** Minimum corner of an axis-aligned box containing all vertices. */
+	vec3_t Min;
+
+	/** Maximum corner of an axis-aligned box containing all vertices. */
+	vec3_t Max;
+};
+
+/**
+ * Transforms meshes of a static model by transforms of nodes which reference
+ * them, distributes their triangles into cells of a uniform grid by their
+ * centers and joins triangles with the same material within each cell into
+ * a single mesh.
+ *
+ * The node hierarchy of the model is replaced with a root node with a child
+ * node for each cell, in the same order as the cells, so the cells can be
+ * hidden using their nodes.
+ *
+ * @param model The model to bake. Models with bones are not supported.
+ * @param cellSize The size of a cell.
+ * @param cells An array to write the created cells into.
+ *
+ * @return False if the model has bones.
+ */
+bool BakeCells(SModel* model, float cellSize, std::vector<SCell>& cells);
+
+/** Saves cells into a "*.bbcell" file. Returns false on fail. */
+bool SaveCells(std::string path, float cellSize, const std::vector<SCell>& cells);
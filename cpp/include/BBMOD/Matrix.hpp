@@ -37,7 +37,7 @@ static inline float matrix_determinant(const matrix_t m)
 
 static inline void matrix_inverse(matrix_t m)
 {
-	static matrix_t n;
+	matrix_t n;
 	matrix_copy(m, n);
 	float s = 1.0f / matrix_determinant(m);
 	m[0] = s * ((n[6] * n[11] * n[13]) - (n[7] * n[10] * n[13]) + (n[7] * n[9] * n[14]) - (n[5] * n[11] * n[14]) - (n[6] * n[9] * n[15]) + (n[5] * n[10] * n[15]));
@@ -70,7 +70,7 @@ static inline void matrix_transpose(matrix_t m)
 
 static inline void matrix_multiply(matrix_t m1, const matrix_t m2)
 {
-	static matrix_t _m1;
+	matrix_t _m1;
 	matrix_copy(m1, _m1);
 
 	m1[0] = (_m1[0] * m2[0]) + (_m1[1] * m2[4]) + (_m1[2] * m2[8]) + (_m1[3] * m2[12]);
@@ -93,3 +93,12 @@ static inline void matrix_multiply(matrix_t m1, const matrix_t m2)
 	m1[11] = (_m1[8] * m2[3]) + (_m1[9] * m2[7]) + (_m1[10] * m2[11]) + (_m1[11] * m2[15]);
 	m1[15] = (_m1[12] * m2[3]) + (_m1[13] * m2[7]) + (_m1[14] * m2[11]) + (_m1[15] * m2[15]);
 }
+
+/** Transforms a row vector [v[0], v[1], v[2], w] by a matrix and writes the
+ * first three components of the result into out. */
+static inline void matrix_transform_vec3(const matrix_t m, const float* v, float w, float* out)
+{
+	out[0] = (v[0] * m[0]) + (v[1] * m[4]) + (v[2] * m[8]) + (w * m[12]);
+	out[1] = (v[0] * m[1]) + (v[1] * m[5]) + (v[2] * m[9]) + (w * m[13]);
+	out[2] = (v[0] * m[2]) + (v[1] * m[6]) + (v[2] * m[10]) + (w * m[14]);
+}
@@ -9,6 +9,15 @@
 #include <vector>
 #include <fstream>
 
+/** Vertices of a mesh form a list of triangles. */
+#define BBMOD_PRIMITIVE_TRIANGLE_LIST 0
+
+/**
+ * Vertices of a mesh form a triangle strip. Separate strips are joined using
+ * degenerate triangles.
+ */
+#define BBMOD_PRIMITIVE_TRIANGLE_STRIP 1
+
 struct SVertex
 {
 	SVertex()
@@ -29,7 +38,7 @@ struct SVertex
 	vec3_t Position;
 	vec3_t Normal;
 	vec2_t Texture;
-	uint32_t Color = 0;
+	uint32_t Color = 0xFFFFFFFF;
 	vec3_t Tangent;
 	float BitangentSign = 1.0;
 	vec4_t Bones;
@@ -39,15 +48,38 @@ struct SVertex
 
 struct SMesh
 {
+	~SMesh();
+
 	static SMesh* FromAssimp(struct aiMesh* mesh, struct SModel* model, const struct SConfig& config);
 
 	bool Save(std::ofstream& file);
 
-	static SMesh* Load(std::ifstream& file, SVertexFormat* vertexFormat);
+	static SMesh* Load(std::ifstream& file);
+
+	size_t GetSize() const;
 
+	/** Returns the number of triangles, including degenerate ones in strips. */
+	size_t GetTriangleCount() const;
+
+	/**
+	 * Writes vertices of the mesh as a list of triangles, with degenerate
+	 * triangles of strips left out. The vertices are owned by the mesh.
+	 */
+	void GetTriangleList(std::vector<const SVertex*>& out) const;
+
+	/**
+	 * Vertex format of the mesh, owned by the mesh and shared by its vertices.
+	 * Includes only attributes which the mesh actually has.
+	 */
 	SVertexFormat* VertexFormat = nullptr;
 
 	size_t MaterialIndex = 0;
 
+	/**
+	 * @see BBMOD_PRIMITIVE_TRIANGLE_LIST
+	 * @see BBMOD_PRIMITIVE_TRIANGLE_STRIP
+	 */
+	uint8_t PrimitiveType = BBMOD_PRIMITIVE_TRIANGLE_LIST;
+
 	std::vector<SVertex*> Data;
 };
@@ -6,16 +6,45 @@
 #include <BBMOD/Bone.hpp>
 #include <BBMOD/Mesh.hpp>
 #include <BBMOD/Matrix.hpp>
+#include <BBMOD/BVH.hpp>
 
 #include <vector>
 #include <string>
 
+/** Sizes of individual sections of a BBMOD file in bytes. */
+struct SModelSections
+{
+	size_t GetTotal() const
+	{
+		return (Header + VertexFormat + Meshes + InverseTransform
+			+ Nodes + Bones + Materials + BVH);
+	}
+
+	size_t Header = 0;
+
+	size_t VertexFormat = 0;
+
+	size_t Meshes = 0;
+
+	size_t InverseTransform = 0;
+
+	size_t Nodes = 0;
+
+	size_t Bones = 0;
+
+	size_t Materials = 0;
+
+	size_t BVH = 0;
+};
+
 struct SModel
 {
 	SModel() : InverseTransformMatrix MATRIX_IDENTITY
 	{
 	}
 
+	~SModel();
+
 	static SModel* FromAssimp(const struct aiScene* scene, const SConfig& config);
 
 	SBone* FindBoneByName(std::string name) const;
@@ -28,10 +57,29 @@ struct SModel
 
 	static SModel* Load(std::string path);
 
+	SModelSections GetSections() const;
+
+	/**
+	 * Replicates each mesh batchSize times and assigns each copy its index as
+	 * the vertex id, so the model can be rendered in a dynamic batch. All
+	 * meshes get the vertex format of the model, with attributes which they
+	 * do not have set to their default values.
+	 *
+	 * @return False if the model has bones and cannot be batched.
+	 */
+	bool MakeBatched(size_t batchSize);
+
 	unsigned char Version = BBMOD_VERSION;
 
+	/**
+	 * A vertex format with all attributes used by any of the meshes. Each
+	 * mesh has its own vertex format with only the attributes it uses.
+	 */
 	SVertexFormat* VertexFormat = nullptr;
 	
+	/** Number of copies of each mesh made by MakeBatched or 0. */
+	size_t BatchSize = 0;
+
 	std::vector<SMesh*> Meshes;
 
 	matrix_t InverseTransformMatrix;
@@ -45,4 +93,7 @@ struct SModel
 	std::vector<SBone*> Skeleton;
 
 	std::vector<std::string> MaterialNames;
+
+	/** A BVH of triangles of the model used by queries or nullptr. */
+	SBVH* BVH = nullptr;
 };
@@ -0,0 +1,49 @@
+#pragma once
+
+#include <string>
+#include <vector>
+
+/**
+ * A BBMOD file repacked into a layout which GML can load without parsing
+ * vertices or recursing into nodes. All sizes are 32-bit unsigned integers.
+ *
+ * - Vertex format (7 bools) and batch size.
+ * - Number of meshes and a descriptor for each mesh: material index,
+ *   primitive type, vertex format of the mesh as a bit mask (bit i is set if
+ *   the i-th of the 7 attributes is enabled, bits 8 to 15 hold the number of
+ *   bone influences), offset of its vertex data from the start of the blob
+ *   and number of vertices.
+ * - The global inverse transform matrix.
+ * - Number of nodes of the model, number of node entries and the node
+ *   entries in pre-order. Each entry starts with a 32-bit signed index of the
+ *   parent entry (-1 for the root node), followed by the node as it is saved
+ *   in the file, except for its child nodes.
+ * - Number of bones and the bones as they are saved in the file.
+ * - Number of materials and their names.
+ * - Vertex data of all meshes, stored contiguously.
+ */
+struct SModelBlob
+{
+	/**
+	 * Loads a BBMOD file and repacks it into a blob.
+	 *
+	 * @param path Path to the file.
+	 *
+	 * @return The created blob or nullptr if the file could not be read or it
+	 * is not a valid BBMOD file.
+	 */
+	static SModelBlob* Load(std::string path);
+
+	/**
+	 * Repacks BBMOD file data into a blob.
+	 *
+	 * @param data The file data, including the header.
+	 * @param size The size of the file data in bytes.
+	 *
+	 * @return The created blob or nullptr if the data is not a valid BBMOD
+	 * file.
+	 */
+	static SModelBlob* FromMemory(const unsigned char* data, size_t size);
+
+	std::vector<unsigned char> Data;
+};
@@ -12,10 +12,14 @@ struct SNode
 	{
 	}
 
+	~SNode();
+
 	bool Save(std::ofstream& file);
 
 	static SNode* Load(std::ifstream& file);
 
+	size_t GetSize() const;
+
 	std::string Name;
 
 	float Index = 0.0f;
@@ -0,0 +1,42 @@
+#pragma once
+
+#include <BBMOD/Model.hpp>
+
+/**
+ * Maximum number of triangles in a cluster, which is moved as a whole when
+ * reordering triangles for less overdraw.
+ */
+#define BBMOD_OVERDRAW_CLUSTER_SIZE 64
+
+/** Width and height of the views in which overdraw is measured, in pixels. */
+#define BBMOD_OVERDRAW_VIEWPORT 256
+
+/**
+ * Reorders triangles of a triangle list mesh so that triangles facing away
+ * from the center of the mesh are drawn first, which lets the depth test
+ * reject more of the triangles behind them. Consecutive triangles sharing a
+ * vertex are kept together in clusters of at most BBMOD_OVERDRAW_CLUSTER_SIZE
+ * triangles, which are sorted by the distance of their center from the center
+ * of the mesh along their average normal.
+ *
+ * @param mesh The mesh. Triangle strips are not supported.
+ *
+ * @return False if the mesh is a triangle strip.
+ */
+bool OptimizeOverdraw(SMesh* mesh);
+
+/** Reorders triangles of all meshes of a model. @see OptimizeOverdraw */
+void OptimizeOverdraw(SModel* model);
+
+/**
+ * Estimates overdraw of a model by rasterizing its meshes in their order
+ * into orthographic views from all six axis directions, with back faces
+ * culled and the depth test enabled.
+ *
+ * @param model The model.
+ *
+ * @return The number of pixels which passed the depth test divided by the
+ * number of covered pixels, i.e. 1 for no overdraw, or 0 if no pixels were
+ * covered.
+ */
+float AnalyzeOverdraw(const SModel* model);
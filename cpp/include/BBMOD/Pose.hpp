@@ -0,0 +1,119 @@
+#pragma once
+
+#include <BBMOD/Model.hpp>
+#include <BBMOD/Animation.hpp>
+
+#include <cstdint>
+#include <utility>
+#include <vector>
+
+/** Weights of nodes of a model used when blending poses. */
+struct SPoseMask
+{
+	SPoseMask(const SModel* model);
+
+	/**
+	 * Sets a weight of a node.
+	 *
+	 * @param index The index of the node.
+	 * @param weight The new weight of the node, from 0 to 1.
+	 * @param children If true, then the weight is set to all descendants of
+	 * the node too, e.g. to the whole upper body when given the spine.
+	 *
+	 * @return False if the model does not have such node.
+	 */
+	bool SetWeight(size_t index, float weight, bool children);
+
+	const SModel* Model = nullptr;
+
+	/** Weights of nodes, 0 by default. */
+	std::vector<float> Weights;
+};
+
+/**
+ * A pose of a model, i.e. local transforms of its nodes sampled from an
+ * animation, and world transforms computed from them.
+ *
+ * All buffers are allocated in the constructor, so sampling and transforming
+ * the pose does not allocate memory. Different poses can be used from
+ * different threads at once.
+ */
+struct SPose
+{
+	SPose(const SModel* model);
+
+	/**
+	 * Samples an animation into local transforms of nodes. Nodes which are
+	 * not affected by the animation use their TransformMatrix instead.
+	 *
+	 * @param animation The animation to sample.
+	 * @param time The animation time (in tics).
+	 * @param interpolate If false, then the closest previous keys are used
+	 * without interpolation.
+	 */
+	void Sample(const SAnimation* animation, double time, bool interpolate = true);
+
+	/** Copies local transforms of nodes from a pose of the same model. */
+	void Copy(const SPose& other);
+
+	/**
+	 * Blends local transforms of nodes towards another pose of the same
+	 * model. Positions are interpolated linearly and rotations with nlerp.
+	 * Nodes not animated in the other pose are kept as they are.
+	 *
+	 * @param other The pose to blend towards.
+	 * @param factor The blend factor, 0 keeps this pose, 1 results in the
+	 * other pose.
+	 * @param mask Weights of individual nodes, multiplied by factor, or
+	 * nullptr to blend all nodes. Used for example to play a different
+	 * animation on the upper body.
+	 */
+	void Blend(const SPose& other, float factor, const SPoseMask* mask = nullptr);
+
+	/**
+	 * Computes transforms of all nodes and writes transforms of bones into
+	 * an array of BoneCount * 16 floats, which can be passed to the u_mBones
+	 * uniform.
+	 *
+	 * @param transform The array to write the bone transforms into.
+	 */
+	void Transform(float* transform);
+
+	/** Returns a transform of a node (without bone offset) computed in Transform. */
+	const float* GetNodeTransform(size_t index) const
+	{
+		return &NodeTransform[index * 16];
+	}
+
+	const SModel* Model = nullptr;
+
+	/** Positions of nodes, 3 floats per node. */
+	std::vector<float> Positions;
+
+	/** Rotations of nodes, 4 floats per node. */
+	std::vector<float> Rotations;
+
+	/** Non-zero for nodes with position and rotation sampled from an animation. */
+	std::vector<uint8_t> Animated;
+
+	/** Indices of position keys used last time, to speed up searching keys. */
+	std::vector<size_t> PositionKeyLast;
+
+	/** Indices of rotation keys used last time, to speed up searching keys. */
+	std::vector<size_t> RotationKeyLast;
+
+	/** The animation sampled last time. */
+	const SAnimation* AnimationLast = nullptr;
+
+	/** The animation time sampled last time. */
+	double TimeLast = 0.0;
+
+	/** Transforms of nodes relative to the model's root, 16 floats per node. */
+	std::vector<float> NodeMatrix;
+
+	/** Transforms of nodes including the model's inverse transform, 16 floats per node. */
+	std::vector<float> NodeTransform;
+
+	/** A stack of nodes and indices of their parents used in Transform. */
+	std::vector<std::pair<const SNode*, size_t>> Stack;
+};
@@ -0,0 +1,69 @@
+#pragma once
+
+#include <BBMOD/Model.hpp>
+#include <BBMOD/JobSystem.hpp>
+
+/** Number of triangles or vertices processed by a single post-processing job. */
+#define BBMOD_POST_PROCESS_BATCH_SIZE 1024
+
+/**
+ * Number of shards into which vertices are distributed by hashes of their
+ * positions, so that the shards can be sorted in parallel.
+ */
+#define BBMOD_POST_PROCESS_SHARD_COUNT 256
+
+/**
+ * Removes triangles with zero area from meshes of a model, i.e. triangles
+ * which have two vertices with the same position or all vertices on a line.
+ * Meshes left without any triangles are removed from the model.
+ *
+ * @param model The model.
+ * @param jobSystem A job system used to process triangles in parallel.
+ *
+ * @return Number of removed triangles.
+ */
+size_t RemoveDegenerates(SModel* model, SJobSystem& jobSystem);
+
+/**
+ * Generates normal vectors for meshes of a model which do not have any. The
+ * normal of a vertex is an average of normals of triangles which share its
+ * position, weighted by their angles at the vertex. Only triangles whose
+ * normals form an angle smaller than the given one with the normal of the
+ * vertex's own triangle are included, which keeps hard edges.
+ *
+ * @param model The model.
+ * @param angle Maximum angle between normals of smoothed triangles, in
+ * degrees. Use 0 for flat normals.
+ * @param flip Flip the normals, e.g. because the winding order of vertices
+ * was inverted.
+ * @param jobSystem A job system used to process vertices in parallel.
+ *
+ * @return Number of meshes which got normal vectors.
+ */
+size_t GenerateNormals(SModel* model, float angle, bool flip, SJobSystem& jobSystem);
+
+/**
+ * Generates tangent vectors and bitangent signs for meshes of a model which
+ * have normals and texture coordinates, but no tangents. Tangents and
+ * bitangents of each triangle are computed from the derivatives of texture
+ * coordinates U and V along its edges. Tangents of triangles sharing a
+ * vertex are then averaged weighted by their angles at the vertex, only if
+ * they also share its normal, texture coordinates and handedness, and the
+ * result is orthogonalized against the normal (Gram-Schmidt). The bitangent
+ * is the cross product of the normal and the tangent multiplied by the
+ * bitangent sign, which stores the handedness.
+ *
+ * This is not an implementation of MikkTSpace, so the tangents can slightly
+ * differ from those that normal maps were baked with in other tools.
+ *
+ * @param model The model.
+ * @param flipHorizontally Texture coordinates were flipped horizontally, so
+ * tangents must point in the direction of decreasing U.
+ * @param flipVertically Texture coordinates were flipped vertically, so
+ * bitangents must point in the direction of decreasing V.
+ * @param jobSystem A job system used to process vertices in parallel.
+ *
+ * @return Number of meshes which got tangent vectors.
+ */
+size_t GenerateTangents(SModel* model, bool flipHorizontally, bool flipVertically,
+	SJobSystem& jobSystem);
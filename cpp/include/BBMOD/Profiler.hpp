@@ -0,0 +1,142 @@
+#pragma once
+
+#include <atomic>
+#include <chrono>
+#include <cstdint>
+#include <mutex>
+#include <string>
+#include <thread>
+#include <vector>
+
+namespace Assimp
+{
+	class Importer;
+}
+
+/** A single event recorded by the profiler. */
+struct SProfilerEvent
+{
+	/** Name of the event, e.g. "Import" or "JoinVerticesProcess". */
+	std::string Name;
+
+	/** Category of the event, e.g. "phase" or "assimp". */
+	std::string Category;
+
+	/** Start of the event in microseconds since the profiler creation. */
+	uint64_t Start = 0;
+
+	/** Duration of the event in microseconds. */
+	uint64_t Duration = 0;
+
+	/** Index of the thread which recorded the event. */
+	uint32_t ThreadId = 0;
+
+	/** Peak resident set size of the process (in bytes) sampled at the end
+	 * of the event. */
+	size_t PeakMemory = 0;
+};
+
+/**
+ * Collects timings of conversion phases. Events recorded from multiple
+ * threads (or multiple conversions executed in a single process) are merged
+ * into a single timeline.
+ */
+struct SProfiler
+{
+	/** Retrieves the global profiler instance. */
+	static SProfiler& Get();
+
+	/** Returns peak resident set size of the process in bytes. */
+	static size_t GetPeakMemory();
+
+	/** Enables/disables recording of events. Disabled by default. */
+	void SetEnabled(bool enabled) { Enabled = enabled; }
+
+	/** Returns true if recording of events is enabled. */
+	bool IsEnabled() const { return Enabled; }
+
+	/** Returns number of microseconds elapsed since the profiler creation. */
+	uint64_t Now() const;
+
+	/** Records an event which started at time start and ended now. */
+	void AddEvent(const std::string& name, const char* category, uint64_t start);
+
+	/** Removes all recorded events. */
+	void Clear();
+
+	/** Prints a table of total times spent in each event. */
+	void PrintSummary() const;
+
+	/** Saves recorded events into a JSON file which can be opened in
+	 * chrome://tracing. */
+	bool SaveTrace(std::string path) const;
+
+private:
+	SProfiler();
+
+	uint32_t GetThreadIndex();
+
+	/** Read by worker threads of job systems, so it must be atomic. */
+	std::atomic<bool> Enabled{ false };
+
+	std::chrono::steady_clock::time_point Epoch;
+
+	mutable std::mutex Mutex;
+
+	std::vector<SProfilerEvent> Events;
+
+	std::vector<std::thread::id> Threads;
+};
+
+/** Measures elapsed time, regardless of whether the profiler is enabled. */
+struct SStopwatch
+{
+	SStopwatch()
+		: Start(std::chrono::steady_clock::now())
+	{
+	}
+
+	/** Returns number of milliseconds elapsed since the creation. */
+	double GetMilliseconds() const
+	{
+		auto elapsed = std::chrono::steady_clock::now() - Start;
+		return std::chrono::duration<double, std::milli>(elapsed).count();
+	}
+
+	std::chrono::steady_clock::time_point Start;
+};
+
+/** Records an event lasting from its construction until its destruction. */
+struct SProfileScope
+{
+	SProfileScope(const char* name, const char* category = "phase");
+
+	~SProfileScope();
+
+	const char* Name;
+
+	const char* Category;
+
+	uint64_t Start = 0;
+};
+
+#define BBMOD_PROFILE_CONCAT_IMPL(a, b) a##b
+
+#define BBMOD_PROFILE_CONCAT(a, b) BBMOD_PROFILE_CONCAT_IMPL(a, b)
+
+/** Profiles the rest of the current scope as an event with given name. */
+#define BBMOD_PROFILE_SCOPE(name) \
+	SProfileScope BBMOD_PROFILE_CONCAT(_profileScope, __LINE__)(name)
+
+/**
+ * Installs a progress handler and a log stream into Assimp, which record
+ * times spent in file reading and in individual post-processing steps.
+ *
+ * @param importer The importer to profile.
+ *
+ * @note Does nothing when the profiler is disabled.
+ */
+void ProfileAssimpImporter(Assimp::Importer* importer);
+
+/** Removes the log stream installed by ProfileAssimpImporter. */
+void ProfileAssimpImporterEnd();
@@ -48,10 +48,10 @@ static inline void quaternion_scale(quat_t q, float s)
 	q[3] *= s;
 }
 
-static inline float quaternion_inverse(quat_t q)
+static inline void quaternion_inverse(quat_t q)
 {
 	quaternion_conjugate(q);
-	float s = 1.0f / quaternion_length(q);
+	float s = 1.0f / quaternion_lengthsqr(q);
 	quaternion_scale(q, s);
 }
 
@@ -68,8 +68,8 @@ static inline void quaternion_normalize(quat_t q)
 
 static inline void quaternion_slerp(quat_t q1, const quat_t q2, float f)
 {
-	static quat_t _q1;
-	static quat_t _q2;
+	quat_t _q1;
+	quat_t _q2;
 
 	quaternion_copy(q1, _q1);
 	quaternion_copy(q2, _q2);
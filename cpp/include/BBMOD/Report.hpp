@@ -0,0 +1,75 @@
+#pragma once
+
+#include <BBMOD/Model.hpp>
+#include <BBMOD/Animation.hpp>
+
+#include <string>
+#include <utility>
+#include <vector>
+
+/** A warning code used when the model has more bones than the default
+ * animated shader supports. */
+#define BBMOD_WARN_TOO_MANY_BONES 1
+
+/** A warning code used when a mesh has no normal vectors, but the vertex
+ * format requires them. */
+#define BBMOD_WARN_MISSING_NORMALS 2
+
+/** A warning code used when a mesh has no texture coordinates, but the
+ * vertex format requires them. */
+#define BBMOD_WARN_MISSING_TEXTURE_COORDS 3
+
+/** A warning code used when a mesh has no tangent vectors, but the vertex
+ * format requires them. */
+#define BBMOD_WARN_MISSING_TANGENTS 4
+
+/** A warning code used when a mesh has vertex colors, but the vertex format
+ * does not include them. */
+#define BBMOD_WARN_UNUSED_COLORS 5
+
+/** A warning with a code, which can be checked by scripts. */
+struct SReportWarning
+{
+	int Code = 0;
+
+	std::string Message;
+};
+
+/** An animation written during a conversion. */
+struct SReportAnimation
+{
+	SAnimation* Animation = nullptr;
+
+	std::string Path;
+};
+
+/**
+ * A machine-readable report of a conversion, saved as a JSON file next to
+ * the converted model.
+ */
+struct SReport
+{
+	void AddWarning(int code, std::string message);
+
+	void AddTiming(std::string name, double milliseconds);
+
+	bool Save(std::string path) const;
+
+	std::string Input;
+
+	std::string Output;
+
+	SModel* Model = nullptr;
+
+	std::vector<SReportAnimation> Animations;
+
+	std::vector<std::pair<std::string, double>> Timings;
+
+	std::vector<SReportWarning> Warnings;
+
+	/** Overdraw estimated by AnalyzeOverdraw before it was optimized or 0. */
+	float OverdrawBefore = 0.0f;
+
+	/** Overdraw estimated by AnalyzeOverdraw after it was optimized or 0. */
+	float OverdrawAfter = 0.0f;
+};
@@ -0,0 +1,39 @@
+#pragma once
+
+#include <BBMOD/Model.hpp>
+
+#include <string>
+#include <vector>
+
+/**
+ * A mesh with only vertex positions, used instead of meshes of a node in
+ * passes which render only depth, e.g. into shadow maps.
+ */
+struct SShadowProxy
+{
+	/** An index of the node whose meshes the proxy replaces. */
+	size_t Node = 0;
+
+	/** Positions of vertices of a triangle list, three floats each. */
+	std::vector<float> Vertices;
+};
+
+/**
+ * Creates a shadow proxy for each node with meshes. Triangles of all meshes of
+ * a node are joined regardless of their materials, vertices with the same
+ * position are welded, degenerate triangles are removed and vertices are
+ * optionally clustered in a uniform grid, which
+ * removes triangles smaller than a cell. Positions are in the space of the
+ * mesh vertices.
+ *
+ * @param model The model. Models with bones are not supported.
+ * @param gridSize Number of cells of the grid along the longest side of the
+ * node's bounding box or 0 to disable simplification.
+ * @param proxies An array to write the created proxies into.
+ *
+ * @return False if the model has bones.
+ */
+bool BuildShadowProxies(const SModel* model, size_t gridSize, std::vector<SShadowProxy>& proxies);
+
+/** Saves shadow proxies into a "*.bbshdw" file. Returns false on fail. */
+bool SaveShadowProxies(std::string path, const std::vector<SShadowProxy>& proxies);
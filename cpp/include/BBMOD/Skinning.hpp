@@ -0,0 +1,34 @@
+#pragma once
+
+#include <BBMOD/Model.hpp>
+#include <BBMOD/JobSystem.hpp>
+
+/** Number of vertices skinned by a single job. */
+#define BBMOD_SKINNING_BATCH_SIZE 1024
+
+/**
+ * Returns size of a vertex written by SkinMesh, i.e. of the given vertex
+ * format without bones and ids.
+ */
+size_t GetSkinnedVertexSize(const SVertexFormat* vertexFormat);
+
+/**
+ * Transforms positions, normals and tangents of vertices of a mesh by bone
+ * transforms, the same way as the animated vertex shader does, and writes
+ * them in the static vertex format. Vertices keep their order, so the output
+ * has the same primitive type as the mesh.
+ *
+ * @param mesh The mesh to skin.
+ * @param transform Bone transforms, 16 floats per bone.
+ * @param boneCount Number of bones in transform.
+ * @param out An array of GetSkinnedVertexSize * mesh vertex count bytes
+ * to write the vertices into.
+ * @param begin Index of the first vertex to skin.
+ * @param end Index of the last vertex to skin + 1.
+ */
+void SkinMesh(const SMesh* mesh, const float* transform, size_t boneCount,
+	unsigned char* out, size_t begin, size_t end);
+
+/** Skins a whole mesh using a job system and waits for it to finish. */
+void SkinMesh(const SMesh* mesh, const float* transform, size_t boneCount,
+	unsigned char* out, SJobSystem& jobSystem);
@@ -0,0 +1,38 @@
+#pragma once
+
+#include <BBMOD/Model.hpp>
+#include <BBMOD/JobSystem.hpp>
+
+/** Minimum number of vertices transformed by a single job. */
+#define BBMOD_STATIC_BATCH_JOB_SIZE 4096
+
+/**
+ * Returns number of bytes written by BuildStaticBatch, i.e. the size of all
+ * vertices of the model in the format without bones and ids times the number
+ * of instances.
+ */
+size_t GetStaticBatchSize(const SModel* model, size_t instanceCount);
+
+/**
+ * Transforms vertices of all meshes of a model for each of its instances and
+ * writes them one after another in the vertex format of the model without
+ * bones and ids. Attributes which a mesh does not have are written with their
+ * default values.
+ * Normals are transformed by the inverse transpose of the instance transform
+ * and tangents flip their bitangent sign for mirroring transforms, so the
+ * batch is lit the same as the individual instances. Meshes stored as triangle
+ * strips are written as triangle lists, so the whole batch can be submitted
+ * at once.
+ *
+ * @param model The model to batch.
+ * @param transforms Transforms of the instances, 16 floats per instance.
+ * @param out An array of GetStaticBatchSize bytes to write the vertices into.
+ * @param begin Index of the first instance to write.
+ * @param end Index of the last instance to write + 1.
+ */
+void BuildStaticBatch(const SModel* model, const float* transforms,
+	unsigned char* out, size_t begin, size_t end);
+
+/** Builds a static batch of all instances using a job system and waits for it to finish. */
+void BuildStaticBatch(const SModel* model, const float* transforms, size_t instanceCount,
+	unsigned char* out, SJobSystem& jobSystem);
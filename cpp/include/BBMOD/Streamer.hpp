@@ -0,0 +1,147 @@
+#pragma once
+
+#include <condition_variable>
+#include <deque>
+#include <map>
+#include <mutex>
+#include <string>
+#include <thread>
+#include <vector>
+
+/** Default number of threads loading streamed files. */
+#define BBMOD_STREAM_THREAD_COUNT 2
+
+/** Default maximum size of staged data in bytes. */
+#define BBMOD_STREAM_BUDGET (64 * 1024 * 1024)
+
+/** A streamed item is a BBMOD model, which is repacked into SModelBlob. */
+#define BBMOD_STREAM_MODEL 0
+
+/** A streamed item is a BBANIM animation, staged without its header. */
+#define BBMOD_STREAM_ANIMATION 1
+
+/** An item is waiting in the queue. */
+#define BBMOD_STREAM_QUEUED 0
+
+/** An item is being loaded by a worker thread. */
+#define BBMOD_STREAM_LOADING 1
+
+/** An item is loaded and its data is staged. */
+#define BBMOD_STREAM_DONE 2
+
+/** An item failed to load. */
+#define BBMOD_STREAM_FAILED 3
+
+/** A file loaded by SStreamer. */
+struct SStreamItem
+{
+	size_t Id = 0;
+
+	std::string Path;
+
+	int Type = BBMOD_STREAM_MODEL;
+
+	/** Items with higher priority are loaded first. */
+	double Priority = 0.0;
+
+	/** Order in which the item was enqueued, used for items of equal priority. */
+	size_t Sequence = 0;
+
+	int State = BBMOD_STREAM_QUEUED;
+
+	/** Set when the item is removed while it is being loaded. */
+	bool Removed = false;
+
+	/** The staged data, ready to be copied into a GML buffer. */
+	std::vector<unsigned char> Data;
+};
+
+/**
+ * Loads files on background threads. Items are loaded in order of their
+ * priority and loading is paused while the staged data exceeds a budget,
+ * until it is released with Remove.
+ */
+struct SStreamer
+{
+	SStreamer(size_t threadCount = BBMOD_STREAM_THREAD_COUNT);
+
+	~SStreamer();
+
+	/**
+	 * Adds a file into the queue.
+	 *
+	 * @param path Path to the file.
+	 * @param type BBMOD_STREAM_MODEL or BBMOD_STREAM_ANIMATION.
+	 * @param priority Items with higher priority are loaded first.
+	 *
+	 * @return An id of the item.
+	 */
+	size_t Enqueue(std::string path, int type, double priority);
+
+	/**
+	 * Removes an item. Queued items are cancelled, items being loaded are
+	 * discarded once they are loaded and staged data of loaded items is
+	 * freed.
+	 *
+	 * @return False if there is no item with given id.
+	 */
+	bool Remove(size_t id);
+
+	/**
+	 * Retrieves an id of an item which has finished loading (successfully
+	 * or not) since the last call.
+	 *
+	 * @return False if no item has finished.
+	 */
+	bool Poll(size_t& id);
+
+	/** Returns the state of an item or -1 if there is no item with given id. */
+	int GetState(size_t id);
+
+	/**
+	 * Copies staged data of a loaded item into a buffer.
+	 *
+	 * @param id The id of the item.
+	 * @param out A buffer to copy the data into or nullptr to only retrieve
+	 * the size of the data.
+	 * @param size Receives the size of the data.
+	 *
+	 * @return False if the item does not exist or it is not loaded.
+	 */
+	bool GetData(size_t id, unsigned char* out, size_t& size);
+
+	void SetBudget(size_t budget);
+
+	size_t GetBudget();
+
+	size_t GetStagedSize();
+
+	/** Loads a file into staged data. Returns false on fail. */
+	static bool LoadItem(const std::string& path, int type, std::vector<unsigned char>& data);
+
+	void WorkerMain();
+
+	std::vector<std::thread> Threads;
+
+	std::mutex Mutex;
+
+	/** Signalled when an item is enqueued, staged data is freed or on stop. */
+	std::condition_variable Condition;
+
+	/** All items which were not removed yet. */
+	std::map<size_t, SStreamItem*> Items;
+
+	/** A heap of queued items. Removed items are skipped when taken. */
+	std::vector<SStreamItem*> Queue;
+
+	/** Ids of items which finished loading and were not polled yet. */
+	std::deque<size_t> Finished;
+
+	size_t NextId = 0;
+
+	size_t Budget = BBMOD_STREAM_BUDGET;
+
+	size_t StagedSize = 0;
+
+	bool Stop = false;
+};
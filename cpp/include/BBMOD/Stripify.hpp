@@ -0,0 +1,36 @@
+#pragma once
+
+#include <BBMOD/Model.hpp>
+
+/**
+ * Converts a triangle list mesh into a triangle strip. Identical vertices are
+ * welded, triangles are greedily joined into strips through shared edges with
+ * matching winding order and the strips are stitched together using
+ * degenerate triangles. The mesh is left as is if the strip would not have
+ * fewer vertices than the list.
+ *
+ * Strips are started from triangles in their order in the list, so the
+ * order is kept roughly the same, e.g. after reordering triangles for less
+ * overdraw.
+ *
+ * @param mesh The mesh.
+ * @param window If not 0, a strip only takes triangles which are less than
+ * this many triangles after its first triangle in the list, so that the
+ * order of triangles is kept exactly up to this distance.
+ *
+ * @return True if the mesh was converted.
+ */
+bool StripifyMesh(SMesh* mesh, size_t window = 0);
+
+/**
+ * Converts all meshes of a model into triangle strips.
+ *
+ * @param model The model. Batched models are not supported, since batches
+ * are made of triangle lists.
+ * @param window See StripifyMesh.
+ *
+ * @return Number of converted meshes.
+ *
+ * @see StripifyMesh
+ */
+size_t Stripify(SModel* model, size_t window = 0);
@@ -1,5 +1,6 @@
 #pragma once
 
+#include <cmath>
 #include <cstring>
 
 typedef float vec3_t[3];
@@ -11,3 +12,16 @@ static inline void vec3_copy(const vec3_t from, vec3_t to)
 {
 	std::memcpy(to, from, sizeof(float) * 3);
 }
+
+/** Normalizes a vector. Zero vectors are left unchanged. */
+static inline void vec3_normalize(vec3_t v)
+{
+	float lengthSqr = (v[0] * v[0]) + (v[1] * v[1]) + (v[2] * v[2]);
+	if (lengthSqr > 0.0f)
+	{
+		float s = 1.0f / sqrtf(lengthSqr);
+		v[0] *= s;
+		v[1] *= s;
+		v[2] *= s;
+	}
+}
@@ -1,5 +1,6 @@
 #pragma once
 
+#include <cstdint>
 #include <fstream>
 
 struct SVertexFormat
@@ -8,6 +9,30 @@ struct SVertexFormat
 
 	static SVertexFormat* Load(std::ifstream& file);
 
+	size_t GetSize() const;
+
+	size_t GetVertexSize() const;
+
+	/** Returns the size of bone indices and weights of a single vertex. */
+	size_t GetBoneSize() const;
+
+	/** Enables all attributes which are enabled in the other vertex format. */
+	void Add(const SVertexFormat& other);
+
+	/**
+	 * Returns the vertex format as a bit mask, where bit i is set if the i-th
+	 * attribute in the order of Save is enabled. Bits 8 to 15 hold the number
+	 * of bone influences if the vertex format has bones.
+	 */
+	uint32_t GetMask() const;
+
+	bool operator==(const SVertexFormat& other) const;
+
+	bool operator!=(const SVertexFormat& other) const
+	{
+		return !(*this == other);
+	}
+
 	bool Vertices = true;
 
 	bool Normals = false;
@@ -20,5 +45,11 @@ struct SVertexFormat
 
 	bool Bones = false;
 
+	/**
+	 * Number of bones influencing each vertex, either 1, 2 or 4. Vertices with
+	 * a single influence do not store its weight. Saved in place of Bones.
+	 */
+	uint8_t BoneInfluences = 4;
+
 	bool Ids = false;
 };
@@ -0,0 +1,35 @@
+#pragma once
+
+#include <BBMOD/Model.hpp>
+#include <BBMOD/JobSystem.hpp>
+
+/** Number of vertices processed by a single job when welding. */
+#define BBMOD_WELD_BATCH_SIZE 1024
+
+/**
+ * Welds vertices of meshes which are nearly identical, so that they become
+ * bit-identical and can be shared, e.g. by triangle strips. Vertices are found
+ * using a spatial hash with cells of the size of the distance tolerance.
+ *
+ * First, positions closer than the distance are snapped together, which
+ * closes cracks even along UV seams and hard edges. Then vertices whose
+ * normals, tangents and texture coordinates are also within the tolerances
+ * take all attributes of the same vertex. Vertices with different colors,
+ * bones, bone weights or bitangent signs are never welded, neither are
+ * vertices of different meshes.
+ *
+ * Snapping positions together can collapse small triangles into triangles
+ * with zero area, which should be removed afterwards with RemoveDegenerates.
+ *
+ * @param model The model.
+ * @param distance Maximum distance between positions of welded vertices.
+ * @param angle Maximum angle between normals and tangents of welded vertices,
+ * in degrees.
+ * @param uvDistance Maximum distance between texture coordinates of welded
+ * vertices.
+ * @param jobSystem A job system used to process vertices in parallel.
+ *
+ * @return Number of vertices which took attributes of another vertex.
+ */
+size_t WeldVertices(SModel* model, float distance, float angle, float uvDistance,
+	SJobSystem& jobSystem);
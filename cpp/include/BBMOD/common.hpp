@@ -3,4 +3,4 @@
 #include <cstdint>
 
 /** The version of created BBMOD files. */
-#define BBMOD_VERSION 2
+#define BBMOD_VERSION 7
@@ -1,13 +1,40 @@
 #pragma once
 
+#include <BBMOD/common.hpp>
 #include <BBMOD/Matrix.hpp>
 
+#include <cstdint>
+#include <cstdio>
+#include <cstring>
+#include <fstream>
+#include <string>
+
 #define FILE_WRITE_DATA(f, d) \
 	(f).write(reinterpret_cast<const char*>(&(d)), sizeof(d))
 
 #define FILE_READ_DATA(f, d) \
 	(f).read(reinterpret_cast<char*>(&(d)), sizeof(d))
 
+/** Writes a size as a 32-bit unsigned integer, so the files are the same on
+ * all platforms. */
+#define FILE_WRITE_SIZE(f, s) \
+	do \
+	{ \
+		uint32_t _size = (uint32_t)(s); \
+		FILE_WRITE_DATA(f, _size); \
+	} \
+	while (false)
+
+/** Reads a size written with FILE_WRITE_SIZE. */
+#define FILE_READ_SIZE(f, s) \
+	do \
+	{ \
+		uint32_t _size = 0; \
+		FILE_READ_DATA(f, _size); \
+		(s) = (size_t)_size; \
+	} \
+	while (false)
+
 #define FILE_WRITE_VEC2(f, v) \
 	do \
 	{ \
@@ -81,3 +108,61 @@
 		} \
 	} \
 	while (false)
+
+/** Escapes a string so it can be written into a JSON file. */
+static inline std::string JsonEscape(const std::string& str)
+{
+	std::string escaped;
+	escaped.reserve(str.size());
+	for (char c : str)
+	{
+		switch (c)
+		{
+		case '"': escaped += "\\\""; break;
+		case '\\': escaped += "\\\\"; break;
+		case '\n': escaped += "\\n"; break;
+		case '\r': escaped += "\\r"; break;
+		case '\t': escaped += "\\t"; break;
+		default:
+			if ((unsigned char)c < 0x20)
+			{
+				char buffer[8];
+				snprintf(buffer, sizeof(buffer), "\\u%04x", (unsigned char)c);
+				escaped += buffer;
+			}
+			else
+			{
+				escaped += c;
+			}
+			break;
+		}
+	}
+	return escaped;
+}
+
+/**
+ * Opens a binary file saved next to a model, e.g. "*.bbinst", and writes its
+ * header, which consists of the file type as a null-terminated string and
+ * the BBMOD version.
+ *
+ * @param file The stream to open.
+ * @param path The path to the file.
+ * @param type The file type, e.g. "bbinst".
+ *
+ * @return True if the file was opened.
+ */
+static inline bool OpenSidecarFile(std::ofstream& file, const std::string& path, const char* type)
+{
+	file.open(path, std::ios::out | std::ios::binary);
+
+	if (!file.is_open())
+	{
+		return false;
+	}
+
+	file.write(type, sizeof(char) * (std::strlen(type) + 1));
+	uint8_t version = BBMOD_VERSION;
+	FILE_WRITE_DATA(file, version);
+
+	return true;
+}
@@ -0,0 +1,279 @@
+#include <BBMOD/AmbientOcclusion.hpp>
+
+#include <algorithm>
+#include <array>
+#include <cfloat>
+#include <cmath>
+#include <cstdint>
+#include <map>
+
+#define X_2_PI 6.28318530718f
+
+static inline float Dot(const float* a, const float* b)
+{
+	return (a[0] * b[0] + a[1] * b[1] + a[2] * b[2]);
+}
+
+static inline void Cross(const float* a, const float* b, float* out)
+{
+	out[0] = a[1] * b[2] - a[2] * b[1];
+	out[1] = a[2] * b[0] - a[0] * b[2];
+	out[2] = a[0] * b[1] - a[1] * b[0];
+}
+
+/** A point from which occlusion is sampled, shared by identical vertices. */
+struct SAOSample
+{
+	SAOSample()
+		: Position VEC3_ZERO
+		, Normal VEC3_ZERO
+		, BentNormal VEC3_ZERO
+	{
+	}
+
+	vec3_t Position;
+
+	vec3_t Normal;
+
+	/** Fraction of rays which did not hit anything. */
+	float Visibility = 1.0f;
+
+	vec3_t BentNormal;
+};
+
+/** Returns the i-th value of the base 2 Van der Corput sequence. */
+static inline float RadicalInverse(uint32_t i)
+{
+	i = (i << 16) | (i >> 16);
+	i = ((i & 0x55555555u) << 1) | ((i & 0xAAAAAAAAu) >> 1);
+	i = ((i & 0x33333333u) << 2) | ((i & 0xCCCCCCCCu) >> 2);
+	i = ((i & 0x0F0F0F0Fu) << 4) | ((i & 0xF0F0F0F0u) >> 4);
+	i = ((i & 0x00FF00FFu) << 8) | ((i & 0xFF00FF00u) >> 8);
+	return (float)i * 2.3283064365386963e-10f;
+}
+
+/** Casts rays from a sample and computes its visibility and bent normal. */
+static void BakeSample(const SBVH* bvh, SAOSample& sample, size_t index, size_t rayCount,
+	float distance, float bias)
+{
+	const float* n = sample.Normal;
+
+	// Orthonormal basis around the normal
+	vec3_t axis = { 1.0f, 0.0f, 0.0f };
+	if (std::abs(n[0]) > 0.9f)
+	{
+		axis[0] = 0.0f;
+		axis[1] = 1.0f;
+	}
+	vec3_t t, b;
+	Cross(n, axis, t);
+	vec3_normalize(t);
+	Cross(n, t, b);
+
+	vec3_t origin;
+	for (size_t i = 0; i < 3; ++i)
+	{
+		origin[i] = sample.Position[i] + n[i] * bias;
+	}
+
+	// Rotate the Hammersley pattern differently for each sample, so the same
+	// directions do not create visible bands
+	float rotation = std::fmod((float)index * 0.618034f, 1.0f);
+
+	size_t visible = 0;
+	vec3_t bent = VEC3_ZERO;
+	SBVHHit hit;
+
+	for (size_t i = 0; i < rayCount; ++i)
+	{
+		float u = ((float)i + 0.5f) / (float)rayCount;
+		float phi = X_2_PI * (RadicalInverse((uint32_t)i) + rotation);
+		float r = std::sqrt(u);
+		float x = r * std::cos(phi);
+		float y = r * std::sin(phi);
+		float z = std::sqrt(std::max(1.0f - u, 0.0f));
+
+		vec3_t direction;
+		for (size_t j = 0; j < 3; ++j)
+		{
+			direction[j] = t[j] * x + b[j] * y + n[j] * z;
+		}
+
+		if (!bvh->Raycast(origin, direction, distance, hit))
+		{
+			++visible;
+			for (size_t j = 0; j < 3; ++j)
+			{
+				bent[j] += direction[j];
+			}
+		}
+	}
+
+	sample.Visibility = (float)visible / (float)rayCount;
+
+	if (visible > 0)
+	{
+		vec3_normalize(bent);
+		vec3_copy(bent, sample.BentNormal);
+	}
+	else
+	{
+		vec3_copy(n, sample.BentNormal);
+	}
+}
+
+/** Multiplies RGB of a color encoded as ABGR by a factor. */
+static inline uint32_t ScaleColor(uint32_t color, float factor)
+{
+	uint32_t result = color & 0xFF000000u;
+	for (uint32_t shift = 0; shift < 24; shift += 8)
+	{
+		float channel = (float)((color >> shift) & 0xFFu) * factor;
+		result |= ((uint32_t)(channel + 0.5f) & 0xFFu) << shift;
+	}
+	return result;
+}
+
+bool BakeAmbientOcclusion(SModel* model, size_t rayCount, float distance, bool bentNormals,
+	SJobSystem& jobSystem)
+{
+	if (model->VertexFormat->Bones)
+	{
+		return false;
+	}
+
+	if (rayCount == 0)
+	{
+		return true;
+	}
+
+	vec3_t min = { FLT_MAX, FLT_MAX, FLT_MAX };
+	vec3_t max = { -FLT_MAX, -FLT_MAX, -FLT_MAX };
+
+	// Find unique samples
+	std::vector<SAOSample> samples;
+	std::vector<std::pair<SVertex*, size_t>> vertices;
+	std::map<std::array<float, 6>, size_t> sampleIndices;
+
+	for (SMesh* mesh : model->Meshes)
+	{
+		const SVertexFormat* vertexFormat = mesh->VertexFormat;
+
+		for (size_t i = 0; i + 2 < mesh->Data.size(); i += 3)
+		{
+			// Face normal for vertices without normals
+			vec3_t ab, ac, faceNormal;
+			for (size_t j = 0; j < 3; ++j)
+			{
+				ab[j] = mesh->Data[i + 1]->Position[j] - mesh->Data[i]->Position[j];
+				ac[j] = mesh->Data[i + 2]->Position[j] - mesh->Data[i]->Position[j];
+			}
+			Cross(ab, ac, faceNormal);
+			vec3_normalize(faceNormal);
+
+			for (size_t j = 0; j < 3; ++j)
+			{
+				SVertex* vertex = mesh->Data[i + j];
+
+				SAOSample sample;
+				vec3_copy(vertex->Position, sample.Position);
+				vec3_copy(vertexFormat->Normals ? vertex->Normal : faceNormal, sample.Normal);
+				vec3_normalize(sample.Normal);
+
+				for (size_t k = 0; k < 3; ++k)
+				{
+					min[k] = std::min(min[k], sample.Position[k]);
+					max[k] = std::max(max[k], sample.Position[k]);
+				}
+
+				std::array<float, 6> key = {
+					sample.Position[0], sample.Position[1], sample.Position[2],
+					sample.Normal[0], sample.Normal[1], sample.Normal[2],
+				};
+
+				auto it = sampleIndices.find(key);
+				if (it == sampleIndices.end())
+				{
+					it = sampleIndices.emplace(key, samples.size()).first;
+					samples.push_back(sample);
+				}
+
+				vertices.push_back({ vertex, it->second });
+			}
+		}
+	}
+
+	if (samples.empty())
+	{
+		return true;
+	}
+
+	vec3_t size;
+	for (size_t i = 0; i < 3; ++i)
+	{
+		size[i] = max[i] - min[i];
+	}
+	float modelSize = std::sqrt(Dot(size, size));
+	float bias = modelSize * BBMOD_AO_BIAS;
+	if (distance <= 0.0f)
+	{
+		distance = modelSize * BBMOD_AO_DEFAULT_DISTANCE;
+	}
+
+	SBVH* bvh = model->BVH ? model->BVH : SBVH::FromModel(model);
+
+	jobSystem.Dispatch(samples.size(), BBMOD_AO_BATCH_SIZE, [&](size_t begin, size_t end) {
+		for (size_t i = begin; i < end; ++i)
+		{
+			BakeSample(bvh, samples[i], i, rayCount, distance, bias);
+		}
+	});
+	jobSystem.Wait();
+
+	if (bvh != model->BVH)
+	{
+		delete bvh;
+	}
+
+	// Meshes without vertex colors get them, starting from white
+	for (SMesh* mesh : model->Meshes)
+	{
+		if (!mesh->VertexFormat->Colors)
+		{
+			for (SVertex* vertex : mesh->Data)
+			{
+				vertex->Color = 0xFFFFFFFFu;
+			}
+			mesh->VertexFormat->Colors = true;
+		}
+	}
+	model->VertexFormat->Colors = true;
+
+	// Write results into the vertices
+	for (auto& pair : vertices)
+	{
+		SVertex* vertex = pair.first;
+		const SVertexFormat* vertexFormat = vertex->VertexFormat;
+		const SAOSample& sample = samples[pair.second];
+
+		vertex->Color = ScaleColor(vertex->Color, sample.Visibility);
+
+		if (bentNormals && vertexFormat->Normals)
+		{
+			vec3_copy(sample.BentNormal, vertex->Normal);
+
+			if (vertexFormat->TangentW)
+			{
+				// Keep the tangent perpendicular to the new normal
+				float d = Dot(vertex->Tangent, vertex->Normal);
+				for (size_t i = 0; i < 3; ++i)
+				{
+					vertex->Tangent[i] -= vertex->Normal[i] * d;
+				}
+				vec3_normalize(vertex->Tangent);
+			}
+		}
+	}
+
+	return true;
+}
@@ -55,12 +55,25 @@ SRotationKey* SRotationKey::Load(std::ifstream& file)
 	return rotationKey;
 }
 
+SAnimationNode::~SAnimationNode()
+{
+	for (SPositionKey* key : PositionKeys)
+	{
+		delete key;
+	}
+
+	for (SRotationKey* key : RotationKeys)
+	{
+		delete key;
+	}
+}
+
 bool SAnimationNode::Save(std::ofstream& file)
 {
 	FILE_WRITE_DATA(file, Index);
 
 	size_t positionKeyCount = PositionKeys.size();
-	FILE_WRITE_DATA(file, positionKeyCount);
+	FILE_WRITE_SIZE(file, positionKeyCount);
 
 	for (SPositionKey* key : PositionKeys)
 	{
@@ -71,7 +84,7 @@ bool SAnimationNode::Save(std::ofstream& file)
 	}
 
 	size_t rotationKeyCount = RotationKeys.size();
-	FILE_WRITE_DATA(file, rotationKeyCount);
+	FILE_WRITE_SIZE(file, rotationKeyCount);
 
 	for (SRotationKey* key : RotationKeys)
 	{
@@ -84,13 +97,20 @@ bool SAnimationNode::Save(std::ofstream& file)
 	return true;
 }
 
+size_t SAnimationNode::GetSize() const
+{
+	return (sizeof(Index)
+		+ sizeof(uint32_t) + PositionKeys.size() * (sizeof(double) + sizeof(float) * 3)
+		+ sizeof(uint32_t) + RotationKeys.size() * (sizeof(double) + sizeof(float) * 4));
+}
+
 SAnimationNode* SAnimationNode::Load(std::ifstream& file)
 {
 	SAnimationNode* animationNode = new SAnimationNode();
 	FILE_READ_DATA(file, animationNode->Index);
 
 	size_t positionKeyCount;
-	FILE_READ_DATA(file, positionKeyCount);
+	FILE_READ_SIZE(file, positionKeyCount);
 
 	for (size_t i = 0; i < positionKeyCount; ++i)
 	{
@@ -99,7 +119,7 @@ SAnimationNode* SAnimationNode::Load(std::ifstream& file)
 	}
 
 	size_t rotationKeyCount;
-	FILE_READ_DATA(file, rotationKeyCount);
+	FILE_READ_SIZE(file, rotationKeyCount);
 
 	for (size_t i = 0; i < rotationKeyCount; ++i)
 	{
@@ -110,6 +130,14 @@ SAnimationNode* SAnimationNode::Load(std::ifstream& file)
 	return animationNode;
 }
 
+SAnimation::~SAnimation()
+{
+	for (SAnimationNode* animationNode : AnimationNodes)
+	{
+		delete animationNode;
+	}
+}
+
 SAnimation* SAnimation::FromAssimp(aiAnimation* aiAnimation, SModel* model, const SConfig& config)
 {
 	SAnimation* animation = new SAnimation();
@@ -175,10 +203,10 @@ bool SAnimation::Save(std::string path)
 	FILE_WRITE_DATA(file, TicsPerSecond);
 
 	size_t modelNodeCount = Model->NodeCount;
-	FILE_WRITE_DATA(file, modelNodeCount);
+	FILE_WRITE_SIZE(file, modelNodeCount);
 
 	size_t affectedNodeCount = AnimationNodes.size();
-	FILE_WRITE_DATA(file, affectedNodeCount);
+	FILE_WRITE_SIZE(file, affectedNodeCount);
 
 	for (SAnimationNode* animationNode : AnimationNodes)
 	{
@@ -194,6 +222,26 @@ bool SAnimation::Save(std::string path)
 	return true;
 }
 
+size_t SAnimation::GetSize() const
+{
+	size_t size = (sizeof(char) * 7
+		+ sizeof(Version)
+		+ sizeof(Duration)
+		+ sizeof(TicsPerSecond)
+		+ sizeof(uint32_t)
+		+ sizeof(uint32_t));
+
+	for (SAnimationNode* animationNode : AnimationNodes)
+	{
+		if (animationNode)
+		{
+			size += animationNode->GetSize();
+		}
+	}
+
+	return size;
+}
+
 SAnimation* SAnimation::Load(std::string path)
 {
 	std::ifstream file(path, std::ios::in | std::ios::binary);
@@ -227,7 +275,7 @@ SAnimation* SAnimation::Load(std::string path)
 	FILE_READ_DATA(file, animation->TicsPerSecond);
 
 	size_t modelNodeCount;
-	FILE_READ_DATA(file, modelNodeCount);
+	FILE_READ_SIZE(file, modelNodeCount);
 
 	animation->ModelNodeCount = modelNodeCount;
 
@@ -237,7 +285,7 @@ SAnimation* SAnimation::Load(std::string path)
 	}
 
 	size_t affectedNodeCount;
-	FILE_READ_DATA(file, affectedNodeCount);
+	FILE_READ_SIZE(file, affectedNodeCount);
 
 	for (size_t i = 0; i < affectedNodeCount; ++i)
 	{
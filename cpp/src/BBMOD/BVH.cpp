@@ -0,0 +1,709 @@
+#include <BBMOD/BVH.hpp>
+#include <BBMOD/Model.hpp>
+#include <utils.hpp>
+
+#include <algorithm>
+#include <cfloat>
+#include <cmath>
+
+/** Size of a node saved in a file. */
+#define NODE_SIZE (6 * sizeof(float) + 2 * sizeof(uint32_t))
+
+/** Size of a triangle saved in a file. */
+#define TRIANGLE_SIZE (9 * sizeof(float) + 2 * sizeof(uint32_t))
+
+/** Maximum depth of a BVH, limits the size of traversal stacks. */
+#define MAX_DEPTH 64
+
+static inline float Dot(const float* a, const float* b)
+{
+	return (a[0] * b[0] + a[1] * b[1] + a[2] * b[2]);
+}
+
+static inline void Cross(const float* a, const float* b, float* out)
+{
+	out[0] = a[1] * b[2] - a[2] * b[1];
+	out[1] = a[2] * b[0] - a[0] * b[2];
+	out[2] = a[0] * b[1] - a[1] * b[0];
+}
+
+static inline void Sub(const float* a, const float* b, float* out)
+{
+	out[0] = a[0] - b[0];
+	out[1] = a[1] - b[1];
+	out[2] = a[2] - b[2];
+}
+
+/** An axis-aligned bounding box. */
+struct SBounds
+{
+	SBounds()
+		: Min{ FLT_MAX, FLT_MAX, FLT_MAX }
+		, Max{ -FLT_MAX, -FLT_MAX, -FLT_MAX }
+	{
+	}
+
+	void Add(const float* point)
+	{
+		for (size_t i = 0; i < 3; ++i)
+		{
+			Min[i] = std::min(Min[i], point[i]);
+			Max[i] = std::max(Max[i], point[i]);
+		}
+	}
+
+	void Add(const SBounds& other)
+	{
+		Add(other.Min);
+		Add(other.Max);
+	}
+
+	float GetSurfaceArea() const
+	{
+		float x = Max[0] - Min[0];
+		float y = Max[1] - Min[1];
+		float z = Max[2] - Min[2];
+		return (x < 0.0f) ? 0.0f : 2.0f * (x * y + y * z + z * x);
+	}
+
+	vec3_t Min;
+
+	vec3_t Max;
+};
+
+/** A triangle with its bounds and center, used while building a BVH. */
+struct SBuildTriangle
+{
+	SBounds Bounds;
+
+	vec3_t Center;
+
+	size_t Index;
+};
+
+/** Recursively splits triangles [begin, end) and appends nodes. */
+static void BuildNode(SBVH* bvh, std::vector<SBuildTriangle>& triangles,
+	size_t begin, size_t end, size_t depth)
+{
+	size_t nodeIndex = bvh->Nodes.size();
+	bvh->Nodes.emplace_back();
+
+	SBounds bounds;
+	SBounds centerBounds;
+	for (size_t i = begin; i < end; ++i)
+	{
+		bounds.Add(triangles[i].Bounds);
+		centerBounds.Add(triangles[i].Center);
+	}
+	vec3_copy(bounds.Min, bvh->Nodes[nodeIndex].Min);
+	vec3_copy(bounds.Max, bvh->Nodes[nodeIndex].Max);
+
+	size_t count = end - begin;
+	float leafCost = (float)count;
+	float bestCost = FLT_MAX;
+	size_t bestAxis = 0;
+	size_t bestSplit = 0;
+
+	// Evaluate splits between bins of triangle centers along each axis
+	for (size_t axis = 0; axis < 3 && count > BBMOD_BVH_MAX_LEAF_SIZE; ++axis)
+	{
+		float extent = centerBounds.Max[axis] - centerBounds.Min[axis];
+		if (extent <= 0.0f)
+		{
+			continue;
+		}
+
+		SBounds binBounds[BBMOD_BVH_BIN_COUNT];
+		size_t binCounts[BBMOD_BVH_BIN_COUNT] = { 0 };
+		float scale = BBMOD_BVH_BIN_COUNT / extent;
+
+		for (size_t i = begin; i < end; ++i)
+		{
+			size_t bin = std::min<size_t>(BBMOD_BVH_BIN_COUNT - 1,
+				(size_t)((triangles[i].Center[axis] - centerBounds.Min[axis]) * scale));
+			binBounds[bin].Add(triangles[i].Bounds);
+			++binCounts[bin];
+		}
+
+		float rightAreas[BBMOD_BVH_BIN_COUNT];
+		size_t rightCounts[BBMOD_BVH_BIN_COUNT];
+		SBounds right;
+		size_t rightCount = 0;
+		for (size_t i = BBMOD_BVH_BIN_COUNT - 1; i > 0; --i)
+		{
+			right.Add(binBounds[i]);
+			rightCount += binCounts[i];
+			rightAreas[i] = right.GetSurfaceArea();
+			rightCounts[i] = rightCount;
+		}
+
+		SBounds left;
+		size_t leftCount = 0;
+		for (size_t i = 0; i < BBMOD_BVH_BIN_COUNT - 1; ++i)
+		{
+			left.Add(binBounds[i]);
+			leftCount += binCounts[i];
+			if (leftCount == 0 || rightCounts[i + 1] == 0)
+			{
+				continue;
+			}
+			float cost = 1.0f + (left.GetSurfaceArea() * leftCount
+				+ rightAreas[i + 1] * rightCounts[i + 1]) / bounds.GetSurfaceArea();
+			if (cost < bestCost)
+			{
+				bestCost = cost;
+				bestAxis = axis;
+				bestSplit = i;
+			}
+		}
+	}
+
+	size_t middle;
+
+	if (count <= BBMOD_BVH_MAX_LEAF_SIZE
+		|| (bestCost >= leafCost && count <= BBMOD_BVH_MAX_LEAF_SIZE * 4)
+		|| depth >= MAX_DEPTH - 1)
+	{
+		bvh->Nodes[nodeIndex].Offset = (uint32_t)begin;
+		bvh->Nodes[nodeIndex].Count = (uint32_t)count;
+		return;
+	}
+
+	if (bestCost < FLT_MAX)
+	{
+		float extent = centerBounds.Max[bestAxis] - centerBounds.Min[bestAxis];
+		float scale = BBMOD_BVH_BIN_COUNT / extent;
+		float min = centerBounds.Min[bestAxis];
+		middle = std::partition(triangles.begin() + begin, triangles.begin() + end,
+			[bestAxis, bestSplit, scale, min](const SBuildTriangle& triangle)
+			{
+				size_t bin = std::min<size_t>(BBMOD_BVH_BIN_COUNT - 1,
+					(size_t)((triangle.Center[bestAxis] - min) * scale));
+				return (bin <= bestSplit);
+			}) - triangles.begin();
+	}
+	else
+	{
+		// All centers are the same, split in the middle
+		middle = begin + count / 2;
+	}
+
+	BuildNode(bvh, triangles, begin, middle, depth + 1);
+	bvh->Nodes[nodeIndex].Offset = (uint32_t)bvh->Nodes.size();
+	BuildNode(bvh, triangles, middle, end, depth + 1);
+}
+
+SBVH* SBVH::FromModel(const SModel* model)
+{
+	SBVH* bvh = new SBVH();
+	std::vector<SBVHTriangle> triangles;
+
+	for (size_t i = 0; i < model->Meshes.size(); ++i)
+	{
+		const SMesh* mesh = model->Meshes[i];
+		for (size_t j = 0; j + 2 < mesh->Data.size(); j += 3)
+		{
+			SBVHTriangle triangle;
+			vec3_copy(mesh->Data[j]->Position, triangle.A);
+			vec3_copy(mesh->Data[j + 1]->Position, triangle.B);
+			vec3_copy(mesh->Data[j + 2]->Position, triangle.C);
+			triangle.Mesh = (uint32_t)i;
+			triangle.Index = (uint32_t)(j / 3);
+			triangles.push_back(triangle);
+		}
+	}
+
+	if (triangles.empty())
+	{
+		return bvh;
+	}
+
+	std::vector<SBuildTriangle> build(triangles.size());
+	for (size_t i = 0; i < triangles.size(); ++i)
+	{
+		SBuildTriangle& triangle = build[i];
+		triangle.Bounds.Add(triangles[i].A);
+		triangle.Bounds.Add(triangles[i].B);
+		triangle.Bounds.Add(triangles[i].C);
+		for (size_t j = 0; j < 3; ++j)
+		{
+			triangle.Center[j] = (triangle.Bounds.Min[j] + triangle.Bounds.Max[j]) * 0.5f;
+		}
+		triangle.Index = i;
+	}
+
+	BuildNode(bvh, build, 0, build.size(), 0);
+
+	// Store triangles in the order of leaves
+	bvh->Triangles.reserve(triangles.size());
+	for (const SBuildTriangle& triangle : build)
+	{
+		bvh->Triangles.push_back(triangles[triangle.Index]);
+	}
+
+	return bvh;
+}
+
+bool SBVH::Save(std::ofstream& file)
+{
+	size_t nodeCount = Nodes.size();
+	FILE_WRITE_SIZE(file, nodeCount);
+
+	size_t triangleCount = Triangles.size();
+	FILE_WRITE_SIZE(file, triangleCount);
+
+	for (const SBVHNode& node : Nodes)
+	{
+		FILE_WRITE_VEC3(file, node.Min);
+		FILE_WRITE_VEC3(file, node.Max);
+		FILE_WRITE_DATA(file, node.Offset);
+		FILE_WRITE_DATA(file, node.Count);
+	}
+
+	for (const SBVHTriangle& triangle : Triangles)
+	{
+		FILE_WRITE_VEC3(file, triangle.A);
+		FILE_WRITE_VEC3(file, triangle.B);
+		FILE_WRITE_VEC3(file, triangle.C);
+		FILE_WRITE_DATA(file, triangle.Mesh);
+		FILE_WRITE_DATA(file, triangle.Index);
+	}
+
+	return true;
+}
+
+SBVH* SBVH::Load(std::ifstream& file)
+{
+	size_t nodeCount;
+	FILE_READ_SIZE(file, nodeCount);
+
+	size_t triangleCount;
+	FILE_READ_SIZE(file, triangleCount);
+
+	if (nodeCount == 0 || !file)
+	{
+		return nullptr;
+	}
+
+	SBVH* bvh = new SBVH();
+	bvh->Nodes.resize(nodeCount);
+	bvh->Triangles.resize(triangleCount);
+
+	for (SBVHNode& node : bvh->Nodes)
+	{
+		FILE_READ_VEC3(file, node.Min);
+		FILE_READ_VEC3(file, node.Max);
+		FILE_READ_DATA(file, node.Offset);
+		FILE_READ_DATA(file, node.Count);
+	}
+
+	for (SBVHTriangle& triangle : bvh->Triangles)
+	{
+		FILE_READ_VEC3(file, triangle.A);
+		FILE_READ_VEC3(file, triangle.B);
+		FILE_READ_VEC3(file, triangle.C);
+		FILE_READ_DATA(file, triangle.Mesh);
+		FILE_READ_DATA(file, triangle.Index);
+	}
+
+	if (!file)
+	{
+		delete bvh;
+		return nullptr;
+	}
+
+	return bvh;
+}
+
+size_t SBVH::GetSize(const SBVH* bvh)
+{
+	size_t size = sizeof(uint32_t) * 2;
+	if (bvh)
+	{
+		size += bvh->Nodes.size() * NODE_SIZE + bvh->Triangles.size() * TRIANGLE_SIZE;
+	}
+	return size;
+}
+
+/** Returns the distance at which a ray enters a box or FLT_MAX if it misses it. */
+static inline float IntersectBounds(const SBVHNode& node, const float* origin,
+	const float* inverseDirection, float maxDistance)
+{
+	float enter = 0.0f;
+	float exit = maxDistance;
+
+	for (size_t i = 0; i < 3; ++i)
+	{
+		float t1 = (node.Min[i] - origin[i]) * inverseDirection[i];
+		float t2 = (node.Max[i] - origin[i]) * inverseDirection[i];
+		enter = std::max(enter, std::min(t1, t2));
+		exit = std::min(exit, std::max(t1, t2));
+	}
+
+	return (enter <= exit) ? enter : FLT_MAX;
+}
+
+/**
+ * Intersects a ray with a triangle using the Moller-Trumbore algorithm.
+ * Returns the distance along the ray or FLT_MAX.
+ */
+static inline float IntersectTriangle(const SBVHTriangle& triangle, const float* origin, const float* direction)
+{
+	vec3_t edge1, edge2, p, t, q;
+	Sub(triangle.B, triangle.A, edge1);
+	Sub(triangle.C, triangle.A, edge2);
+	Cross(direction, edge2, p);
+
+	float determinant = Dot(edge1, p);
+	if (std::abs(determinant) < 1e-12f)
+	{
+		return FLT_MAX;
+	}
+	float inverseDeterminant = 1.0f / determinant;
+
+	Sub(origin, triangle.A, t);
+	float u = Dot(t, p) * inverseDeterminant;
+	if (u < 0.0f || u > 1.0f)
+	{
+		return FLT_MAX;
+	}
+
+	Cross(t, edge1, q);
+	float v = Dot(direction, q) * inverseDeterminant;
+	if (v < 0.0f || u + v > 1.0f)
+	{
+		return FLT_MAX;
+	}
+
+	float distance = Dot(edge2, q) * inverseDeterminant;
+	return (distance >= 0.0f) ? distance : FLT_MAX;
+}
+
+bool SBVH::Raycast(const vec3_t origin, const vec3_t direction, float maxDistance, SBVHHit& hit) const
+{
+	if (Nodes.empty())
+	{
+		return false;
+	}
+
+	vec3_t dir;
+	vec3_copy(direction, dir);
+	float length = std::sqrt(Dot(dir, dir));
+	if (length == 0.0f)
+	{
+		return false;
+	}
+	dir[0] /= length;
+	dir[1] /= length;
+	dir[2] /= length;
+
+	vec3_t inverseDirection = { 1.0f / dir[0], 1.0f / dir[1], 1.0f / dir[2] };
+
+	float closest = maxDistance;
+	const SBVHTriangle* closestTriangle = nullptr;
+
+	uint32_t stack[MAX_DEPTH * 2];
+	size_t stackSize = 0;
+	stack[stackSize++] = 0;
+
+	while (stackSize > 0)
+	{
+		const SBVHNode& node = Nodes[stack[--stackSize]];
+
+		if (IntersectBounds(node, origin, inverseDirection, closest) == FLT_MAX)
+		{
+			continue;
+		}
+
+		if (node.Count > 0)
+		{
+			for (uint32_t i = node.Offset; i < node.Offset + node.Count; ++i)
+			{
+				float distance = IntersectTriangle(Triangles[i], origin, dir);
+				// Misses return FLT_MAX, which is not more than the maximum
+				// distance of unbounded rays
+				if (distance != FLT_MAX && distance <= closest)
+				{
+					closest = distance;
+					closestTriangle = &Triangles[i];
+				}
+			}
+			continue;
+		}
+
+		// Visit the nearer child first
+		uint32_t first = (uint32_t)(&node - Nodes.data()) + 1;
+		uint32_t second = node.Offset;
+		float firstDistance = IntersectBounds(Nodes[first], origin, inverseDirection, closest);
+		float secondDistance = IntersectBounds(Nodes[second], origin, inverseDirection, closest);
+		if (firstDistance > secondDistance)
+		{
+			std::swap(first, second);
+			std::swap(firstDistance, secondDistance);
+		}
+		if (secondDistance != FLT_MAX)
+		{
+			stack[stackSize++] = second;
+		}
+		if (firstDistance != FLT_MAX)
+		{
+			stack[stackSize++] = first;
+		}
+	}
+
+	if (!closestTriangle)
+	{
+		return false;
+	}
+
+	hit.Distance = closest;
+	hit.Point[0] = origin[0] + dir[0] * closest;
+	hit.Point[1] = origin[1] + dir[1] * closest;
+	hit.Point[2] = origin[2] + dir[2] * closest;
+
+	vec3_t edge1, edge2;
+	Sub(closestTriangle->B, closestTriangle->A, edge1);
+	Sub(closestTriangle->C, closestTriangle->A, edge2);
+	Cross(edge1, edge2, hit.Normal);
+	vec3_normalize(hit.Normal);
+	if (Dot(hit.Normal, dir) > 0.0f)
+	{
+		hit.Normal[0] = -hit.Normal[0];
+		hit.Normal[1] = -hit.Normal[1];
+		hit.Normal[2] = -hit.Normal[2];
+	}
+
+	hit.Mesh = closestTriangle->Mesh;
+	hit.Triangle = closestTriangle->Index;
+	return true;
+}
+
+/** Finds the closest point on a triangle, from "Real-Time Collision Detection". */
+static void ClosestPointOnTriangle(const SBVHTriangle& triangle, const float* p, float* out)
+{
+	const float* a = triangle.A;
+	const float* b = triangle.B;
+	const float* c = triangle.C;
+	vec3_t ab, ac, ap, bp, cp;
+	Sub(b, a, ab);
+	Sub(c, a, ac);
+	Sub(p, a, ap);
+
+	float d1 = Dot(ab, ap);
+	float d2 = Dot(ac, ap);
+	if (d1 <= 0.0f && d2 <= 0.0f)
+	{
+		vec3_copy(a, out);
+		return;
+	}
+
+	Sub(p, b, bp);
+	float d3 = Dot(ab, bp);
+	float d4 = Dot(ac, bp);
+	if (d3 >= 0.0f && d4 <= d3)
+	{
+		vec3_copy(b, out);
+		return;
+	}
+
+	float vc = d1 * d4 - d3 * d2;
+	if (vc <= 0.0f && d1 >= 0.0f && d3 <= 0.0f)
+	{
+		float v = d1 / (d1 - d3);
+		for (size_t i = 0; i < 3; ++i)
+		{
+			out[i] = a[i] + ab[i] * v;
+		}
+		return;
+	}
+
+	Sub(p, c, cp);
+	float d5 = Dot(ab, cp);
+	float d6 = Dot(ac, cp);
+	if (d6 >= 0.0f && d5 <= d6)
+	{
+		vec3_copy(c, out);
+		return;
+	}
+
+	float vb = d5 * d2 - d1 * d6;
+	if (vb <= 0.0f && d2 >= 0.0f && d6 <= 0.0f)
+	{
+		float w = d2 / (d2 - d6);
+		for (size_t i = 0; i < 3; ++i)
+		{
+			out[i] = a[i] + ac[i] * w;
+		}
+		return;
+	}
+
+	float va = d3 * d6 - d5 * d4;
+	if (va <= 0.0f && (d4 - d3) >= 0.0f && (d5 - d6) >= 0.0f)
+	{
+		float w = (d4 - d3) / ((d4 - d3) + (d5 - d6));
+		for (size_t i = 0; i < 3; ++i)
+		{
+			out[i] = b[i] + (c[i] - b[i]) * w;
+		}
+		return;
+	}
+
+	float denominator = 1.0f / (va + vb + vc);
+	float v = vb * denominator;
+	float w = vc * denominator;
+	for (size_t i = 0; i < 3; ++i)
+	{
+		out[i] = a[i] + ab[i] * v + ac[i] * w;
+	}
+}
+
+/** Returns the squared distance of a point from a box. */
+static inline float GetDistanceSquared(const SBVHNode& node, const float* point)
+{
+	float distance = 0.0f;
+	for (size_t i = 0; i < 3; ++i)
+	{
+		float d = std::max(std::max(node.Min[i] - point[i], 0.0f), point[i] - node.Max[i]);
+		distance += d * d;
+	}
+	return distance;
+}
+
+bool SBVH::OverlapSphere(const vec3_t center, float radius, SBVHHit& hit) const
+{
+	if (Nodes.empty())
+	{
+		return false;
+	}
+
+	float closest = radius * radius;
+	const SBVHTriangle* closestTriangle = nullptr;
+	vec3_t point;
+
+	uint32_t stack[MAX_DEPTH * 2];
+	size_t stackSize = 0;
+	stack[stackSize++] = 0;
+
+	while (stackSize > 0)
+	{
+		uint32_t index = stack[--stackSize];
+		const SBVHNode& node = Nodes[index];
+
+		if (GetDistanceSquared(node, center) > closest)
+		{
+			continue;
+		}
+
+		if (node.Count > 0)
+		{
+			for (uint32_t i = node.Offset; i < node.Offset + node.Count; ++i)
+			{
+				ClosestPointOnTriangle(Triangles[i], center, point);
+				vec3_t offset;
+				Sub(center, point, offset);
+				float distance = Dot(offset, offset);
+				if (distance <= closest)
+				{
+					closest = distance;
+					closestTriangle = &Triangles[i];
+					vec3_copy(point, hit.Point);
+				}
+			}
+			continue;
+		}
+
+		stack[stackSize++] = node.Offset;
+		stack[stackSize++] = index + 1;
+	}
+
+	if (!closestTriangle)
+	{
+		return false;
+	}
+
+	hit.Distance = std::sqrt(closest);
+	Sub(center, hit.Point, hit.Normal);
+
+	if (hit.Distance > 0.0f)
+	{
+		vec3_normalize(hit.Normal);
+	}
+	else
+	{
+		// The center lies on the triangle, use its normal
+		vec3_t edge1, edge2;
+		Sub(closestTriangle->B, closestTriangle->A, edge1);
+		Sub(closestTriangle->C, closestTriangle->A, edge2);
+		Cross(edge1, edge2, hit.Normal);
+		vec3_normalize(hit.Normal);
+	}
+
+	hit.Mesh = closestTriangle->Mesh;
+	hit.Triangle = closestTriangle->Index;
+	return true;
+}
+
+/** Writes a hit or a miss into an array of BBMOD_BVH_HIT_SIZE floats. */
+static inline void WriteHit(float* out, const SBVHHit* hit)
+{
+	if (!hit)
+	{
+		std::fill(out, out + BBMOD_BVH_HIT_SIZE, 0.0f);
+		out[0] = -1.0f;
+		return;
+	}
+
+	out[0] = hit->Distance;
+	vec3_copy(hit->Point, &out[1]);
+	vec3_copy(hit->Normal, &out[4]);
+	out[7] = (float)hit->Mesh;
+	out[8] = (float)hit->Triangle;
+}
+
+/** Counts hits written by WriteHit. */
+static size_t CountHits(const float* hits, size_t count)
+{
+	size_t hitCount = 0;
+	for (size_t i = 0; i < count; ++i)
+	{
+		if (hits[i * BBMOD_BVH_HIT_SIZE] >= 0.0f)
+		{
+			++hitCount;
+		}
+	}
+	return hitCount;
+}
+
+size_t RaycastBatch(const SBVH* bvh, const float* rays, size_t count, float* hits, SJobSystem& jobSystem)
+{
+	jobSystem.Dispatch(count, BBMOD_BVH_QUERY_BATCH_SIZE,
+		[bvh, rays, hits](size_t begin, size_t end)
+		{
+			SBVHHit hit;
+			for (size_t i = begin; i < end; ++i)
+			{
+				const float* ray = &rays[i * BBMOD_BVH_RAY_SIZE];
+				bool isHit = bvh->Raycast(&ray[0], &ray[3], ray[6], hit);
+				WriteHit(&hits[i * BBMOD_BVH_HIT_SIZE], isHit ? &hit : nullptr);
+			}
+		});
+	jobSystem.Wait();
+	return CountHits(hits, count);
+}
+
+size_t OverlapSphereBatch(const SBVH* bvh, const float* spheres, size_t count, float* hits, SJobSystem& jobSystem)
+{
+	jobSystem.Dispatch(count, BBMOD_BVH_QUERY_BATCH_SIZE,
+		[bvh, spheres, hits](size_t begin, size_t end)
+		{
+			SBVHHit hit;
+			for (size_t i = begin; i < end; ++i)
+			{
+				const float* sphere = &spheres[i * BBMOD_BVH_SPHERE_SIZE];
+				bool isHit = bvh->OverlapSphere(&sphere[0], sphere[3], hit);
+				WriteHit(&hits[i * BBMOD_BVH_HIT_SIZE], isHit ? &hit : nullptr);
+			}
+		});
+	jobSystem.Wait();
+	return CountHits(hits, count);
+}
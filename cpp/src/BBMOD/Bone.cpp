@@ -8,6 +8,11 @@ bool SBone::Save(std::ofstream& file)
 	return true;
 }
 
+size_t SBone::GetSize() const
+{
+	return sizeof(Index) + sizeof(float) * 16;
+}
+
 SBone* SBone::Load(std::ifstream& file)
 {
 	SBone* bone = new SBone();
@@ -0,0 +1,453 @@
+#include <BBMOD/BoneInfluences.hpp>
+
+#include <algorithm>
+#include <cstdint>
+#include <map>
+#include <utility>
+
+/** Sorts bone indices and weights of a vertex from the largest weight. */
+static void SortInfluences(SVertex* vertex)
+{
+	std::pair<float, float> influences[4];
+	for (size_t i = 0; i < 4; ++i)
+	{
+		influences[i] = { vertex->Weights[i], vertex->Bones[i] };
+	}
+
+	std::stable_sort(influences, influences + 4,
+		[](const std::pair<float, float>& a, const std::pair<float, float>& b) {
+			return a.first > b.first;
+		});
+
+	for (size_t i = 0; i < 4; ++i)
+	{
+		vertex->Weights[i] = influences[i].first;
+		vertex->Bones[i] = influences[i].second;
+	}
+}
+
+/** Returns the number of bones with a non-zero weight influencing a vertex. */
+static inline uint8_t GetInfluenceCount(const SVertex* vertex)
+{
+	uint8_t count = 0;
+	for (size_t i = 0; i < 4; ++i)
+	{
+		if (vertex->Weights[i] != 0.0f)
+		{
+			++count;
+		}
+	}
+	return count;
+}
+
+/** Returns the smallest supported number of influences fitting a count. */
+static inline uint8_t GetInfluenceClass(uint8_t count)
+{
+	return (count <= 1) ? 1 : ((count <= 2) ? 2 : 4);
+}
+
+size_t PruneBoneWeights(SModel* model, float threshold)
+{
+	size_t removed = 0;
+
+	for (SMesh* mesh : model->Meshes)
+	{
+		if (!mesh->VertexFormat->Bones)
+		{
+			continue;
+		}
+
+		for (SVertex* vertex : mesh->Data)
+		{
+			SortInfluences(vertex);
+
+			float sum = vertex->Weights[0];
+			for (size_t i = 1; i < 4; ++i)
+			{
+				if (vertex->Weights[i] != 0.0f && vertex->Weights[i] < threshold)
+				{
+					vertex->Weights[i] = 0.0f;
+					vertex->Bones[i] = 0.0f;
+					++removed;
+				}
+				sum += vertex->Weights[i];
+			}
+
+			if (sum > 0.0f)
+			{
+				for (size_t i = 0; i < 4; ++i)
+				{
+					vertex->Weights[i] /= sum;
+				}
+			}
+		}
+	}
+
+	return removed;
+}
+
+/** Adds meshes split from the meshes of a node into the node and its children. */
+static void AddSplitMeshes(SNode* node, const std::vector<std::vector<size_t>>& splits)
+{
+	size_t meshCount = node->Meshes.size();
+	for (size_t i = 0; i < meshCount; ++i)
+	{
+		for (size_t added : splits[node->Meshes[i]])
+		{
+			node->Meshes.push_back(added);
+		}
+	}
+
+	for (SNode* child : node->Children)
+	{
+		AddSplitMeshes(child, splits);
+	}
+}
+
+size_t SplitByBoneInfluences(SModel* model)
+{
+	size_t meshCount = model->Meshes.size();
+	std::vector<std::vector<size_t>> splits(meshCount);
+	size_t added = 0;
+
+	for (size_t m = 0; m < meshCount; ++m)
+	{
+		SMesh* mesh = model->Meshes[m];
+		if (!mesh->VertexFormat->Bones
+			|| mesh->PrimitiveType != BBMOD_PRIMITIVE_TRIANGLE_LIST)
+		{
+			continue;
+		}
+
+		// Triangles of each class, from the most influences, so the original
+		// mesh keeps the most expensive ones
+		const uint8_t classes[3] = { 4, 2, 1 };
+		std::vector<SVertex*> buckets[3];
+
+		for (size_t i = 0; i + 2 < mesh->Data.size(); i += 3)
+		{
+			uint8_t count = std::max({
+				GetInfluenceCount(mesh->Data[i]),
+				GetInfluenceCount(mesh->Data[i + 1]),
+				GetInfluenceCount(mesh->Data[i + 2]) });
+			uint8_t influences = GetInfluenceClass(count);
+
+			std::vector<SVertex*>& bucket = buckets[(influences == 4) ? 0 : ((influences == 2) ? 1 : 2)];
+			bucket.insert(bucket.end(), mesh->Data.begin() + i, mesh->Data.begin() + i + 3);
+		}
+
+		bool first = true;
+
+		for (size_t c = 0; c < 3; ++c)
+		{
+			if (buckets[c].empty())
+			{
+				continue;
+			}
+
+			SMesh* target = mesh;
+
+			if (first)
+			{
+				mesh->Data = std::move(buckets[c]);
+				mesh->VertexFormat->BoneInfluences = classes[c];
+				first = false;
+			}
+			else
+			{
+				target = new SMesh();
+				target->VertexFormat = new SVertexFormat(*mesh->VertexFormat);
+				target->VertexFormat->BoneInfluences = classes[c];
+				target->MaterialIndex = mesh->MaterialIndex;
+				target->PrimitiveType = mesh->PrimitiveType;
+				target->Data = std::move(buckets[c]);
+
+				splits[m].push_back(model->Meshes.size());
+				model->Meshes.push_back(target);
+				++added;
+			}
+
+			for (SVertex* vertex : target->Data)
+			{
+				vertex->VertexFormat = target->VertexFormat;
+			}
+		}
+	}
+
+	if (added > 0)
+	{
+		AddSplitMeshes(model->RootNode, splits);
+	}
+
+	// The vertex format of the model has the most influences of its meshes
+	uint8_t influences = 1;
+	for (SMesh* mesh : model->Meshes)
+	{
+		if (mesh->VertexFormat->Bones)
+		{
+			influences = std::max(influences, mesh->VertexFormat->BoneInfluences);
+		}
+	}
+	model->VertexFormat->BoneInfluences = influences;
+
+	return added;
+}
+
+/**
+ * Meshes are merged only if they use the same material and their vertices
+ * have the same attributes, since vertices which did not have an attribute
+ * would get a made up value. Only the number of bone influences can differ.
+ */
+typedef std::pair<size_t, uint32_t> merge_key_t;
+
+/** Returns a key of a mesh, under which it is merged with others. */
+static merge_key_t GetMergeKey(const SMesh* mesh)
+{
+	SVertexFormat vertexFormat = *mesh->VertexFormat;
+	vertexFormat.Bones = true;
+	vertexFormat.BoneInfluences = 4;
+	return { mesh->MaterialIndex, vertexFormat.GetMask() };
+}
+
+/** Vertices of rigidly attached meshes with the same merge key. */
+struct SRigidVertices
+{
+	SVertexFormat VertexFormat;
+
+	std::vector<SVertex*> Data;
+};
+
+/**
+ * Converts meshes without bones of a node and its children into vertices
+ * skinned to the closest bone. The transform takes the vertices from the
+ * node's space into the space of the bone.
+ */
+static size_t CollectRigidMeshes(SModel* model, SNode* node, const SNode* bone,
+	const matrix_t parentTransform, std::map<merge_key_t, SRigidVertices>& rigid)
+{
+	matrix_t transform = MATRIX_IDENTITY;
+
+	if (node->IsBone && (size_t)node->Index < model->BoneCount)
+	{
+		bone = node;
+	}
+	else if (bone)
+	{
+		matrix_copy(node->TransformMatrix, transform);
+		matrix_multiply(transform, parentTransform);
+	}
+
+	size_t converted = 0;
+
+	if (bone)
+	{
+		// Skinned vertices are in the bind pose, which the offset matrix takes
+		// into the space of the bone
+		matrix_t bindTransform;
+		matrix_copy(transform, bindTransform);
+		matrix_t offsetInverse;
+		matrix_copy(model->Skeleton[(size_t)bone->Index]->OffsetMatrix, offsetInverse);
+		matrix_inverse(offsetInverse);
+		matrix_multiply(bindTransform, offsetInverse);
+
+		matrix_t normalTransform;
+		matrix_copy(bindTransform, normalTransform);
+		matrix_inverse(normalTransform);
+		matrix_transpose(normalTransform);
+
+		// Mirroring transforms flip the bitangent and the winding order
+		bool mirror = (matrix_determinant(bindTransform) < 0.0f);
+
+		std::vector<size_t> meshes;
+
+		for (size_t meshIndex : node->Meshes)
+		{
+			const SMesh* mesh = model->Meshes[meshIndex];
+			if (mesh->VertexFormat->Bones
+				|| mesh->PrimitiveType != BBMOD_PRIMITIVE_TRIANGLE_LIST)
+			{
+				meshes.push_back(meshIndex);
+				continue;
+			}
+
+			SRigidVertices& vertices = rigid[GetMergeKey(mesh)];
+			vertices.VertexFormat.Add(*mesh->VertexFormat);
+
+			for (size_t i = 0; i + 2 < mesh->Data.size(); i += 3)
+			{
+				SVertex* triangle[3];
+				for (size_t j = 0; j < 3; ++j)
+				{
+					const SVertex* vertex = mesh->Data[i + j];
+					SVertex* result = new SVertex(*vertex);
+
+					matrix_transform_vec3(bindTransform, vertex->Position, 1.0f, result->Position);
+
+					matrix_transform_vec3(normalTransform, vertex->Normal, 0.0f, result->Normal);
+					vec3_normalize(result->Normal);
+
+					matrix_transform_vec3(bindTransform, vertex->Tangent, 0.0f, result->Tangent);
+					vec3_normalize(result->Tangent);
+					result->BitangentSign *= mirror ? -1.0f : 1.0f;
+
+					vec4_t bones = { bone->Index, 0.0f, 0.0f, 0.0f };
+					vec4_t weights = { 1.0f, 0.0f, 0.0f, 0.0f };
+					vec4_copy(bones, result->Bones);
+					vec4_copy(weights, result->Weights);
+
+					triangle[j] = result;
+				}
+				if (mirror)
+				{
+					std::swap(triangle[1], triangle[2]);
+				}
+				vertices.Data.insert(vertices.Data.end(), triangle, triangle + 3);
+			}
+
+			++converted;
+		}
+
+		node->Meshes = meshes;
+	}
+
+	for (SNode* child : node->Children)
+	{
+		converted += CollectRigidMeshes(model, child, bone, transform, rigid);
+	}
+
+	return converted;
+}
+
+/** Counts how many times nodes reference each mesh. */
+static void CountMeshReferences(const SNode* node, std::vector<size_t>& references)
+{
+	for (size_t meshIndex : node->Meshes)
+	{
+		++references[meshIndex];
+	}
+
+	for (const SNode* child : node->Children)
+	{
+		CountMeshReferences(child, references);
+	}
+}
+
+/** Changes mesh indices of a node and its children, dropping removed meshes. */
+static void RemapMeshes(SNode* node, const std::vector<size_t>& remap)
+{
+	std::vector<size_t> meshes;
+	for (size_t meshIndex : node->Meshes)
+	{
+		if (remap[meshIndex] != SIZE_MAX)
+		{
+			meshes.push_back(remap[meshIndex]);
+		}
+	}
+	node->Meshes = meshes;
+
+	for (SNode* child : node->Children)
+	{
+		RemapMeshes(child, remap);
+	}
+}
+
+size_t MergeRigidMeshes(SModel* model)
+{
+	if (model->BoneCount == 0)
+	{
+		return 0;
+	}
+
+	std::map<merge_key_t, SRigidVertices> rigid;
+	matrix_t identity = MATRIX_IDENTITY;
+	size_t converted = CollectRigidMeshes(model, model->RootNode, nullptr, identity, rigid);
+
+	if (converted == 0)
+	{
+		return 0;
+	}
+
+	// The first skinned mesh with each merge key takes all others
+	size_t meshCount = model->Meshes.size();
+	std::map<merge_key_t, SMesh*> targets;
+	std::vector<bool> merged(meshCount, false);
+
+	for (size_t m = 0; m < meshCount; ++m)
+	{
+		SMesh* mesh = model->Meshes[m];
+		if (!mesh->VertexFormat->Bones
+			|| mesh->PrimitiveType != BBMOD_PRIMITIVE_TRIANGLE_LIST)
+		{
+			continue;
+		}
+
+		SMesh*& target = targets[GetMergeKey(mesh)];
+		if (!target)
+		{
+			target = mesh;
+			continue;
+		}
+
+		target->VertexFormat->Add(*mesh->VertexFormat);
+		target->Data.insert(target->Data.end(), mesh->Data.begin(), mesh->Data.end());
+		mesh->Data.clear();
+		merged[m] = true;
+	}
+
+	for (auto& pair : rigid)
+	{
+		SRigidVertices& vertices = pair.second;
+		vertices.VertexFormat.Bones = true;
+		vertices.VertexFormat.BoneInfluences = 1;
+
+		SMesh*& target = targets[pair.first];
+		if (!target)
+		{
+			target = new SMesh();
+			target->VertexFormat = new SVertexFormat(vertices.VertexFormat);
+			target->MaterialIndex = pair.first.first;
+			model->RootNode->Meshes.push_back(model->Meshes.size());
+			model->Meshes.push_back(target);
+		}
+
+		target->VertexFormat->Add(vertices.VertexFormat);
+		target->Data.insert(target->Data.end(), vertices.Data.begin(), vertices.Data.end());
+	}
+
+	for (auto& pair : targets)
+	{
+		for (SVertex* vertex : pair.second->Data)
+		{
+			vertex->VertexFormat = pair.second->VertexFormat;
+		}
+	}
+
+	// Remove merged meshes and meshes which are not used by any node anymore
+	std::vector<size_t> references(model->Meshes.size(), 0);
+	CountMeshReferences(model->RootNode, references);
+
+	std::vector<size_t> remap(model->Meshes.size(), SIZE_MAX);
+	std::vector<SMesh*> meshes;
+
+	for (size_t m = 0; m < model->Meshes.size(); ++m)
+	{
+		SMesh* mesh = model->Meshes[m];
+		if ((m < meshCount && merged[m]) || references[m] == 0)
+		{
+			delete mesh;
+			continue;
+		}
+		remap[m] = meshes.size();
+		meshes.push_back(mesh);
+	}
+
+	RemapMeshes(model->RootNode, remap);
+	model->Meshes = meshes;
+
+	for (SMesh* mesh : model->Meshes)
+	{
+		model->VertexFormat->Add(*mesh->VertexFormat);
+	}
+
+	return converted;
+}
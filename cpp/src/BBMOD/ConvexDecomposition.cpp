@@ -0,0 +1,732 @@
+#include <BBMOD/ConvexDecomposition.hpp>
+#include <utils.hpp>
+
+#include <algorithm>
+#include <cfloat>
+#include <cmath>
+#include <cstdint>
+#include <fstream>
+#include <set>
+#include <utility>
+
+static inline float Dot(const float* a, const float* b)
+{
+	return (a[0] * b[0] + a[1] * b[1] + a[2] * b[2]);
+}
+
+static inline void Cross(const float* a, const float* b, float* out)
+{
+	out[0] = a[1] * b[2] - a[2] * b[1];
+	out[1] = a[2] * b[0] - a[0] * b[2];
+	out[2] = a[0] * b[1] - a[1] * b[0];
+}
+
+static inline void Sub(const float* a, const float* b, float* out)
+{
+	out[0] = a[0] - b[0];
+	out[1] = a[1] - b[1];
+	out[2] = a[2] - b[2];
+}
+
+static inline float DistanceSquared(const float* a, const float* b)
+{
+	vec3_t d;
+	Sub(a, b, d);
+	return Dot(d, d);
+}
+
+/** A triangle of a hull, with a plane facing out of the hull. */
+struct SHullFace
+{
+	SHullFace()
+		: Normal VEC3_ZERO
+	{
+	}
+
+	size_t V[3] = { 0, 0, 0 };
+
+	vec3_t Normal;
+
+	float Offset = 0.0f;
+
+	bool Removed = false;
+
+	float GetDistance(const float* point) const
+	{
+		return Dot(Normal, point) - Offset;
+	}
+};
+
+/** A part of a mesh approximated by a single hull. */
+struct SHullPart
+{
+	/** Indices of triangles of the mesh. */
+	std::vector<size_t> Triangles;
+
+	/** Vertices of the hull, three floats each. */
+	std::vector<float> Points;
+
+	std::vector<SHullFace> Faces;
+
+	/** False if the part is flat. */
+	bool Valid = false;
+
+	/** Depth of the deepest point of the part inside of its hull. */
+	float Concavity = 0.0f;
+
+	vec3_t Deepest = VEC3_ZERO;
+};
+
+/** Creates a face of points a, b and c with a normal given by their winding. */
+static SHullFace MakeFace(const std::vector<float>& points, size_t a, size_t b, size_t c)
+{
+	SHullFace face;
+	face.V[0] = a;
+	face.V[1] = b;
+	face.V[2] = c;
+
+	vec3_t ab, ac;
+	Sub(&points[b * 3], &points[a * 3], ab);
+	Sub(&points[c * 3], &points[a * 3], ac);
+	Cross(ab, ac, face.Normal);
+	vec3_normalize(face.Normal);
+	face.Offset = Dot(face.Normal, &points[a * 3]);
+
+	return face;
+}
+
+/** Creates a face of points a, b and c facing away from a point inside. */
+static SHullFace MakeFace(const std::vector<float>& points, size_t a, size_t b, size_t c, const float* inside)
+{
+	SHullFace face = MakeFace(points, a, b, c);
+	if (face.GetDistance(inside) > 0.0f)
+	{
+		face = MakeFace(points, a, c, b);
+	}
+	return face;
+}
+
+/**
+ * Builds a convex hull of points incrementally. Returns false if the points
+ * are flat.
+ */
+static bool BuildHull(const std::vector<float>& points, float epsilon, std::vector<SHullFace>& faces)
+{
+	size_t count = points.size() / 3;
+	if (count < 4)
+	{
+		return false;
+	}
+
+	// Initial tetrahedron from the most distant points
+	size_t a = 0;
+	for (size_t i = 1; i < count; ++i)
+	{
+		if (points[i * 3] < points[a * 3])
+		{
+			a = i;
+		}
+	}
+
+	size_t b = a;
+	float best = 0.0f;
+	for (size_t i = 0; i < count; ++i)
+	{
+		float d = DistanceSquared(&points[i * 3], &points[a * 3]);
+		if (d > best)
+		{
+			best = d;
+			b = i;
+		}
+	}
+
+	if (best <= epsilon * epsilon)
+	{
+		return false;
+	}
+
+	vec3_t ab;
+	Sub(&points[b * 3], &points[a * 3], ab);
+
+	size_t c = a;
+	best = 0.0f;
+	for (size_t i = 0; i < count; ++i)
+	{
+		vec3_t ap, cross;
+		Sub(&points[i * 3], &points[a * 3], ap);
+		Cross(ab, ap, cross);
+		float d = Dot(cross, cross);
+		if (d > best)
+		{
+			best = d;
+			c = i;
+		}
+	}
+
+	if (best <= epsilon * epsilon * Dot(ab, ab))
+	{
+		return false;
+	}
+
+	SHullFace base = MakeFace(points, a, b, c);
+
+	size_t d = a;
+	best = 0.0f;
+	for (size_t i = 0; i < count; ++i)
+	{
+		float distance = std::abs(base.GetDistance(&points[i * 3]));
+		if (distance > best)
+		{
+			best = distance;
+			d = i;
+		}
+	}
+
+	if (best <= epsilon)
+	{
+		return false;
+	}
+
+	vec3_t inside;
+	for (size_t i = 0; i < 3; ++i)
+	{
+		inside[i] = (points[a * 3 + i] + points[b * 3 + i]
+			+ points[c * 3 + i] + points[d * 3 + i]) * 0.25f;
+	}
+
+	faces.clear();
+	faces.push_back(MakeFace(points, a, b, c, inside));
+	faces.push_back(MakeFace(points, a, b, d, inside));
+	faces.push_back(MakeFace(points, a, c, d, inside));
+	faces.push_back(MakeFace(points, b, c, d, inside));
+
+	// Add remaining points one by one, replacing faces which they see with
+	// faces connecting them to the horizon
+	std::set<std::pair<size_t, size_t>> edges;
+
+	for (size_t p = 0; p < count; ++p)
+	{
+		const float* point = &points[p * 3];
+
+		edges.clear();
+		for (SHullFace& face : faces)
+		{
+			if (!face.Removed && face.GetDistance(point) > epsilon)
+			{
+				face.Removed = true;
+				edges.emplace(face.V[0], face.V[1]);
+				edges.emplace(face.V[1], face.V[2]);
+				edges.emplace(face.V[2], face.V[0]);
+			}
+		}
+
+		if (edges.empty())
+		{
+			continue;
+		}
+
+		for (const auto& edge : edges)
+		{
+			if (edges.find({ edge.second, edge.first }) == edges.end())
+			{
+				faces.push_back(MakeFace(points, edge.first, edge.second, p));
+			}
+		}
+
+		faces.erase(
+			std::remove_if(faces.begin(), faces.end(),
+				[](const SHullFace& face) { return face.Removed; }),
+			faces.end());
+	}
+
+	return true;
+}
+
+/** Returns directions evenly distributed on a unit sphere. */
+static const std::vector<float>& GetDirections()
+{
+	static std::vector<float> directions;
+
+	if (directions.empty())
+	{
+		// Fibonacci sphere
+		const float goldenAngle = 2.39996323f;
+		for (size_t i = 0; i < BBMOD_HULL_DIRECTION_COUNT; ++i)
+		{
+			float y = 1.0f - 2.0f * (i + 0.5f) / BBMOD_HULL_DIRECTION_COUNT;
+			float r = std::sqrt(1.0f - y * y);
+			float angle = goldenAngle * i;
+			directions.push_back(std::cos(angle) * r);
+			directions.push_back(y);
+			directions.push_back(std::sin(angle) * r);
+		}
+	}
+
+	return directions;
+}
+
+/** Finds distinct points of a part furthest in each of the directions. */
+static void GetSupportPoints(const SMesh* mesh, const std::vector<size_t>& triangles, std::vector<float>& out)
+{
+	const std::vector<float>& directions = GetDirections();
+	std::set<const SVertex*> support;
+
+	for (size_t i = 0; i < directions.size(); i += 3)
+	{
+		const float* direction = &directions[i];
+		const SVertex* best = nullptr;
+		float bestDistance = -FLT_MAX;
+
+		for (size_t triangle : triangles)
+		{
+			for (size_t j = 0; j < 3; ++j)
+			{
+				const SVertex* vertex = mesh->Data[triangle * 3 + j];
+				float distance = Dot(direction, vertex->Position);
+				if (distance > bestDistance)
+				{
+					bestDistance = distance;
+					best = vertex;
+				}
+			}
+		}
+
+		support.insert(best);
+	}
+
+	out.clear();
+	for (const SVertex* vertex : support)
+	{
+		out.insert(out.end(), vertex->Position, vertex->Position + 3);
+	}
+}
+
+/**
+ * Returns a distance from a point inside of a hull to its surface in a
+ * direction.
+ */
+static float GetExitDistance(const std::vector<SHullFace>& faces, const float* point, const float* direction)
+{
+	float distance = FLT_MAX;
+	for (const SHullFace& face : faces)
+	{
+		float cos = Dot(face.Normal, direction);
+		if (cos > 0.0f)
+		{
+			distance = std::min(distance, -face.GetDistance(point) / cos);
+		}
+	}
+	return std::max(distance, 0.0f);
+}
+
+/**
+ * Builds a hull of a part and finds how deep its triangles are inside of it,
+ * measured from their centers to the hull along their normals. Both sides are
+ * tested, so the result does not depend on the winding order.
+ */
+static void EvaluatePart(const SMesh* mesh, float epsilon, SHullPart& part)
+{
+	GetSupportPoints(mesh, part.Triangles, part.Points);
+	part.Valid = BuildHull(part.Points, epsilon, part.Faces);
+	part.Concavity = 0.0f;
+
+	if (!part.Valid)
+	{
+		return;
+	}
+
+	for (size_t triangle : part.Triangles)
+	{
+		const float* a = mesh->Data[triangle * 3]->Position;
+		const float* b = mesh->Data[triangle * 3 + 1]->Position;
+		const float* c = mesh->Data[triangle * 3 + 2]->Position;
+
+		vec3_t ab, ac, normal;
+		Sub(b, a, ab);
+		Sub(c, a, ac);
+		Cross(ab, ac, normal);
+		if (Dot(normal, normal) <= 0.0f)
+		{
+			continue;
+		}
+		vec3_normalize(normal);
+
+		vec3_t center, flipped;
+		for (size_t i = 0; i < 3; ++i)
+		{
+			center[i] = (a[i] + b[i] + c[i]) / 3.0f;
+			flipped[i] = -normal[i];
+		}
+
+		float depth = std::min(
+			GetExitDistance(part.Faces, center, normal),
+			GetExitDistance(part.Faces, center, flipped));
+
+		if (depth > part.Concavity)
+		{
+			part.Concavity = depth;
+			vec3_copy(center, part.Deepest);
+		}
+	}
+}
+
+/**
+ * Splits a part by the axis-aligned plane which leaves the least concave
+ * parts. Returns false if the part cannot be split.
+ */
+static bool SplitPart(const SMesh* mesh, float epsilon, const SHullPart& part, SHullPart& left, SHullPart& right)
+{
+	vec3_t min = { FLT_MAX, FLT_MAX, FLT_MAX };
+	vec3_t max = { -FLT_MAX, -FLT_MAX, -FLT_MAX };
+	std::vector<float> centers;
+
+	for (size_t triangle : part.Triangles)
+	{
+		for (size_t i = 0; i < 3; ++i)
+		{
+			float center = (mesh->Data[triangle * 3]->Position[i]
+				+ mesh->Data[triangle * 3 + 1]->Position[i]
+				+ mesh->Data[triangle * 3 + 2]->Position[i]) / 3.0f;
+			centers.push_back(center);
+			min[i] = std::min(min[i], center);
+			max[i] = std::max(max[i], center);
+		}
+	}
+
+	float bestScore = FLT_MAX;
+
+	for (size_t axis = 0; axis < 3; ++axis)
+	{
+		// Split through the deepest concavity or in the middle
+		float planes[2] = {
+			part.Deepest[axis],
+			(min[axis] + max[axis]) * 0.5f,
+		};
+
+		for (float plane : planes)
+		{
+			SHullPart candidates[2];
+
+			for (size_t i = 0; i < part.Triangles.size(); ++i)
+			{
+				size_t side = (centers[i * 3 + axis] < plane) ? 0 : 1;
+				candidates[side].Triangles.push_back(part.Triangles[i]);
+			}
+
+			if (candidates[0].Triangles.empty() || candidates[1].Triangles.empty())
+			{
+				continue;
+			}
+
+			EvaluatePart(mesh, epsilon, candidates[0]);
+			EvaluatePart(mesh, epsilon, candidates[1]);
+
+			float score = candidates[0].Concavity + candidates[1].Concavity;
+			if (score < bestScore)
+			{
+				bestScore = score;
+				left = std::move(candidates[0]);
+				right = std::move(candidates[1]);
+			}
+		}
+	}
+
+	return (bestScore != FLT_MAX);
+}
+
+/** Reduces vertices of a hull to the given count by farthest point sampling. */
+static void ReduceHull(SHullPart& part, size_t maxVertices, float epsilon)
+{
+	std::vector<size_t> vertices;
+	for (const SHullFace& face : part.Faces)
+	{
+		vertices.insert(vertices.end(), face.V, face.V + 3);
+	}
+	std::sort(vertices.begin(), vertices.end());
+	vertices.erase(std::unique(vertices.begin(), vertices.end()), vertices.end());
+
+	if (vertices.size() <= maxVertices)
+	{
+		return;
+	}
+
+	std::vector<float> distances(vertices.size(), FLT_MAX);
+	std::vector<float> points;
+	size_t next = 0;
+
+	for (size_t n = 0; n < maxVertices; ++n)
+	{
+		const float* chosen = &part.Points[vertices[next] * 3];
+		points.insert(points.end(), chosen, chosen + 3);
+
+		float best = -1.0f;
+		for (size_t i = 0; i < vertices.size(); ++i)
+		{
+			distances[i] = std::min(distances[i],
+				DistanceSquared(&part.Points[vertices[i] * 3], chosen));
+			if (distances[i] > best)
+			{
+				best = distances[i];
+				next = i;
+			}
+		}
+	}
+
+	std::vector<SHullFace> faces;
+	if (BuildHull(points, epsilon, faces))
+	{
+		part.Points = points;
+		part.Faces = faces;
+	}
+}
+
+/** Decomposes a mesh into hulls. */
+static void DecomposeMesh(const SMesh* mesh, size_t node, size_t maxHulls, size_t maxVertices,
+	std::vector<SHull>& hulls)
+{
+	size_t triangleCount = mesh->Data.size() / 3;
+	if (triangleCount == 0)
+	{
+		return;
+	}
+
+	vec3_t min = { FLT_MAX, FLT_MAX, FLT_MAX };
+	vec3_t max = { -FLT_MAX, -FLT_MAX, -FLT_MAX };
+	for (const SVertex* vertex : mesh->Data)
+	{
+		for (size_t i = 0; i < 3; ++i)
+		{
+			min[i] = std::min(min[i], vertex->Position[i]);
+			max[i] = std::max(max[i], vertex->Position[i]);
+		}
+	}
+	float size = std::sqrt(DistanceSquared(min, max));
+	float epsilon = size * 0.00001f;
+	float threshold = size * BBMOD_HULL_CONCAVITY;
+
+	std::vector<SHullPart> parts(1);
+	for (size_t i = 0; i < triangleCount; ++i)
+	{
+		parts[0].Triangles.push_back(i);
+	}
+	EvaluatePart(mesh, epsilon, parts[0]);
+
+	// Split the most concave part until all are convex enough
+	while (parts.size() < maxHulls)
+	{
+		size_t worst = 0;
+		for (size_t i = 1; i < parts.size(); ++i)
+		{
+			if (parts[i].Concavity > parts[worst].Concavity)
+			{
+				worst = i;
+			}
+		}
+
+		if (parts[worst].Concavity <= threshold)
+		{
+			break;
+		}
+
+		SHullPart left, right;
+		if (!SplitPart(mesh, epsilon, parts[worst], left, right))
+		{
+			parts[worst].Concavity = 0.0f;
+			continue;
+		}
+
+		parts[worst] = std::move(left);
+		parts.push_back(std::move(right));
+	}
+
+	for (SHullPart& part : parts)
+	{
+		if (!part.Valid)
+		{
+			continue;
+		}
+
+		ReduceHull(part, maxVertices, epsilon);
+
+		// Keep only points used by the faces
+		SHull hull;
+		hull.Node = node;
+		std::vector<size_t> remap(part.Points.size() / 3, SIZE_MAX);
+
+		for (const SHullFace& face : part.Faces)
+		{
+			for (size_t v : face.V)
+			{
+				if (remap[v] == SIZE_MAX)
+				{
+					remap[v] = hull.Vertices.size() / 3;
+					hull.Vertices.insert(hull.Vertices.end(),
+						&part.Points[v * 3], &part.Points[v * 3] + 3);
+				}
+				hull.Indices.push_back((uint16_t)remap[v]);
+			}
+		}
+
+		hulls.push_back(std::move(hull));
+	}
+}
+
+static bool IsCollisionNode(const SNode* node)
+{
+	return (node->Name.rfind(BBMOD_COLLISION_NODE_PREFIX, 0) == 0);
+}
+
+static bool HasCollisionNodes(const SNode* node)
+{
+	if (IsCollisionNode(node))
+	{
+		return true;
+	}
+
+	for (const SNode* child : node->Children)
+	{
+		if (HasCollisionNodes(child))
+		{
+			return true;
+		}
+	}
+
+	return false;
+}
+
+/**
+ * Decomposes meshes of a node and its children, each mesh only once. Removes
+ * collision meshes from the collision nodes.
+ */
+static void DecomposeNode(SModel* model, SNode* node, bool collisionOnly, size_t maxHulls,
+	size_t maxVertices, std::vector<bool>& decomposed, std::vector<SHull>& hulls)
+{
+	bool isCollision = IsCollisionNode(node);
+
+	if (!collisionOnly || isCollision)
+	{
+		for (size_t meshIndex : node->Meshes)
+		{
+			if (!decomposed[meshIndex])
+			{
+				decomposed[meshIndex] = true;
+				DecomposeMesh(model->Meshes[meshIndex], (size_t)node->Index,
+					maxHulls, maxVertices, hulls);
+			}
+		}
+	}
+
+	if (isCollision)
+	{
+		node->Meshes.clear();
+	}
+
+	for (SNode* child : node->Children)
+	{
+		DecomposeNode(model, child, collisionOnly, maxHulls, maxVertices, decomposed, hulls);
+	}
+}
+
+/** Marks meshes referenced by a node and its children. */
+static void MarkMeshes(const SNode* node, std::vector<bool>& used)
+{
+	for (size_t meshIndex : node->Meshes)
+	{
+		used[meshIndex] = true;
+	}
+
+	for (const SNode* child : node->Children)
+	{
+		MarkMeshes(child, used);
+	}
+}
+
+/** Remaps mesh indices of a node and its children. */
+static void RemapMeshes(SNode* node, const std::vector<size_t>& remap)
+{
+	for (size_t& meshIndex : node->Meshes)
+	{
+		meshIndex = remap[meshIndex];
+	}
+
+	for (SNode* child : node->Children)
+	{
+		RemapMeshes(child, remap);
+	}
+}
+
+size_t DecomposeConvex(SModel* model, size_t maxHulls, size_t maxVertices, std::vector<SHull>& hulls)
+{
+	maxHulls = std::max<size_t>(maxHulls, 1);
+	maxVertices = std::min<size_t>(std::max<size_t>(maxVertices, 4), BBMOD_HULL_DIRECTION_COUNT);
+
+	size_t meshCount = model->Meshes.size();
+	bool collisionOnly = HasCollisionNodes(model->RootNode);
+	std::vector<bool> decomposed(meshCount, false);
+
+	DecomposeNode(model, model->RootNode, collisionOnly, maxHulls, maxVertices, decomposed, hulls);
+
+	if (!collisionOnly)
+	{
+		return 0;
+	}
+
+	// Remove meshes which were referenced only by collision nodes
+	std::vector<bool> used(meshCount, false);
+	MarkMeshes(model->RootNode, used);
+
+	std::vector<size_t> remap(meshCount, SIZE_MAX);
+	std::vector<SMesh*> meshes;
+
+	for (size_t i = 0; i < meshCount; ++i)
+	{
+		if (used[i])
+		{
+			remap[i] = meshes.size();
+			meshes.push_back(model->Meshes[i]);
+		}
+		else
+		{
+			delete model->Meshes[i];
+		}
+	}
+
+	RemapMeshes(model->RootNode, remap);
+
+	size_t removed = meshCount - meshes.size();
+	model->Meshes = meshes;
+	return removed;
+}
+
+bool SaveHulls(std::string path, const std::vector<SHull>& hulls)
+{
+	std::ofstream file;
+
+	if (!OpenSidecarFile(file, path, "bbhull"))
+	{
+		return false;
+	}
+
+	size_t hullCount = hulls.size();
+	FILE_WRITE_SIZE(file, hullCount);
+
+	for (const SHull& hull : hulls)
+	{
+		FILE_WRITE_SIZE(file, hull.Node);
+
+		size_t vertexCount = hull.Vertices.size() / 3;
+		FILE_WRITE_SIZE(file, vertexCount);
+		file.write(reinterpret_cast<const char*>(hull.Vertices.data()),
+			sizeof(float) * hull.Vertices.size());
+
+		size_t triangleCount = hull.Indices.size() / 3;
+		FILE_WRITE_SIZE(file, triangleCount);
+		file.write(reinterpret_cast<const char*>(hull.Indices.data()),
+			sizeof(uint16_t) * hull.Indices.size());
+	}
+
+	file.flush();
+	file.close();
+
+	return true;
+}
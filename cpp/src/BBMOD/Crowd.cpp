@@ -0,0 +1,65 @@
+#include <BBMOD/Crowd.hpp>
+
+#include <algorithm>
+#include <cmath>
+
+void SAnimationInstance::Play(const SAnimation* animation, double time, double transition)
+{
+	if (transition > 0.0 && Animation)
+	{
+		PoseFrom.Copy(Pose);
+		TransitionDuration = transition;
+		TransitionTime = 0.0;
+	}
+	else
+	{
+		TransitionDuration = 0.0;
+	}
+
+	Animation = animation;
+	Time = time;
+}
+
+void SAnimationInstance::Update(double deltaTime)
+{
+	Time += deltaTime * Speed;
+
+	if (!Animation || !Transform || Animation->Duration <= 0.0)
+	{
+		return;
+	}
+
+	double animationTime = std::fmod(Time * Animation->TicsPerSecond, Animation->Duration);
+	if (animationTime < 0.0)
+	{
+		animationTime += Animation->Duration;
+	}
+
+	Pose.Sample(Animation, animationTime);
+
+	if (TransitionTime < TransitionDuration)
+	{
+		TransitionTime += deltaTime;
+		float factor = (float)std::min(TransitionTime / TransitionDuration, 1.0);
+		Pose.Blend(PoseFrom, 1.0f - factor);
+	}
+
+	Pose.Transform(Transform);
+}
+
+void UpdateAnimationInstances(std::vector<SAnimationInstance*>& instances, double deltaTime, SJobSystem& jobSystem)
+{
+	SAnimationInstance** data = instances.data();
+
+	jobSystem.Dispatch(instances.size(), BBMOD_CROWD_BATCH_SIZE,
+		[data, deltaTime](size_t begin, size_t end)
+		{
+			for (size_t i = begin; i < end; ++i)
+			{
+				if (data[i])
+				{
+					data[i]->Update(deltaTime);
+				}
+			}
+		});
+}
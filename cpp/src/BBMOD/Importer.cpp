@@ -1,8 +1,21 @@
 #include <BBMOD/Importer.hpp>
 #include <BBMOD/Model.hpp>
+#include <BBMOD/AmbientOcclusion.hpp>
 #include <BBMOD/Animation.hpp>
+#include <BBMOD/BoneInfluences.hpp>
+#include <BBMOD/ConvexDecomposition.hpp>
+#include <BBMOD/Instancing.hpp>
+#include <BBMOD/LevelBake.hpp>
+#include <BBMOD/Overdraw.hpp>
+#include <BBMOD/PostProcess.hpp>
+#include <BBMOD/Profiler.hpp>
+#include <BBMOD/Report.hpp>
+#include <BBMOD/ShadowProxy.hpp>
+#include <BBMOD/Stripify.hpp>
+#include <BBMOD/Weld.hpp>
 #include <terminal.hpp>
 
+#include <assimp/config.h>
 #include <assimp/Importer.hpp>
 #include <assimp/scene.h>
 #include <assimp/postprocess.h>
@@ -64,8 +77,66 @@ static void LogNode(std::ofstream& log, SNode* node, size_t indent)
 	}
 }
 
+static void CollectWarnings(SReport& report, const aiScene* scene, SModel* model, const SConfig& config)
+{
+	SVertexFormat* vformat = model->VertexFormat;
+
+	if (model->BoneCount > 64)
+	{
+		report.AddWarning(BBMOD_WARN_TOO_MANY_BONES,
+			"The model has " + std::to_string(model->BoneCount) + " bones, but the default"
+			" upper limit defined in shader BBMOD_ShDefaultAnimated is 64!");
+	}
+
+	for (size_t i = 0; i < scene->mNumMeshes; ++i)
+	{
+		aiMesh* mesh = scene->mMeshes[i];
+		std::string name = "Mesh " + std::to_string(i) + " (\"" + mesh->mName.C_Str() + "\")";
+
+		// Native post-processing generates normals and tangents after import
+		bool hasNormals = mesh->HasNormals()
+			|| (config.NativePostProcess && config.GenNormals != BBMOD_NORMALS_NONE);
+		bool hasTangents = mesh->HasTangentsAndBitangents()
+			|| (config.NativePostProcess && hasNormals && mesh->HasTextureCoords(0));
+
+		if (vformat->Normals && !hasNormals)
+		{
+			report.AddWarning(BBMOD_WARN_MISSING_NORMALS,
+				name + " has no normal vectors, but other meshes do! Its vertex format is different.");
+		}
+
+		if (vformat->TextureCoords && !mesh->HasTextureCoords(0))
+		{
+			report.AddWarning(BBMOD_WARN_MISSING_TEXTURE_COORDS,
+				name + " has no texture coordinates, but other meshes do! Its vertex format is different.");
+		}
+
+		if (vformat->TangentW && !hasTangents)
+		{
+			report.AddWarning(BBMOD_WARN_MISSING_TANGENTS,
+				name + " has no tangent vectors, but other meshes do! Its vertex format is different.");
+		}
+
+		if (!vformat->Colors && mesh->HasVertexColors(0))
+		{
+			report.AddWarning(BBMOD_WARN_UNUSED_COLORS,
+				name + " has vertex colors, but they are not included in the vertex format!");
+		}
+	}
+}
+
 int ConvertToBBMOD(const char* fin, const char* fout, const SConfig& config)
 {
+	BBMOD_PROFILE_SCOPE("ConvertToBBMOD");
+
+	SStopwatch stopwatchTotal;
+	SReport report;
+	report.Input = fin;
+	report.Output = fout;
+
+	// Shared by all parallel passes, so worker threads are started only once
+	SJobSystem jobSystem;
+
 	std::ofstream log(GetFilename(fout, "log", ".txt"), std::ios::out);
 
 	Assimp::Importer* importer = new Assimp::Importer();
@@ -73,17 +144,13 @@ int ConvertToBBMOD(const char* fin, const char* fout, const SConfig& config)
 
 	int flags = (0
 		//aiProcessPreset_TargetRealtime_Quality
-		| aiProcess_CalcTangentSpace
 		//| aiProcess_GenSmoothNormals
-		| aiProcess_JoinIdenticalVertices
-		| aiProcess_ImproveCacheLocality
 		| aiProcess_LimitBoneWeights
 		//| aiProcess_RemoveRedundantMaterials
 		| aiProcess_SplitLargeMeshes
 		| aiProcess_Triangulate
 		| aiProcess_GenUVCoords
 		| aiProcess_SortByPType
-		| aiProcess_FindDegenerates
 		| aiProcess_FindInvalidData
 		//
 		| aiProcess_TransformUVCoords
@@ -91,13 +158,23 @@ int ConvertToBBMOD(const char* fin, const char* fout, const SConfig& config)
 		//| aiProcess_OptimizeMeshes
 		);
 
-	if (config.GenNormals == BBMOD_NORMALS_FLAT)
-	{
-		flags |= aiProcess_GenNormals;
-	}
-	else if (config.GenNormals >= BBMOD_NORMALS_SMOOTH)
+	if (!config.NativePostProcess)
 	{
-		flags |= aiProcess_GenSmoothNormals;
+		flags |= (0
+			| aiProcess_CalcTangentSpace
+			| aiProcess_JoinIdenticalVertices
+			| aiProcess_FindDegenerates
+			);
+
+		if (config.GenNormals == BBMOD_NORMALS_FLAT)
+		{
+			flags |= aiProcess_GenNormals;
+		}
+		else if (config.GenNormals >= BBMOD_NORMALS_SMOOTH)
+		{
+			flags |= aiProcess_GenSmoothNormals;
+			importer->SetPropertyFloat(AI_CONFIG_PP_GSN_MAX_SMOOTHING_ANGLE, config.NormalAngle);
+		}
 	}
 
 	if (config.OptimizeMaterials)
@@ -110,7 +187,7 @@ int ConvertToBBMOD(const char* fin, const char* fout, const SConfig& config)
 		flags |= aiProcess_OptimizeGraph;
 	}
 
-	if (config.OptimizeMeshes)
+	if (config.OptimizeMeshes && !config.DetectInstances)
 	{
 		flags |= aiProcess_OptimizeMeshes;
 	}
@@ -120,7 +197,17 @@ int ConvertToBBMOD(const char* fin, const char* fout, const SConfig& config)
 		flags |= aiProcess_ConvertToLeftHanded;
 	}
 
-	const aiScene* scene = importer->ReadFile(fin, flags);
+	ProfileAssimpImporter(importer);
+
+	const aiScene* scene;
+	{
+		BBMOD_PROFILE_SCOPE("Import");
+		SStopwatch stopwatch;
+		scene = importer->ReadFile(fin, flags);
+		report.AddTiming("import", stopwatch.GetMilliseconds());
+	}
+
+	ProfileAssimpImporterEnd();
 
 	if (!scene)
 	{
@@ -130,7 +217,13 @@ int ConvertToBBMOD(const char* fin, const char* fout, const SConfig& config)
 	}
 
 	// Write BBMOD
-	SModel* model = SModel::FromAssimp(scene, config);
+	SModel* model;
+	{
+		BBMOD_PROFILE_SCOPE("ConvertModel");
+		SStopwatch stopwatch;
+		model = SModel::FromAssimp(scene, config);
+		report.AddTiming("convertModel", stopwatch.GetMilliseconds());
+	}
 
 	if (!model)
 	{
@@ -138,23 +231,270 @@ int ConvertToBBMOD(const char* fin, const char* fout, const SConfig& config)
 		return BBMOD_ERR_CONVERSION_FAILED;
 	}
 
-	if (!model->Save(fout))
+	if (config.NativePostProcess)
+	{
+		{
+			BBMOD_PROFILE_SCOPE("RemoveDegenerates");
+			SStopwatch stopwatch;
+			size_t removed = RemoveDegenerates(model, jobSystem);
+			report.AddTiming("removeDegenerates", stopwatch.GetMilliseconds());
+			PRINT_SUCCESS("Removed %d degenerate triangles!", (int)removed);
+		}
+
+		if (!config.DisableNormals && config.GenNormals != BBMOD_NORMALS_NONE)
+		{
+			BBMOD_PROFILE_SCOPE("GenerateNormals");
+			SStopwatch stopwatch;
+			// Triangles are already in the final winding order, so normals
+			// computed from them are flipped when the winding was inverted
+			float angle = (config.GenNormals == BBMOD_NORMALS_FLAT) ? 0.0f : config.NormalAngle;
+			bool flip = (config.InvertWinding != config.FlipNormals);
+			GenerateNormals(model, angle, flip, jobSystem);
+			report.AddTiming("generateNormals", stopwatch.GetMilliseconds());
+		}
+
+		if (!config.DisableNormals && !config.DisableTangentW)
+		{
+			BBMOD_PROFILE_SCOPE("GenerateTangents");
+			SStopwatch stopwatch;
+			// Match tangents generated by Assimp from the original texture
+			// coordinates
+			GenerateTangents(model, config.FlipTextureHorizontally, config.FlipTextureVertically,
+				jobSystem);
+			report.AddTiming("generateTangents", stopwatch.GetMilliseconds());
+		}
+	}
+
+	if (config.MergeRigid && model->BoneCount > 0)
+	{
+		BBMOD_PROFILE_SCOPE("MergeRigid");
+		SStopwatch stopwatch;
+		size_t meshCount = model->Meshes.size();
+		size_t converted = MergeRigidMeshes(model);
+		report.AddTiming("mergeRigid", stopwatch.GetMilliseconds());
+		PRINT_SUCCESS("Skinned %d rigidly attached meshes and merged %d meshes into %d!",
+			(int)converted, (int)meshCount, (int)model->Meshes.size());
+	}
+
+	if (config.WeldDistance > 0.0f)
+	{
+		BBMOD_PROFILE_SCOPE("WeldVertices");
+		SStopwatch stopwatch;
+		size_t welded = WeldVertices(model, config.WeldDistance, config.WeldAngle, config.WeldUVDistance, jobSystem);
+		// Snapping positions together can collapse small triangles
+		size_t removed = RemoveDegenerates(model, jobSystem);
+		report.AddTiming("weldVertices", stopwatch.GetMilliseconds());
+		PRINT_SUCCESS("Welded %d vertices and removed %d collapsed triangles!", (int)welded, (int)removed);
+	}
+
+	if (model->VertexFormat->Bones && (config.SplitInfluences || config.WeightThreshold > 0.0f))
+	{
+		BBMOD_PROFILE_SCOPE("SplitInfluences");
+		SStopwatch stopwatch;
+		size_t pruned = PruneBoneWeights(model, config.WeightThreshold);
+		size_t added = config.SplitInfluences ? SplitByBoneInfluences(model) : 0;
+		report.AddTiming("splitInfluences", stopwatch.GetMilliseconds());
+		PRINT_SUCCESS("Removed %d bone weights and added %d meshes with fewer bone influences!",
+			(int)pruned, (int)added);
+	}
+
+	std::vector<SInstance> instances;
+
+	if (config.DetectInstances)
+	{
+		if (model->VertexFormat->Bones)
+		{
+			PRINT_WARNING("Models with bones cannot be instanced, instance detection is ignored!");
+		}
+		else
+		{
+			BBMOD_PROFILE_SCOPE("DetectInstances");
+			SStopwatch stopwatch;
+			size_t removed = FindInstances(model, instances);
+			report.AddTiming("detectInstances", stopwatch.GetMilliseconds());
+
+			std::string fname = GetFilename(fout, "instances", ".bbinst");
+			if (!SaveInstances(fname, instances))
+			{
+				PRINT_ERROR("Could not save instances to \"%s\"!", fname.c_str());
+				return BBMOD_ERR_SAVE_FAILED;
+			}
+			PRINT_SUCCESS("Removed %d instanced meshes, %d instances saved to \"%s\"!",
+				(int)removed, (int)instances.size(), fname.c_str());
+		}
+	}
+
+	std::vector<SCell> cells;
+
+	if (config.CellSize > 0.0f)
+	{
+		if (config.DetectInstances)
+		{
+			PRINT_WARNING("Models cannot be baked into cells with instance detection enabled, cell size is ignored!");
+		}
+		else if (model->VertexFormat->Bones)
+		{
+			PRINT_WARNING("Models with bones cannot be baked into cells, cell size is ignored!");
+		}
+		else
+		{
+			BBMOD_PROFILE_SCOPE("BakeCells");
+			SStopwatch stopwatch;
+			BakeCells(model, config.CellSize, cells);
+			report.AddTiming("bakeCells", stopwatch.GetMilliseconds());
+
+			std::string fname = GetFilename(fout, "cells", ".bbcell");
+			if (!SaveCells(fname, config.CellSize, cells))
+			{
+				PRINT_ERROR("Could not save cells to \"%s\"!", fname.c_str());
+				return BBMOD_ERR_SAVE_FAILED;
+			}
+			PRINT_SUCCESS("%d cells saved to \"%s\"!", (int)cells.size(), fname.c_str());
+		}
+	}
+
+	if (config.HullCount > 0)
+	{
+		BBMOD_PROFILE_SCOPE("DecomposeConvex");
+		SStopwatch stopwatch;
+		std::vector<SHull> hulls;
+		size_t removed = DecomposeConvex(model, config.HullCount, config.HullVertexCount, hulls);
+		report.AddTiming("decomposeConvex", stopwatch.GetMilliseconds());
+
+		std::string fname = GetFilename(fout, "hulls", ".bbhull");
+		if (!SaveHulls(fname, hulls))
+		{
+			PRINT_ERROR("Could not save convex hulls to \"%s\"!", fname.c_str());
+			return BBMOD_ERR_SAVE_FAILED;
+		}
+		if (removed > 0)
+		{
+			PRINT_SUCCESS("Removed %d collision meshes!", (int)removed);
+		}
+		PRINT_SUCCESS("%d convex hulls saved to \"%s\"!", (int)hulls.size(), fname.c_str());
+	}
+
+	if (config.OptimizeOverdraw)
+	{
+		BBMOD_PROFILE_SCOPE("OptimizeOverdraw");
+		SStopwatch stopwatch;
+		report.OverdrawBefore = AnalyzeOverdraw(model);
+		OptimizeOverdraw(model);
+		report.OverdrawAfter = AnalyzeOverdraw(model);
+		report.AddTiming("optimizeOverdraw", stopwatch.GetMilliseconds());
+		PRINT_SUCCESS("Overdraw reduced from %.3f to %.3f!", report.OverdrawBefore, report.OverdrawAfter);
+	}
+
+	if (config.BuildBVH)
+	{
+		BBMOD_PROFILE_SCOPE("BuildBVH");
+		SStopwatch stopwatch;
+		model->BVH = SBVH::FromModel(model);
+		report.AddTiming("buildBVH", stopwatch.GetMilliseconds());
+	}
+
+	if (config.AORayCount > 0)
+	{
+		BBMOD_PROFILE_SCOPE("BakeAO");
+		SStopwatch stopwatch;
+		if (!BakeAmbientOcclusion(model, config.AORayCount, config.AODistance, config.BentNormals, jobSystem))
+		{
+			PRINT_WARNING("Models with bones cannot have ambient occlusion baked, AO ray count is ignored!");
+		}
+		report.AddTiming("bakeAO", stopwatch.GetMilliseconds());
+	}
+
+	if (config.ShadowProxies)
+	{
+		BBMOD_PROFILE_SCOPE("BuildShadowProxies");
+		SStopwatch stopwatch;
+		std::vector<SShadowProxy> proxies;
+		if (!BuildShadowProxies(model, config.ShadowGridSize, proxies))
+		{
+			PRINT_WARNING("Models with bones cannot have shadow proxies, shadow proxies are ignored!");
+		}
+		else
+		{
+			report.AddTiming("buildShadowProxies", stopwatch.GetMilliseconds());
+
+			std::string fname = GetFilename(fout, "shadow", ".bbshdw");
+			if (!SaveShadowProxies(fname, proxies))
+			{
+				PRINT_ERROR("Could not save shadow proxies to \"%s\"!", fname.c_str());
+				return BBMOD_ERR_SAVE_FAILED;
+			}
+			PRINT_SUCCESS("%d shadow proxies saved to \"%s\"!", (int)proxies.size(), fname.c_str());
+		}
+	}
+
+	if (config.BatchSize > 0)
 	{
-		PRINT_ERROR("Could not save the model to \"%s\"!", fout);
-		return BBMOD_ERR_SAVE_FAILED;
+		size_t batchSize = config.BatchSize;
+		if (batchSize > BBMOD_MAX_BATCH_SIZE)
+		{
+			PRINT_WARNING("Batch size %d is over the maximum of %d supported by shader BBMOD_ShDefaultBatched!",
+				(int)batchSize, (int)BBMOD_MAX_BATCH_SIZE);
+			batchSize = BBMOD_MAX_BATCH_SIZE;
+		}
+
+		if (!model->MakeBatched(batchSize))
+		{
+			PRINT_WARNING("Models with bones cannot be batched, batch size is ignored!");
+		}
 	}
 
+	if (config.TriangleStrips)
+	{
+		if (model->BatchSize > 0)
+		{
+			PRINT_WARNING("Batched models cannot be saved as triangle strips, triangle strips are ignored!");
+		}
+		else
+		{
+			BBMOD_PROFILE_SCOPE("Stripify");
+			SStopwatch stopwatch;
+			// Strips must not undo the order of clusters sorted for less
+			// overdraw, so they only join triangles close to each other
+			size_t window = config.OptimizeOverdraw ? BBMOD_OVERDRAW_CLUSTER_SIZE : 0;
+			size_t converted = Stripify(model, window);
+			report.AddTiming("stripify", stopwatch.GetMilliseconds());
+			PRINT_SUCCESS("%d of %d meshes saved as triangle strips!",
+				(int)converted, (int)model->Meshes.size());
+
+			if (config.OptimizeOverdraw && converted > 0)
+			{
+				// Describe the saved meshes
+				report.OverdrawAfter = AnalyzeOverdraw(model);
+				PRINT_SUCCESS("Overdraw with triangle strips is %.3f!", report.OverdrawAfter);
+			}
+		}
+	}
+
+	{
+		BBMOD_PROFILE_SCOPE("SaveModel");
+		SStopwatch stopwatch;
+		if (!model->Save(fout))
+		{
+			PRINT_ERROR("Could not save the model to \"%s\"!", fout);
+			return BBMOD_ERR_SAVE_FAILED;
+		}
+		report.AddTiming("saveModel", stopwatch.GetMilliseconds());
+	}
+
+	report.Model = model;
+	CollectWarnings(report, scene, model, config);
+
 	PRINT_SUCCESS("Model saved to \"%s\"!", fout);
 
-	log << "Vertex format:" << std::endl;
-	log << "==============" << std::endl;
+	log << "Vertex format of all meshes:" << std::endl;
+	log << "============================" << std::endl;
 	SVertexFormat* vformat = model->VertexFormat;
 	if (vformat->Vertices) { log << "Position 3D" << std::endl; }
 	if (vformat->Normals) { log << "Normal" << std::endl; }
 	if (vformat->TextureCoords) { log << "Texture coords" << std::endl; }
 	if (vformat->Colors) { log << "Color" << std::endl; }
 	if (vformat->TangentW) { log << "Tangent & bitangent sign" << std::endl; }
-	if (vformat->Bones) { log << "Bone indices and weights" << std::endl; }
+	if (vformat->Bones) { log << "Bone indices and weights (up to " << (int)vformat->BoneInfluences << " per vertex)" << std::endl; }
 	if (vformat->Ids) { log << "Ids" << std::endl; }
 	log << std::endl;
 
@@ -170,7 +510,7 @@ int ConvertToBBMOD(const char* fin, const char* fout, const SConfig& config)
 			" You will need to increase this limit in order to render this model, though be aware that the maximum"
 			" number of vertex shader uniforms is determined by the target platform! Setting it higher than 64 can"
 			" make your game incompatible with some devices!"
-			, model->BoneCount);
+			, (int)model->BoneCount);
 
 		log << "WARNING:" << std::endl
 			<< "========" << std::endl
@@ -180,6 +520,22 @@ int ConvertToBBMOD(const char* fin, const char* fout, const SConfig& config)
 			<< "make your game incompatible with some devices!" << std::endl << std::endl;
 	}
 
+	if (!instances.empty())
+	{
+		log << "Instances:" << std::endl;
+		log << "==========" << std::endl;
+		std::vector<size_t> instanceCounts(model->Meshes.size(), 0);
+		for (const SInstance& instance : instances)
+		{
+			++instanceCounts[instance.Mesh];
+		}
+		for (size_t i = 0; i < instanceCounts.size(); ++i)
+		{
+			log << "Mesh " << i << ": " << instanceCounts[i] << std::endl;
+		}
+		log << std::endl;
+	}
+
 	log << "Materials:" << std::endl;
 	log << "==========" << std::endl;
 	for (size_t i = 0; i < model->MaterialNames.size(); ++i)
@@ -189,6 +545,9 @@ int ConvertToBBMOD(const char* fin, const char* fout, const SConfig& config)
 	log << std::endl;
 
 	// Write animations
+	double convertAnimationsTime = 0.0;
+	double saveAnimationsTime = 0.0;
+
 	if (!config.DisableBones)
 	{
 		uint32_t numOfAnimations = scene->mNumAnimations;
@@ -197,8 +556,14 @@ int ConvertToBBMOD(const char* fin, const char* fout, const SConfig& config)
 		{
 			for (uint32_t i = 0; i < numOfAnimations; ++i)
 			{
-				SAnimation* animation = SAnimation::FromAssimp(scene->mAnimations[i], model, config);
-		
+				SAnimation* animation;
+				{
+					BBMOD_PROFILE_SCOPE("ConvertAnimation");
+					SStopwatch stopwatch;
+					animation = SAnimation::FromAssimp(scene->mAnimations[i], model, config);
+					convertAnimationsTime += stopwatch.GetMilliseconds();
+				}
+
 				if (!animation)
 				{
 					PRINT_ERROR("Failed to convert an animation to BBANIM!");
@@ -207,13 +572,23 @@ int ConvertToBBMOD(const char* fin, const char* fout, const SConfig& config)
 
 				std::string fname = GetAnimationFilename(animation, i, fout);
 	
-				if (!animation->Save(fname))
 				{
-					PRINT_ERROR("Could not save an animation to \"%s\"!", fname.c_str());
-					return BBMOD_ERR_SAVE_FAILED;
+					BBMOD_PROFILE_SCOPE("SaveAnimation");
+					SStopwatch stopwatch;
+					if (!animation->Save(fname))
+					{
+						PRINT_ERROR("Could not save an animation to \"%s\"!", fname.c_str());
+						return BBMOD_ERR_SAVE_FAILED;
+					}
+					saveAnimationsTime += stopwatch.GetMilliseconds();
 				}
 
 				PRINT_SUCCESS("Animation saved to \"%s\"!", fname.c_str());
+
+				SReportAnimation reportAnimation;
+				reportAnimation.Animation = animation;
+				reportAnimation.Path = fname;
+				report.Animations.push_back(reportAnimation);
 			}
 		}
 	}
@@ -221,5 +596,15 @@ int ConvertToBBMOD(const char* fin, const char* fout, const SConfig& config)
 	log.flush();
 	log.close();
 
+	report.AddTiming("convertAnimations", convertAnimationsTime);
+	report.AddTiming("saveAnimations", saveAnimationsTime);
+	report.AddTiming("total", stopwatchTotal.GetMilliseconds());
+
+	std::string reportPath = GetFilename(fout, "report", ".json");
+	if (!report.Save(reportPath))
+	{
+		PRINT_WARNING("Could not save conversion report to \"%s\"!", reportPath.c_str());
+	}
+
 	return BBMOD_SUCCESS;
 }
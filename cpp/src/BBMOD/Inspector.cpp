@@ -0,0 +1,634 @@
+#include <BBMOD/Inspector.hpp>
+#include <terminal.hpp>
+
+#include <algorithm>
+#include <cmath>
+#include <filesystem>
+#include <stack>
+#include <unordered_set>
+
+/** Maximum number of bones supported by the default animated shader. */
+#define BBMOD_INSPECT_MAX_BONES 64
+
+/** Tolerance used when checking whether an animation track is constant. */
+#define BBMOD_INSPECT_EPSILON 0.00001f
+
+static void AddFinding(std::vector<SFinding>& findings, std::string message, std::string recommendation)
+{
+	SFinding finding;
+	finding.Message = message;
+	finding.Recommendation = recommendation;
+	findings.push_back(finding);
+}
+
+static double GetPercent(size_t part, size_t total)
+{
+	return (total > 0) ? (100.0 * (double)part / (double)total) : 0.0;
+}
+
+template<typename T>
+static void AppendBytes(std::string& key, const T& value)
+{
+	key.append(reinterpret_cast<const char*>(&value), sizeof(value));
+}
+
+/** Creates a string containing all vertex data saved by given vertex format. */
+static std::string GetVertexKey(const SVertex* vertex, const SVertexFormat* vformat)
+{
+	std::string key;
+
+	if (vformat->Vertices)
+	{
+		AppendBytes(key, vertex->Position);
+	}
+
+	if (vformat->Normals)
+	{
+		AppendBytes(key, vertex->Normal);
+	}
+
+	if (vformat->TextureCoords)
+	{
+		AppendBytes(key, vertex->Texture);
+	}
+
+	if (vformat->Colors)
+	{
+		AppendBytes(key, vertex->Color);
+	}
+
+	if (vformat->TangentW)
+	{
+		AppendBytes(key, vertex->Tangent);
+		AppendBytes(key, vertex->BitangentSign);
+	}
+
+	if (vformat->Bones)
+	{
+		AppendBytes(key, vertex->Bones);
+		AppendBytes(key, vertex->Weights);
+	}
+
+	if (vformat->Ids)
+	{
+		AppendBytes(key, vertex->Id);
+	}
+
+	return key;
+}
+
+static bool IsZero(const float* v, size_t size)
+{
+	for (size_t i = 0; i < size; ++i)
+	{
+		if (v[i] != 0.0f)
+		{
+			return false;
+		}
+	}
+	return true;
+}
+
+static bool IsEqual(const float* v1, const float* v2, size_t size)
+{
+	for (size_t i = 0; i < size; ++i)
+	{
+		if (std::fabs(v1[i] - v2[i]) > BBMOD_INSPECT_EPSILON)
+		{
+			return false;
+		}
+	}
+	return true;
+}
+
+static void FindNodes(SNode* node, std::vector<SNode*>& nodes)
+{
+	nodes.push_back(node);
+	for (SNode* child : node->Children)
+	{
+		FindNodes(child, nodes);
+	}
+}
+
+static void InspectVertexData(SModel* model, std::vector<SFinding>& findings)
+{
+	// Each attribute is counted only in vertices of meshes which have it
+	size_t normalCount = 0;
+	size_t textureCount = 0;
+	size_t colorCount = 0;
+	size_t tangentCount = 0;
+	size_t boneCount = 0;
+	size_t boneSize = 0;
+	size_t extraInfluences = 0;
+	size_t zeroNormals = 0;
+	size_t zeroTangents = 0;
+	size_t zeroWeights = 0;
+	bool uniformTextureCoords = true;
+	bool uniformColors = true;
+	bool tangentsWithoutTextureCoords = false;
+	const SVertex* firstTexture = nullptr;
+	const SVertex* firstColor = nullptr;
+
+	for (SMesh* mesh : model->Meshes)
+	{
+		const SVertexFormat* vformat = mesh->VertexFormat;
+
+		if (vformat->TangentW && !vformat->TextureCoords && !mesh->Data.empty())
+		{
+			tangentsWithoutTextureCoords = true;
+		}
+
+		for (SVertex* vertex : mesh->Data)
+		{
+			if (vformat->Normals)
+			{
+				++normalCount;
+				if (IsZero(vertex->Normal, 3))
+				{
+					++zeroNormals;
+				}
+			}
+
+			if (vformat->TextureCoords)
+			{
+				++textureCount;
+				if (!firstTexture)
+				{
+					firstTexture = vertex;
+				}
+				else if (!IsEqual(vertex->Texture, firstTexture->Texture, 2))
+				{
+					uniformTextureCoords = false;
+				}
+			}
+
+			if (vformat->Colors)
+			{
+				++colorCount;
+				if (!firstColor)
+				{
+					firstColor = vertex;
+				}
+				else if (vertex->Color != firstColor->Color)
+				{
+					uniformColors = false;
+				}
+			}
+
+			if (vformat->TangentW)
+			{
+				++tangentCount;
+				if (IsZero(vertex->Tangent, 3))
+				{
+					++zeroTangents;
+				}
+			}
+
+			if (vformat->Bones)
+			{
+				++boneCount;
+				boneSize += vformat->GetBoneSize();
+				if (IsZero(vertex->Weights, 4))
+				{
+					++zeroWeights;
+				}
+
+				// Vertices which would fit a smaller class of influences
+				size_t influences = 0;
+				for (size_t i = 0; i < 4; ++i)
+				{
+					influences += (vertex->Weights[i] != 0.0f) ? 1 : 0;
+				}
+				if (influences <= (size_t)vformat->BoneInfluences / 2)
+				{
+					++extraInfluences;
+				}
+			}
+		}
+	}
+
+	if (colorCount > 0 && uniformColors)
+	{
+		bool white = (firstColor->Color == 0xFFFFFFFF);
+		AddFinding(findings,
+			std::string("All vertices have the same ") + (white ? "white " : "") + "color, wasting "
+				+ std::to_string(sizeof(uint32_t) * colorCount) + " B.",
+			"Convert with -dc=true and set the color through a material instead.");
+	}
+
+	if (textureCount > 0 && uniformTextureCoords)
+	{
+		AddFinding(findings,
+			"All vertices have the same texture coordinates, wasting "
+				+ std::to_string(sizeof(float) * 2 * textureCount) + " B.",
+			"Convert with -duv=true.");
+	}
+
+	if (zeroNormals > 0)
+	{
+		AddFinding(findings,
+			std::to_string(zeroNormals) + " of " + std::to_string(normalCount)
+				+ " vertices have zero normal vectors.",
+			"Convert with -gn=1 or -gn=2 to generate normals, or with -dn=true"
+				" if the model is not lit.");
+	}
+
+	if (tangentCount > 0 && zeroTangents == tangentCount)
+	{
+		AddFinding(findings,
+			"All vertices have zero tangent vectors, wasting "
+				+ std::to_string(sizeof(float) * 4 * tangentCount) + " B.",
+			"Convert with -dt=true.");
+	}
+	else if (tangentsWithoutTextureCoords)
+	{
+		AddFinding(findings,
+			"Tangent vectors are saved without texture coordinates, so they"
+				" cannot be used for normal mapping.",
+			"Convert with -dt=true.");
+	}
+
+	if (boneCount > 0 && (model->BoneCount == 0 || zeroWeights == boneCount))
+	{
+		AddFinding(findings,
+			"Vertices have bone indices and weights, but the model is not skinned, wasting "
+				+ std::to_string(boneSize) + " B.",
+			"Convert with -db=true.");
+	}
+	else if (extraInfluences > boneCount / 2)
+	{
+		AddFinding(findings,
+			std::to_string(extraInfluences) + " of " + std::to_string(boneCount)
+				+ " skinned vertices are influenced by fewer bones than their mesh stores.",
+			"Convert with -si=true to split meshes by the number of bone influences.");
+	}
+
+	if (model->BoneCount > BBMOD_INSPECT_MAX_BONES)
+	{
+		AddFinding(findings,
+			"The model has " + std::to_string(model->BoneCount) + " bones, but the default"
+				" animated shader supports only " + std::to_string(BBMOD_INSPECT_MAX_BONES) + ".",
+			"Reduce the number of bones in the modelling software or increase MAX_BONES"
+				" in the animated shader.");
+	}
+}
+
+void InspectModel(SModel* model, std::string path, std::vector<SFinding>& findings)
+{
+	SVertexFormat* vformat = model->VertexFormat;
+	size_t vertexSize = vformat->GetVertexSize();
+
+	printf("\nModel \"%s\"\n\n", path.c_str());
+
+	printf("Vertex format of all meshes:%s%s%s%s%s%s%s (up to %d B per vertex)\n",
+		vformat->Vertices ? " position" : "",
+		vformat->Normals ? " normal" : "",
+		vformat->TextureCoords ? " uv" : "",
+		vformat->Colors ? " color" : "",
+		vformat->TangentW ? " tangentw" : "",
+		vformat->Bones ? " bones" : "",
+		vformat->Ids ? " ids" : "",
+		(int)vertexSize);
+
+	// Sections
+	SModelSections sections = model->GetSections();
+	size_t total = sections.GetTotal();
+
+	printf("\n%-20s %12s %8s\n", "Section", "Size [B]", "%");
+	printf("%s\n", std::string(42, '-').c_str());
+	printf("%-20s %12d %8.1f\n", "Header", (int)sections.Header, GetPercent(sections.Header, total));
+	printf("%-20s %12d %8.1f\n", "Vertex format", (int)sections.VertexFormat, GetPercent(sections.VertexFormat, total));
+	printf("%-20s %12d %8.1f\n", "Meshes", (int)sections.Meshes, GetPercent(sections.Meshes, total));
+	printf("%-20s %12d %8.1f\n", "Inverse transform", (int)sections.InverseTransform, GetPercent(sections.InverseTransform, total));
+	printf("%-20s %12d %8.1f\n", "Nodes", (int)sections.Nodes, GetPercent(sections.Nodes, total));
+	printf("%-20s %12d %8.1f\n", "Bones", (int)sections.Bones, GetPercent(sections.Bones, total));
+	printf("%-20s %12d %8.1f\n", "Materials", (int)sections.Materials, GetPercent(sections.Materials, total));
+	printf("%-20s %12d %8.1f\n", "BVH", (int)sections.BVH, GetPercent(sections.BVH, total));
+	printf("%s\n", std::string(42, '-').c_str());
+	printf("%-20s %12d\n", "Total", (int)total);
+
+	// Meshes
+	size_t vertexCountTotal = 0;
+	size_t triangleCountTotal = 0;
+	size_t uniqueCountTotal = 0;
+	size_t stripCount = 0;
+	std::vector<size_t> meshesPerMaterial(model->MaterialNames.size(), 0);
+
+	printf("\n%-6s %-24s %8s %10s %10s %12s %10s %8s\n",
+		"Mesh", "Material", "Stride", "Vertices", "Triangles", "Size [B]", "Unique", "Dup %");
+	printf("%s\n", std::string(95, '-').c_str());
+
+	for (size_t i = 0; i < model->Meshes.size(); ++i)
+	{
+		SMesh* mesh = model->Meshes[i];
+		size_t vertexCount = mesh->Data.size();
+
+		std::unordered_set<std::string> unique;
+		for (SVertex* vertex : mesh->Data)
+		{
+			unique.insert(GetVertexKey(vertex, mesh->VertexFormat));
+		}
+
+		vertexCountTotal += vertexCount;
+		triangleCountTotal += mesh->GetTriangleCount();
+		uniqueCountTotal += unique.size();
+
+		if (mesh->PrimitiveType == BBMOD_PRIMITIVE_TRIANGLE_STRIP)
+		{
+			++stripCount;
+		}
+
+		std::string materialName = (mesh->MaterialIndex < model->MaterialNames.size())
+			? model->MaterialNames[mesh->MaterialIndex]
+			: "?";
+
+		if (mesh->MaterialIndex < meshesPerMaterial.size())
+		{
+			++meshesPerMaterial[mesh->MaterialIndex];
+		}
+
+		printf("%-6d %-24s %8d %10d %10d %12d %10d %8.1f\n",
+			(int)i,
+			materialName.substr(0, 24).c_str(),
+			(int)mesh->VertexFormat->GetVertexSize(),
+			(int)vertexCount,
+			(int)mesh->GetTriangleCount(),
+			(int)mesh->GetSize(),
+			(int)unique.size(),
+			GetPercent(vertexCount - unique.size(), vertexCount));
+	}
+
+	printf("%s\n", std::string(95, '-').c_str());
+	printf("%-40s %10d %10d %12d %10d %8.1f\n",
+		"Total",
+		(int)vertexCountTotal,
+		(int)triangleCountTotal,
+		(int)sections.Meshes,
+		(int)uniqueCountTotal,
+		GetPercent(vertexCountTotal - uniqueCountTotal, vertexCountTotal));
+
+	if (vertexCountTotal > 0 && uniqueCountTotal * 2 < vertexCountTotal && stripCount == 0)
+	{
+		AddFinding(findings,
+			"Only " + std::to_string(uniqueCountTotal) + " of " + std::to_string(vertexCountTotal)
+				+ " vertices are unique, because meshes are stored as non-indexed triangle lists.",
+			"Convert the model with --triangle-strips to share vertices between neighbouring"
+				" triangles and disable unused vertex attributes to reduce the size of each duplicate.");
+	}
+
+	// Nodes
+	std::vector<SNode*> nodes;
+	FindNodes(model->RootNode, nodes);
+
+	size_t emptyNodes = 0;
+	for (SNode* node : nodes)
+	{
+		if (!node->IsBone && node->Meshes.empty() && node != model->RootNode)
+		{
+			++emptyNodes;
+		}
+	}
+
+	printf("\nNodes: %d (%d without bones and meshes), bones: %d, materials: %d\n",
+		(int)nodes.size(), (int)emptyNodes, (int)model->BoneCount, (int)model->MaterialNames.size());
+
+	if (emptyNodes > 0 && emptyNodes * 4 >= nodes.size())
+	{
+		AddFinding(findings,
+			std::to_string(emptyNodes) + " of " + std::to_string(nodes.size())
+				+ " nodes have no meshes and are not bones, but they are still visited"
+				" each frame by animate and render.",
+			"Convert with -on=true, unless the nodes are used as attachment points.");
+	}
+
+	for (size_t i = 0; i < meshesPerMaterial.size(); ++i)
+	{
+		if (meshesPerMaterial[i] == 0)
+		{
+			AddFinding(findings,
+				"Material \"" + model->MaterialNames[i] + "\" is not used by any mesh.",
+				"Convert with -oma=true.");
+		}
+		else if (meshesPerMaterial[i] > 1)
+		{
+			AddFinding(findings,
+				std::to_string(meshesPerMaterial[i]) + " meshes use material \""
+					+ model->MaterialNames[i] + "\", each one costing a separate draw call.",
+				"Convert with -ome=true.");
+		}
+	}
+
+	// Rendering cost, traversing the nodes the same way as bbmod_node_render
+	size_t drawCalls = 0;
+	size_t materialSwitches = 0;
+	size_t materialLast = SIZE_MAX;
+	std::stack<SNode*> stack;
+	stack.push(model->RootNode);
+
+	while (!stack.empty())
+	{
+		SNode* node = stack.top();
+		stack.pop();
+
+		for (size_t meshIndex : node->Meshes)
+		{
+			size_t materialIndex = model->Meshes[meshIndex]->MaterialIndex;
+			if (materialIndex != materialLast)
+			{
+				++materialSwitches;
+				materialLast = materialIndex;
+			}
+			++drawCalls;
+		}
+
+		for (SNode* child : node->Children)
+		{
+			stack.push(child);
+		}
+	}
+
+	printf("Draw calls per render: %d, material switches: %d\n",
+		(int)drawCalls, (int)materialSwitches);
+
+	InspectVertexData(model, findings);
+}
+
+void InspectAnimation(SAnimation* animation, SModel* model, std::string path, std::vector<SFinding>& findings)
+{
+	std::string name = std::filesystem::path(path).stem().string();
+	double seconds = (animation->TicsPerSecond > 0.0)
+		? (animation->Duration / animation->TicsPerSecond)
+		: 0.0;
+
+	printf("\nAnimation \"%s\"\n\n", path.c_str());
+	printf("Duration: %.2f tics, %.2f tics per second, %.3f s, size: %d B\n",
+		animation->Duration, animation->TicsPerSecond, seconds, (int)animation->GetSize());
+
+	if (model && model->NodeCount != animation->ModelNodeCount)
+	{
+		AddFinding(findings,
+			"Animation \"" + name + "\" was made for a model with "
+				+ std::to_string(animation->ModelNodeCount) + " nodes, but the model has "
+				+ std::to_string(model->NodeCount) + ".",
+			"Convert the animation from the same file as the model, using the same options.");
+		model = nullptr;
+	}
+
+	// Nodes by their indices
+	std::vector<SNode*> nodes;
+	if (model)
+	{
+		std::vector<SNode*> nodesFound;
+		FindNodes(model->RootNode, nodesFound);
+		nodes.resize(model->NodeCount, nullptr);
+		for (SNode* node : nodesFound)
+		{
+			if ((size_t)node->Index < nodes.size())
+			{
+				nodes[(size_t)node->Index] = node;
+			}
+		}
+	}
+
+	printf("\n%-6s %-24s %10s %10s %10s %10s %9s\n",
+		"Node", "Name", "Pos keys", "Pos/s", "Rot keys", "Rot/s", "Constant");
+	printf("%s\n", std::string(85, '-').c_str());
+
+	size_t trackCount = 0;
+	size_t constantPositions = 0;
+	size_t constantRotations = 0;
+	size_t constantBytes = 0;
+	double keySteps = 0.0;
+	double keysPerSecondMax = 0.0;
+
+	for (size_t i = 0; i < animation->AnimationNodes.size(); ++i)
+	{
+		SAnimationNode* animationNode = animation->AnimationNodes[i];
+		if (!animationNode)
+		{
+			continue;
+		}
+
+		++trackCount;
+
+		size_t positionKeyCount = animationNode->PositionKeys.size();
+		size_t rotationKeyCount = animationNode->RotationKeys.size();
+		double positionKeysPerSecond = (seconds > 0.0) ? (positionKeyCount / seconds) : 0.0;
+		double rotationKeysPerSecond = (seconds > 0.0) ? (rotationKeyCount / seconds) : 0.0;
+
+		keysPerSecondMax = std::max(keysPerSecondMax, std::max(positionKeysPerSecond, rotationKeysPerSecond));
+
+		// animate continues searching from the last found key, so it steps
+		// over all keys passed since the last frame plus the next one
+		keySteps += 2.0 + (positionKeysPerSecond + rotationKeysPerSecond) / BBMOD_INSPECT_FPS;
+
+		bool positionConstant = (positionKeyCount > 1);
+		for (SPositionKey* key : animationNode->PositionKeys)
+		{
+			if (!IsEqual(key->Position, animationNode->PositionKeys[0]->Position, 3))
+			{
+				positionConstant = false;
+				break;
+			}
+		}
+
+		bool rotationConstant = (rotationKeyCount > 1);
+		for (SRotationKey* key : animationNode->RotationKeys)
+		{
+			if (!IsEqual(key->Rotation, animationNode->RotationKeys[0]->Rotation, 4))
+			{
+				rotationConstant = false;
+				break;
+			}
+		}
+
+		if (positionConstant)
+		{
+			++constantPositions;
+			constantBytes += (positionKeyCount - 1) * (sizeof(double) + sizeof(float) * 3);
+		}
+
+		if (rotationConstant)
+		{
+			++constantRotations;
+			constantBytes += (rotationKeyCount - 1) * (sizeof(double) + sizeof(float) * 4);
+		}
+
+		std::string nodeName = (i < nodes.size() && nodes[i]) ? nodes[i]->Name : "";
+
+		printf("%-6d %-24s %10d %10.1f %10d %10.1f %9s\n",
+			(int)i,
+			nodeName.substr(0, 24).c_str(),
+			(int)positionKeyCount,
+			positionKeysPerSecond,
+			(int)rotationKeyCount,
+			rotationKeysPerSecond,
+			(positionConstant && rotationConstant) ? "pos, rot"
+				: (positionConstant ? "pos" : (rotationConstant ? "rot" : "")));
+	}
+
+	printf("%s\n", std::string(85, '-').c_str());
+
+	// Estimated cost of BBMOD_AnimationPlayer.animate
+	size_t nodeCount = animation->ModelNodeCount;
+	size_t boneCount = model ? model->BoneCount : trackCount;
+
+	// Each visited node is multiplied with its parent and with the inverse
+	// transform, each bone also with its offset matrix
+	size_t matrixMultiplies = nodeCount * 2 + boneCount;
+
+	printf("\nEstimated cost of animate per frame at %.0f FPS%s:\n",
+		BBMOD_INSPECT_FPS, model ? "" : " (bone count estimated from tracks)");
+	printf("  Nodes visited:       %d\n", (int)nodeCount);
+	printf("  Animated nodes:      %d\n", (int)trackCount);
+	printf("  Key search steps:    %.0f\n", keySteps);
+	printf("  Lerps + slerps:      %d\n", (int)(trackCount * 2));
+	printf("  Matrix multiplies:   %d\n", (int)matrixMultiplies);
+	printf("  Matrix copies:       %d\n", (int)(nodeCount + boneCount));
+
+	if (constantPositions + constantRotations > 0)
+	{
+		AddFinding(findings,
+			"Animation \"" + name + "\" has " + std::to_string(constantPositions)
+				+ " constant position and " + std::to_string(constantRotations)
+				+ " constant rotation tracks, wasting " + std::to_string(constantBytes)
+				+ " B and key searches each frame.",
+			"No converter option removes constant keys yet. Enable key reduction when"
+				" exporting from the modelling software.");
+	}
+
+	if (keysPerSecondMax > BBMOD_INSPECT_FPS)
+	{
+		AddFinding(findings,
+			"Animation \"" + name + "\" has up to " + std::to_string((int)keysPerSecondMax)
+				+ " keys per second, more than the "
+				+ std::to_string((int)BBMOD_INSPECT_FPS) + " frames that can be displayed.",
+			"No converter option resamples animations yet. Bake the animation with"
+				" a lower sample rate in the modelling software.");
+	}
+
+	if (model && trackCount > 0 && nodeCount > trackCount * 2)
+	{
+		AddFinding(findings,
+			"Animation \"" + name + "\" animates only " + std::to_string(trackCount)
+				+ " of " + std::to_string(nodeCount) + " nodes, but animate visits all of them.",
+			"Convert with -on=true to join nodes that are not animated.");
+	}
+}
+
+void PrintFindings(const std::vector<SFinding>& findings)
+{
+	printf("\n");
+
+	if (findings.empty())
+	{
+		PRINT_SUCCESS("No problems found!");
+		return;
+	}
+
+	for (const SFinding& finding : findings)
+	{
+		PRINT_WARNING("%s", finding.Message.c_str());
+		printf("           -> %s\n", finding.Recommendation.c_str());
+	}
+}
@@ -0,0 +1,391 @@
+#include <BBMOD/Instancing.hpp>
+#include <utils.hpp>
+
+#include <cmath>
+#include <cstdint>
+#include <fstream>
+#include <unordered_map>
+
+/** Hashes bytes using FNV-1a. */
+static inline void HashBytes(uint64_t& hash, const void* data, size_t size)
+{
+	const unsigned char* bytes = (const unsigned char*)data;
+	for (size_t i = 0; i < size; ++i)
+	{
+		hash ^= bytes[i];
+		hash *= 1099511628211ull;
+	}
+}
+
+/**
+ * Hashes the material and vertex data which does not change when the mesh
+ * is rotated or moved.
+ */
+static uint64_t HashMesh(const SMesh* mesh)
+{
+	const SVertexFormat* vertexFormat = mesh->VertexFormat;
+	uint64_t hash = 14695981039346656037ull;
+
+	HashBytes(hash, &mesh->MaterialIndex, sizeof(mesh->MaterialIndex));
+	uint32_t vertexFormatMask = vertexFormat->GetMask();
+	HashBytes(hash, &vertexFormatMask, sizeof(vertexFormatMask));
+	size_t vertexCount = mesh->Data.size();
+	HashBytes(hash, &vertexCount, sizeof(vertexCount));
+
+	for (const SVertex* vertex : mesh->Data)
+	{
+		if (vertexFormat->TextureCoords)
+		{
+			HashBytes(hash, vertex->Texture, sizeof(vertex->Texture));
+		}
+
+		if (vertexFormat->Colors)
+		{
+			HashBytes(hash, &vertex->Color, sizeof(vertex->Color));
+		}
+
+		if (vertexFormat->TangentW)
+		{
+			HashBytes(hash, &vertex->BitangentSign, sizeof(vertex->BitangentSign));
+		}
+	}
+
+	return hash;
+}
+
+static inline float Distance(const float* a, const float* b)
+{
+	float x = a[0] - b[0];
+	float y = a[1] - b[1];
+	float z = a[2] - b[2];
+	return std::sqrt(x * x + y * y + z * z);
+}
+
+static inline void Cross(const float* a, const float* b, float* out)
+{
+	out[0] = a[1] * b[2] - a[2] * b[1];
+	out[1] = a[2] * b[0] - a[0] * b[2];
+	out[2] = a[0] * b[1] - a[1] * b[0];
+}
+
+/** Computes the center of vertex positions and the largest distance from it. */
+static float GetCenter(const SMesh* mesh, vec3_t center)
+{
+	center[0] = center[1] = center[2] = 0.0f;
+
+	for (const SVertex* vertex : mesh->Data)
+	{
+		center[0] += vertex->Position[0];
+		center[1] += vertex->Position[1];
+		center[2] += vertex->Position[2];
+	}
+
+	float count = (float)mesh->Data.size();
+	center[0] /= count;
+	center[1] /= count;
+	center[2] /= count;
+
+	float radius = 0.0f;
+	for (const SVertex* vertex : mesh->Data)
+	{
+		radius = std::max(radius, Distance(vertex->Position, center));
+	}
+	return radius;
+}
+
+/**
+ * Builds an orthonormal basis from positions of vertices a and b relative to
+ * the center, stored in rows of a matrix. Returns false if they are parallel.
+ */
+static bool GetBasis(const SMesh* mesh, const vec3_t center, size_t a, size_t b, matrix_t basis)
+{
+	const float* pa = mesh->Data[a]->Position;
+	const float* pb = mesh->Data[b]->Position;
+	vec3_t u = { pa[0] - center[0], pa[1] - center[1], pa[2] - center[2] };
+	vec3_t v = { pb[0] - center[0], pb[1] - center[1], pb[2] - center[2] };
+	vec3_t w;
+
+	Cross(u, v, w);
+	if (std::sqrt(w[0] * w[0] + w[1] * w[1] + w[2] * w[2]) < 1e-12f)
+	{
+		return false;
+	}
+
+	vec3_normalize(u);
+	vec3_normalize(w);
+	Cross(w, u, v);
+
+	matrix_t m = {
+		u[0], u[1], u[2], 0.0f,
+		v[0], v[1], v[2], 0.0f,
+		w[0], w[1], w[2], 0.0f,
+		0.0f, 0.0f, 0.0f, 1.0f };
+	matrix_copy(m, basis);
+	return true;
+}
+
+/**
+ * Finds a rotation and translation which transforms vertices of mesh a onto
+ * vertices of mesh b, compares all vertices and writes the transform into
+ * out if they match.
+ */
+static bool FindTransform(const SMesh* a, const SMesh* b, matrix_t out)
+{
+	if (a->MaterialIndex != b->MaterialIndex
+		|| *a->VertexFormat != *b->VertexFormat
+		|| a->Data.size() != b->Data.size()
+		|| a->Data.empty())
+	{
+		return false;
+	}
+
+	vec3_t centerA;
+	vec3_t centerB;
+	float radius = GetCenter(a, centerA);
+	float radiusB = GetCenter(b, centerB);
+	float epsilon = BBMOD_INSTANCE_EPSILON * std::max(radius, 1.0f);
+
+	if (std::abs(radius - radiusB) > epsilon)
+	{
+		return false;
+	}
+
+	// Build bases of both meshes from the furthest vertex and the vertex which
+	// spans the largest area with it
+	size_t first = 0;
+	for (size_t i = 1; i < a->Data.size(); ++i)
+	{
+		if (Distance(a->Data[i]->Position, centerA) > Distance(a->Data[first]->Position, centerA))
+		{
+			first = i;
+		}
+	}
+
+	const float* pf = a->Data[first]->Position;
+	vec3_t u = { pf[0] - centerA[0], pf[1] - centerA[1], pf[2] - centerA[2] };
+	size_t second = first;
+	float area = 0.0f;
+
+	for (size_t i = 0; i < a->Data.size(); ++i)
+	{
+		const float* p = a->Data[i]->Position;
+		vec3_t v = { p[0] - centerA[0], p[1] - centerA[1], p[2] - centerA[2] };
+		vec3_t w;
+		Cross(u, v, w);
+		float current = w[0] * w[0] + w[1] * w[1] + w[2] * w[2];
+		if (current > area)
+		{
+			area = current;
+			second = i;
+		}
+	}
+
+	matrix_t basisA;
+	matrix_t basisB;
+	if (!GetBasis(a, centerA, first, second, basisA)
+		|| !GetBasis(b, centerB, first, second, basisB))
+	{
+		return false;
+	}
+
+	// Rotation from basis A into basis B, followed by translation from center A
+	// to center B
+	matrix_t transform;
+	matrix_copy(basisA, transform);
+	matrix_transpose(transform);
+	matrix_multiply(transform, basisB);
+
+	vec3_t offset;
+	matrix_transform_vec3(transform, centerA, 1.0f, offset);
+	transform[12] = centerB[0] - offset[0];
+	transform[13] = centerB[1] - offset[1];
+	transform[14] = centerB[2] - offset[2];
+
+	const SVertexFormat* vertexFormat = a->VertexFormat;
+	vec3_t vec;
+
+	for (size_t i = 0; i < a->Data.size(); ++i)
+	{
+		const SVertex* va = a->Data[i];
+		const SVertex* vb = b->Data[i];
+
+		matrix_transform_vec3(transform, va->Position, 1.0f, vec);
+		if (Distance(vec, vb->Position) > epsilon)
+		{
+			return false;
+		}
+
+		if (vertexFormat->Normals)
+		{
+			matrix_transform_vec3(transform, va->Normal, 0.0f, vec);
+			if (Distance(vec, vb->Normal) > BBMOD_INSTANCE_NORMAL_EPSILON)
+			{
+				return false;
+			}
+		}
+
+		if (vertexFormat->TangentW)
+		{
+			matrix_transform_vec3(transform, va->Tangent, 0.0f, vec);
+			if (Distance(vec, vb->Tangent) > BBMOD_INSTANCE_NORMAL_EPSILON
+				|| va->BitangentSign != vb->BitangentSign)
+			{
+				return false;
+			}
+		}
+
+		if ((vertexFormat->TextureCoords
+				&& (va->Texture[0] != vb->Texture[0] || va->Texture[1] != vb->Texture[1]))
+			|| (vertexFormat->Colors && va->Color != vb->Color))
+		{
+			return false;
+		}
+	}
+
+	matrix_copy(transform, out);
+	return true;
+}
+
+/** Writes an instance for each mesh of a node and its children. */
+static void CollectInstances(
+	const SNode* node,
+	const matrix_t parentTransform,
+	const std::vector<size_t>& unique,
+	const std::vector<SInstance>& meshTransforms,
+	std::vector<SInstance>& instances)
+{
+	matrix_t nodeTransform;
+	matrix_copy(node->TransformMatrix, nodeTransform);
+	matrix_multiply(nodeTransform, parentTransform);
+
+	for (size_t meshIndex : node->Meshes)
+	{
+		SInstance instance;
+		instance.Mesh = unique[meshIndex];
+		matrix_copy(meshTransforms[meshIndex].Transform, instance.Transform);
+		matrix_multiply(instance.Transform, nodeTransform);
+		instances.push_back(instance);
+	}
+
+	for (const SNode* child : node->Children)
+	{
+		CollectInstances(child, nodeTransform, unique, meshTransforms, instances);
+	}
+}
+
+/** Removes references to removed meshes and remaps the rest to new indices. */
+static void RemapMeshes(SNode* node, const std::vector<size_t>& remap)
+{
+	std::vector<size_t> meshes;
+	for (size_t meshIndex : node->Meshes)
+	{
+		if (remap[meshIndex] != SIZE_MAX)
+		{
+			meshes.push_back(remap[meshIndex]);
+		}
+	}
+	node->Meshes = meshes;
+
+	for (SNode* child : node->Children)
+	{
+		RemapMeshes(child, remap);
+	}
+}
+
+size_t FindInstances(SModel* model, std::vector<SInstance>& instances)
+{
+	if (model->VertexFormat->Bones)
+	{
+		return 0;
+	}
+
+	size_t meshCount = model->Meshes.size();
+
+	// For each mesh, the index of the first mesh it is an instance of and the
+	// transform from that mesh
+	std::vector<size_t> unique(meshCount);
+	std::vector<SInstance> meshTransforms(meshCount);
+	std::unordered_map<uint64_t, std::vector<size_t>> buckets;
+
+	for (size_t i = 0; i < meshCount; ++i)
+	{
+		SMesh* mesh = model->Meshes[i];
+		std::vector<size_t>& bucket = buckets[HashMesh(mesh)];
+		unique[i] = i;
+
+		for (size_t candidate : bucket)
+		{
+			if (FindTransform(model->Meshes[candidate], mesh, meshTransforms[i].Transform))
+			{
+				unique[i] = candidate;
+				break;
+			}
+		}
+
+		if (unique[i] == i)
+		{
+			bucket.push_back(i);
+		}
+	}
+
+	// Remove instanced meshes
+	std::vector<size_t> remap(meshCount, SIZE_MAX);
+	std::vector<SMesh*> meshes;
+
+	for (size_t i = 0; i < meshCount; ++i)
+	{
+		if (unique[i] == i)
+		{
+			remap[i] = meshes.size();
+			meshes.push_back(model->Meshes[i]);
+		}
+	}
+
+	for (size_t i = 0; i < meshCount; ++i)
+	{
+		unique[i] = remap[unique[i]];
+	}
+
+	// The inverse transform matrix undoes the transform of the root node, so
+	// the instances are relative to it
+	CollectInstances(model->RootNode, model->InverseTransformMatrix,
+		unique, meshTransforms, instances);
+
+	RemapMeshes(model->RootNode, remap);
+
+	for (size_t i = 0; i < meshCount; ++i)
+	{
+		if (remap[i] == SIZE_MAX)
+		{
+			delete model->Meshes[i];
+		}
+	}
+
+	size_t removed = meshCount - meshes.size();
+	model->Meshes = meshes;
+	return removed;
+}
+
+bool SaveInstances(std::string path, const std::vector<SInstance>& instances)
+{
+	std::ofstream file;
+
+	if (!OpenSidecarFile(file, path, "bbinst"))
+	{
+		return false;
+	}
+
+	size_t instanceCount = instances.size();
+	FILE_WRITE_SIZE(file, instanceCount);
+
+	for (const SInstance& instance : instances)
+	{
+		FILE_WRITE_SIZE(file, instance.Mesh);
+		FILE_WRITE_MATRIX(file, instance.Transform);
+	}
+
+	file.flush();
+	file.close();
+
+	return true;
+}
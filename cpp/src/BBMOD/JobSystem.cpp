@@ -0,0 +1,152 @@
+#include <BBMOD/JobSystem.hpp>
+
+#include <algorithm>
+
+SJobSystem::SJobSystem(size_t threadCount)
+{
+	if (threadCount == 0)
+	{
+		size_t hardwareThreads = std::thread::hardware_concurrency();
+		threadCount = (hardwareThreads > 1) ? hardwareThreads - 1 : 1;
+	}
+
+	Queues = std::vector<SJobQueue>(threadCount);
+
+	for (size_t i = 0; i < threadCount; ++i)
+	{
+		Threads.emplace_back(&SJobSystem::WorkerMain, this, i);
+	}
+}
+
+SJobSystem::~SJobSystem()
+{
+	Wait();
+
+	{
+		std::lock_guard<std::mutex> lock(WakeMutex);
+		Stop = true;
+	}
+	WakeCondition.notify_all();
+
+	for (std::thread& thread : Threads)
+	{
+		thread.join();
+	}
+}
+
+void SJobSystem::Dispatch(size_t count, size_t batchSize, std::function<void(size_t, size_t)> function)
+{
+	Wait();
+
+	if (count == 0)
+	{
+		return;
+	}
+
+	batchSize = std::max<size_t>(batchSize, 1);
+	size_t jobCount = (count + batchSize - 1) / batchSize;
+
+	Function = std::move(function);
+	Pending = jobCount;
+
+	for (size_t i = 0; i < jobCount; ++i)
+	{
+		SJob job;
+		job.Begin = i * batchSize;
+		job.End = std::min(job.Begin + batchSize, count);
+
+		SJobQueue& queue = Queues[i % Queues.size()];
+		std::lock_guard<std::mutex> lock(queue.Mutex);
+		queue.Jobs.push_back(job);
+	}
+
+	{
+		std::lock_guard<std::mutex> lock(WakeMutex);
+		++Generation;
+	}
+	WakeCondition.notify_all();
+}
+
+void SJobSystem::Wait()
+{
+	while (Pending > 0)
+	{
+		if (!RunJob(Queues.size()))
+		{
+			// All jobs are taken, wait for the workers to finish them
+			std::unique_lock<std::mutex> lock(DoneMutex);
+			DoneCondition.wait(lock, [this] { return Pending == 0; });
+		}
+	}
+}
+
+bool SJobSystem::TakeJob(size_t queue, SJob& job)
+{
+	// Own jobs are taken from the back...
+	if (queue < Queues.size())
+	{
+		SJobQueue& own = Queues[queue];
+		std::lock_guard<std::mutex> lock(own.Mutex);
+		if (!own.Jobs.empty())
+		{
+			job = own.Jobs.back();
+			own.Jobs.pop_back();
+			return true;
+		}
+	}
+
+	// ...and stolen ones from the front
+	for (size_t i = 1; i <= Queues.size(); ++i)
+	{
+		SJobQueue& other = Queues[(queue + i) % Queues.size()];
+		std::lock_guard<std::mutex> lock(other.Mutex);
+		if (!other.Jobs.empty())
+		{
+			job = other.Jobs.front();
+			other.Jobs.pop_front();
+			return true;
+		}
+	}
+
+	return false;
+}
+
+bool SJobSystem::RunJob(size_t queue)
+{
+	SJob job;
+	if (!TakeJob(queue, job))
+	{
+		return false;
+	}
+
+	Function(job.Begin, job.End);
+
+	if (--Pending == 0)
+	{
+		std::lock_guard<std::mutex> lock(DoneMutex);
+		DoneCondition.notify_all();
+	}
+
+	return true;
+}
+
+void SJobSystem::WorkerMain(size_t queue)
+{
+	size_t generation = 0;
+
+	while (true)
+	{
+		if (RunJob(queue))
+		{
+			continue;
+		}
+
+		std::unique_lock<std::mutex> lock(WakeMutex);
+		WakeCondition.wait(lock, [&] { return Stop || Generation != generation; });
+		if (Stop)
+		{
+			return;
+		}
+		generation = Generation;
+	}
+}
@@ -0,0 +1,220 @@
+#include <BBMOD/LevelBake.hpp>
+#include <utils.hpp>
+
+#include <algorithm>
+#include <cmath>
+#include <cstdint>
+#include <map>
+#include <tuple>
+
+/** Cell coordinates. */
+typedef std::tuple<int, int, int> cell_coords_t;
+
+/** Cells and meshes created by BakeCells, ordered by cell coordinates. */
+struct SBakeState
+{
+	SBakeState(float cellSize) : CellSize(cellSize)
+	{
+	}
+
+	float CellSize;
+
+	std::map<cell_coords_t, SCell> Cells;
+
+	/** Meshes of cells, indexed by cell coordinates and material indices. */
+	std::map<std::pair<cell_coords_t, size_t>, SMesh*> Meshes;
+};
+
+/** Returns a vertex transformed by a transform and its normal transform. */
+static SVertex* TransformVertex(const SVertex* vertex, const matrix_t transform,
+	const matrix_t normalTransform, float bitangentSign)
+{
+	SVertex* result = new SVertex(*vertex);
+
+	matrix_transform_vec3(transform, vertex->Position, 1.0f, result->Position);
+
+	matrix_transform_vec3(normalTransform, vertex->Normal, 0.0f, result->Normal);
+	vec3_normalize(result->Normal);
+
+	matrix_transform_vec3(transform, vertex->Tangent, 0.0f, result->Tangent);
+	vec3_normalize(result->Tangent);
+	result->BitangentSign *= bitangentSign;
+
+	return result;
+}
+
+/**
+ * Adds a triangle into a mesh of the cell which contains its center. The
+ * vertex format of the mesh is extended with attributes of the source mesh.
+ */
+static void AddTriangle(SBakeState& state, const SMesh* source, SVertex* triangle[3])
+{
+	int coords[3];
+	for (size_t i = 0; i < 3; ++i)
+	{
+		float center = (triangle[0]->Position[i]
+			+ triangle[1]->Position[i]
+			+ triangle[2]->Position[i]) / 3.0f;
+		coords[i] = (int)std::floor(center / state.CellSize);
+	}
+
+	cell_coords_t key(coords[0], coords[1], coords[2]);
+
+	auto cellIt = state.Cells.find(key);
+	if (cellIt == state.Cells.end())
+	{
+		SCell cell;
+		cell.X = coords[0];
+		cell.Y = coords[1];
+		cell.Z = coords[2];
+		vec3_copy(triangle[0]->Position, cell.Min);
+		vec3_copy(triangle[0]->Position, cell.Max);
+		cellIt = state.Cells.emplace(key, cell).first;
+	}
+
+	SCell& cell = cellIt->second;
+	SMesh*& mesh = state.Meshes[{ key, source->MaterialIndex }];
+	if (!mesh)
+	{
+		mesh = new SMesh();
+		mesh->VertexFormat = new SVertexFormat(*source->VertexFormat);
+		mesh->MaterialIndex = source->MaterialIndex;
+	}
+	mesh->VertexFormat->Add(*source->VertexFormat);
+
+	for (size_t i = 0; i < 3; ++i)
+	{
+		for (size_t j = 0; j < 3; ++j)
+		{
+			cell.Min[j] = std::min(cell.Min[j], triangle[i]->Position[j]);
+			cell.Max[j] = std::max(cell.Max[j], triangle[i]->Position[j]);
+		}
+		triangle[i]->VertexFormat = mesh->VertexFormat;
+		mesh->Data.push_back(triangle[i]);
+	}
+}
+
+/** Transforms triangles of meshes of a node and its children and adds them into cells. */
+static void BakeNode(SBakeState& state, SModel* model, const SNode* node, const matrix_t parentTransform)
+{
+	matrix_t transform;
+	matrix_copy(node->TransformMatrix, transform);
+	matrix_multiply(transform, parentTransform);
+
+	matrix_t normalTransform;
+	matrix_copy(transform, normalTransform);
+	matrix_inverse(normalTransform);
+	matrix_transpose(normalTransform);
+
+	// Mirroring transforms flip the bitangent and the winding order
+	bool mirror = (matrix_determinant(transform) < 0.0f);
+	float bitangentSign = mirror ? -1.0f : 1.0f;
+
+	for (size_t meshIndex : node->Meshes)
+	{
+		const SMesh* mesh = model->Meshes[meshIndex];
+
+		for (size_t i = 0; i + 2 < mesh->Data.size(); i += 3)
+		{
+			SVertex* triangle[3];
+			for (size_t j = 0; j < 3; ++j)
+			{
+				triangle[j] = TransformVertex(mesh->Data[i + j], transform, normalTransform, bitangentSign);
+			}
+			if (mirror)
+			{
+				std::swap(triangle[1], triangle[2]);
+			}
+			AddTriangle(state, mesh, triangle);
+		}
+	}
+
+	for (const SNode* child : node->Children)
+	{
+		BakeNode(state, model, child, transform);
+	}
+}
+
+bool BakeCells(SModel* model, float cellSize, std::vector<SCell>& cells)
+{
+	if (model->VertexFormat->Bones)
+	{
+		return false;
+	}
+
+	SBakeState state(cellSize);
+
+	// The inverse transform matrix undoes the transform of the root node, so
+	// the baked vertices are relative to it
+	BakeNode(state, model, model->RootNode, model->InverseTransformMatrix);
+
+	for (SMesh* mesh : model->Meshes)
+	{
+		delete mesh;
+	}
+	model->Meshes.clear();
+
+	// One child node for each cell
+	SNode* root = new SNode();
+	root->Name = model->RootNode->Name;
+	root->Index = 0.0f;
+	model->NodeCount = 1;
+
+	std::map<cell_coords_t, SNode*> nodes;
+
+	for (auto& pair : state.Cells)
+	{
+		const SCell& cell = pair.second;
+		cells.push_back(cell);
+
+		SNode* node = new SNode();
+		node->Name = "cell_" + std::to_string(cell.X)
+			+ "_" + std::to_string(cell.Y)
+			+ "_" + std::to_string(cell.Z);
+		node->Index = (float)model->NodeCount++;
+		root->Children.push_back(node);
+		nodes[pair.first] = node;
+	}
+
+	// Meshes are ordered by cells, then by materials
+	for (auto& pair : state.Meshes)
+	{
+		nodes[pair.first.first]->Meshes.push_back(model->Meshes.size());
+		model->Meshes.push_back(pair.second);
+	}
+
+	delete model->RootNode;
+	model->RootNode = root;
+
+	matrix_t identity = MATRIX_IDENTITY;
+	matrix_copy(identity, model->InverseTransformMatrix);
+
+	return true;
+}
+
+bool SaveCells(std::string path, float cellSize, const std::vector<SCell>& cells)
+{
+	std::ofstream file;
+
+	if (!OpenSidecarFile(file, path, "bbcell"))
+	{
+		return false;
+	}
+	FILE_WRITE_DATA(file, cellSize);
+
+	size_t cellCount = cells.size();
+	FILE_WRITE_SIZE(file, cellCount);
+
+	for (const SCell& cell : cells)
+	{
+		int32_t coords[3] = { cell.X, cell.Y, cell.Z };
+		FILE_WRITE_DATA(file, coords);
+		FILE_WRITE_VEC3(file, cell.Min);
+		FILE_WRITE_VEC3(file, cell.Max);
+	}
+
+	file.flush();
+	file.close();
+
+	return true;
+}
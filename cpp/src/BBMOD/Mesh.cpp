@@ -5,6 +5,7 @@
 
 #include <assimp/scene.h>
 
+#include <cstring>
 #include <map>
 #include <vector>
 #include <string>
@@ -66,11 +67,19 @@ SMesh* SMesh::FromAssimp(aiMesh* aiMesh, SModel* model, const SConfig& config)
 {
 	SMesh* mesh = new SMesh();
 
-	mesh->VertexFormat = model->VertexFormat;
+	SVertexFormat* vertexFormat = new SVertexFormat();
+	vertexFormat->Vertices = true;
+	vertexFormat->Normals = aiMesh->HasNormals() && !config.DisableNormals;
+	vertexFormat->TextureCoords = aiMesh->HasTextureCoords(0) && !config.DisableTextureCoords;
+	vertexFormat->Colors = aiMesh->HasVertexColors(0) && !config.DisableVertexColors;
+	vertexFormat->TangentW = aiMesh->HasTangentsAndBitangents() && !(config.DisableNormals || config.DisableTangentW);
+	vertexFormat->Bones = aiMesh->HasBones() && !config.DisableBones;
+	vertexFormat->Ids = false;
+
+	mesh->VertexFormat = vertexFormat;
 	mesh->MaterialIndex = aiMesh->mMaterialIndex;
 
 	uint32_t faceCount = aiMesh->mNumFaces;
-	aiColor4D cWhite(1.0f, 1.0f, 1.0f, 1.0f);
 	uint32_t vertexCount = faceCount * 3;
 
 	////////////////////////////////////////////////////////////////////////////
@@ -78,7 +87,7 @@ SMesh* SMesh::FromAssimp(aiMesh* aiMesh, SModel* model, const SConfig& config)
 	std::map<uint32_t, std::vector<float>> vertexBones;
 	std::map<uint32_t, std::vector<float>> vertexWeights;
 
-	if (model->VertexFormat->Bones)
+	if (vertexFormat->Bones)
 	{
 		uint32_t boneCount = aiMesh->mNumBones;
 
@@ -133,11 +142,9 @@ SMesh* SMesh::FromAssimp(aiMesh* aiMesh, SModel* model, const SConfig& config)
 
 			// Normal
 			aiVector3D normal;
-			if (model->VertexFormat->Normals)
+			if (vertexFormat->Normals)
 			{
-				normal = aiMesh->HasNormals()
-					? aiVector3D(aiMesh->mNormals[idx])
-					: aiVector3D();
+				normal = aiMesh->mNormals[idx];
 				if (config.FlipNormals)
 				{
 					normal *= -1.0f;
@@ -146,11 +153,9 @@ SMesh* SMesh::FromAssimp(aiMesh* aiMesh, SModel* model, const SConfig& config)
 			}
 
 			// Texture
-			if (model->VertexFormat->TextureCoords)
+			if (vertexFormat->TextureCoords)
 			{
-				aiVector3D texture = aiMesh->HasTextureCoords(0)
-					? aiMesh->mTextureCoords[0][idx]
-					: aiVector3D();
+				aiVector3D texture = aiMesh->mTextureCoords[0][idx];
 				if (config.FlipTextureHorizontally)
 				{
 					texture.x = 1.0f - texture.x;
@@ -164,32 +169,22 @@ SMesh* SMesh::FromAssimp(aiMesh* aiMesh, SModel* model, const SConfig& config)
 			}
 
 			// Color
-			if (model->VertexFormat->Colors)
+			if (vertexFormat->Colors)
 			{
-				aiColor4D& color = (aiMesh->HasVertexColors(0))
-					? aiMesh->mColors[0][idx]
-					: cWhite;
-				vertex->Color = EncodeColor(color);
+				vertex->Color = EncodeColor(aiMesh->mColors[0][idx]);
 			}
 
-			if (model->VertexFormat->TangentW)
+			if (vertexFormat->TangentW)
 			{
-				if (aiMesh->HasTangentsAndBitangents())
-				{
-					// Tangent
-					AssimpToVec3(aiMesh->mTangents[idx], vertex->Tangent);
+				// Tangent
+				AssimpToVec3(aiMesh->mTangents[idx], vertex->Tangent);
 
-					// Bitangent sign
-					aiVector3D bitangent = aiMesh->mBitangents[idx];
-					vertex->BitangentSign = GetBitangentSign(normal, aiMesh->mTangents[idx], bitangent);
-				}
-				else
-				{
-					vertex->BitangentSign = 1.0f;
-				}
+				// Bitangent sign
+				aiVector3D bitangent = aiMesh->mBitangents[idx];
+				vertex->BitangentSign = GetBitangentSign(normal, aiMesh->mTangents[idx], bitangent);
 			}
 
-			if (model->VertexFormat->Bones)
+			if (vertexFormat->Bones)
 			{
 				// Bone indices
 				if (vertexBones.find(idx) != vertexBones.end())
@@ -251,20 +246,28 @@ bool SVertex::Save(std::ofstream& file)
 
 	if (vertexFormat->Bones)
 	{
-		for (size_t i = 0; i < 4; ++i)
+		size_t influences = vertexFormat->BoneInfluences;
+
+		for (size_t i = 0; i < influences; ++i)
 		{
 			FILE_WRITE_DATA(file, Bones[i]);
 		}
 
-		for (size_t i = 0; i < 4; ++i)
+		// The weight of a single influence is always 1
+		if (influences > 1)
 		{
-			FILE_WRITE_DATA(file, Weights[i]);
+			for (size_t i = 0; i < influences; ++i)
+			{
+				FILE_WRITE_DATA(file, Weights[i]);
+			}
 		}
 	}
 
 	if (vertexFormat->Ids)
 	{
-		FILE_WRITE_DATA(file, Id);
+		// Shaders read ids as floats
+		float id = (float)Id;
+		FILE_WRITE_DATA(file, id);
 	}
 
 	return true;
@@ -303,31 +306,58 @@ SVertex* SVertex::Load(std::ifstream& file, SVertexFormat* vertexFormat)
 
 	if (vertexFormat->Bones)
 	{
-		for (size_t i = 0; i < 4; ++i)
+		size_t influences = vertexFormat->BoneInfluences;
+
+		for (size_t i = 0; i < influences; ++i)
 		{
 			FILE_READ_DATA(file, vertex->Bones[i]);
 		}
 
-		for (size_t i = 0; i < 4; ++i)
+		if (influences > 1)
+		{
+			for (size_t i = 0; i < influences; ++i)
+			{
+				FILE_READ_DATA(file, vertex->Weights[i]);
+			}
+		}
+		else
 		{
-			FILE_READ_DATA(file, vertex->Weights[i]);
+			vertex->Weights[0] = 1.0f;
 		}
 	}
 
 	if (vertexFormat->Ids)
 	{
-		FILE_READ_DATA(file, vertex->Id);
+		float id;
+		FILE_READ_DATA(file, id);
+		vertex->Id = (int)id;
 	}
 
 	return vertex;
 }
 
+SMesh::~SMesh()
+{
+	for (SVertex* vertex : Data)
+	{
+		delete vertex;
+	}
+
+	delete VertexFormat;
+}
+
 bool SMesh::Save(std::ofstream& file)
 {
-	FILE_WRITE_DATA(file, MaterialIndex);
+	FILE_WRITE_SIZE(file, MaterialIndex);
+	FILE_WRITE_DATA(file, PrimitiveType);
+
+	if (!VertexFormat->Save(file))
+	{
+		return false;
+	}
 
 	size_t vertexCount = Data.size();
-	FILE_WRITE_DATA(file, vertexCount);
+	FILE_WRITE_SIZE(file, vertexCount);
 
 	for (SVertex* vertex : Data)
 	{
@@ -340,15 +370,72 @@ bool SMesh::Save(std::ofstream& file)
 	return true;
 }
 
-SMesh* SMesh::Load(std::ifstream& file, SVertexFormat* vertexFormat)
+size_t SMesh::GetSize() const
+{
+	return (sizeof(uint32_t)
+		+ sizeof(uint8_t)
+		+ VertexFormat->GetSize()
+		+ sizeof(uint32_t)
+		+ Data.size() * VertexFormat->GetVertexSize());
+}
+
+size_t SMesh::GetTriangleCount() const
+{
+	if (PrimitiveType == BBMOD_PRIMITIVE_TRIANGLE_STRIP)
+	{
+		return (Data.size() >= 3) ? Data.size() - 2 : 0;
+	}
+	return Data.size() / 3;
+}
+
+void SMesh::GetTriangleList(std::vector<const SVertex*>& out) const
+{
+	if (PrimitiveType != BBMOD_PRIMITIVE_TRIANGLE_STRIP)
+	{
+		out.insert(out.end(), Data.begin(), Data.end());
+		return;
+	}
+
+	for (size_t i = 0; i + 2 < Data.size(); ++i)
+	{
+		const SVertex* a = Data[i];
+		const SVertex* b = Data[i + 1];
+		const SVertex* c = Data[i + 2];
+
+		if (!std::memcmp(a->Position, b->Position, sizeof(vec3_t))
+			|| !std::memcmp(b->Position, c->Position, sizeof(vec3_t))
+			|| !std::memcmp(c->Position, a->Position, sizeof(vec3_t)))
+		{
+			continue;
+		}
+
+		// Every other triangle of a strip has a flipped winding order
+		if (i % 2 == 0)
+		{
+			out.push_back(a);
+			out.push_back(b);
+		}
+		else
+		{
+			out.push_back(b);
+			out.push_back(a);
+		}
+		out.push_back(c);
+	}
+}
+
+SMesh* SMesh::Load(std::ifstream& file)
 {
 	SMesh* mesh = new SMesh();
-	mesh->VertexFormat = vertexFormat;
 
-	FILE_READ_DATA(file, mesh->MaterialIndex);
+	FILE_READ_SIZE(file, mesh->MaterialIndex);
+	FILE_READ_DATA(file, mesh->PrimitiveType);
+
+	SVertexFormat* vertexFormat = SVertexFormat::Load(file);
+	mesh->VertexFormat = vertexFormat;
 
 	size_t vertexCount;
-	FILE_READ_DATA(file, vertexCount);
+	FILE_READ_SIZE(file, vertexCount);
 
 	for (size_t i = 0; i < vertexCount; ++i)
 	{
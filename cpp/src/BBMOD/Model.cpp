@@ -1,4 +1,5 @@
 #include <BBMOD/Model.hpp>
+#include <BBMOD/Profiler.hpp>
 
 #include <utils.hpp>
 
@@ -62,18 +63,7 @@ SModel* SModel::FromAssimp(const aiScene* scene, const SConfig& config)
 {
 	SModel* model = new SModel();
 
-	// Resolve vertex format of the model
-	aiMesh* mesh = scene->mMeshes[0];
-
-	SVertexFormat* vertexFormat = new SVertexFormat();
-	vertexFormat->Vertices = true;
-	vertexFormat->Normals = mesh->HasNormals() && !config.DisableNormals;
-	vertexFormat->TextureCoords = mesh->HasTextureCoords(0) && !config.DisableTextureCoords;
-	vertexFormat->Colors = mesh->HasVertexColors(0) && !config.DisableVertexColors;
-	vertexFormat->TangentW = mesh->HasTangentsAndBitangents() && !(config.DisableNormals || config.DisableTangentW);
-	vertexFormat->Bones = false;
-	vertexFormat->Ids = false;
-
+	// Collect bones
 	if (!config.DisableBones)
 	{
 		for (size_t i = 0; i < scene->mNumMeshes; ++i)
@@ -82,10 +72,6 @@ SModel* SModel::FromAssimp(const aiScene* scene, const SConfig& config)
 
 			if (meshCurrent->HasBones())
 			{
-				// The model has bones
-				vertexFormat->Bones = true;
-
-				// Collect all bones
 				for (size_t j = 0; j < meshCurrent->mNumBones; ++j)
 				{
 					aiBone* boneCurrent = meshCurrent->mBones[j];
@@ -105,19 +91,30 @@ SModel* SModel::FromAssimp(const aiScene* scene, const SConfig& config)
 		model->NodeCount = model->BoneCount;
 	}
 
-	vertexFormat->Ids = false;
-
-	model->VertexFormat = vertexFormat;
-	
 	// Meshes
-	for (size_t i = 0; i < scene->mNumMeshes; ++i)
 	{
-		aiMesh* meshCurrent = scene->mMeshes[i];
-		model->Meshes.push_back(SMesh::FromAssimp(meshCurrent, model, config));
+		BBMOD_PROFILE_SCOPE("ConvertMeshes");
+		for (size_t i = 0; i < scene->mNumMeshes; ++i)
+		{
+			aiMesh* meshCurrent = scene->mMeshes[i];
+			model->Meshes.push_back(SMesh::FromAssimp(meshCurrent, model, config));
+		}
+	}
+
+	// Each mesh has its own vertex format, the model has all of their attributes
+	SVertexFormat* vertexFormat = new SVertexFormat();
+	vertexFormat->Vertices = true;
+	for (SMesh* mesh : model->Meshes)
+	{
+		vertexFormat->Add(*mesh->VertexFormat);
 	}
+	model->VertexFormat = vertexFormat;
 
 	// Nodes
-	model->RootNode = CollectNodes(model, scene->mRootNode, config);
+	{
+		BBMOD_PROFILE_SCOPE("ConvertNodes");
+		model->RootNode = CollectNodes(model, scene->mRootNode, config);
+	}
 
 	// Inverse transform matrix
 	matrix_copy(model->RootNode->TransformMatrix, model->InverseTransformMatrix);
@@ -173,6 +170,25 @@ SNode* SModel::FindNodeByName(std::string name, SNode* nodeCurrent) const
 	return nullptr;
 }
 
+SModel::~SModel()
+{
+	for (SMesh* mesh : Meshes)
+	{
+		delete mesh;
+	}
+
+	delete RootNode;
+
+	for (SBone* bone : Skeleton)
+	{
+		delete bone;
+	}
+
+	delete VertexFormat;
+
+	delete BVH;
+}
+
 bool SModel::Save(std::string path)
 {
 	std::ofstream file(path, std::ios::out | std::ios::binary);
@@ -190,8 +206,10 @@ bool SModel::Save(std::string path)
 		return false;
 	}
 
+	FILE_WRITE_SIZE(file, BatchSize);
+
 	size_t meshCount = Meshes.size();
-	FILE_WRITE_DATA(file, meshCount);
+	FILE_WRITE_SIZE(file, meshCount);
 
 	for (SMesh* mesh : Meshes)
 	{
@@ -203,14 +221,14 @@ bool SModel::Save(std::string path)
 
 	FILE_WRITE_MATRIX(file, InverseTransformMatrix);
 
-	FILE_WRITE_DATA(file, NodeCount);
+	FILE_WRITE_SIZE(file, NodeCount);
 
 	if (!RootNode->Save(file))
 	{
 		return false;
 	}
 
-	FILE_WRITE_DATA(file, BoneCount);
+	FILE_WRITE_SIZE(file, BoneCount);
 
 	for (SBone* bone : Skeleton)
 	{
@@ -221,7 +239,7 @@ bool SModel::Save(std::string path)
 	}
 
 	size_t materialCount = MaterialNames.size();
-	FILE_WRITE_DATA(file, materialCount);
+	FILE_WRITE_SIZE(file, materialCount);
 
 	for (std::string& materialName : MaterialNames)
 	{
@@ -229,12 +247,91 @@ bool SModel::Save(std::string path)
 		file.write(str, strlen(str) + 1);
 	}
 
+	if (BVH)
+	{
+		if (!BVH->Save(file))
+		{
+			return false;
+		}
+	}
+	else
+	{
+		FILE_WRITE_SIZE(file, 0);
+		FILE_WRITE_SIZE(file, 0);
+	}
+
 	file.flush();
 	file.close();
 
 	return true;
 }
 
+bool SModel::MakeBatched(size_t batchSize)
+{
+	if (VertexFormat->Bones)
+	{
+		return false;
+	}
+
+	VertexFormat->Ids = true;
+	BatchSize = batchSize;
+
+	// All meshes of a batch share one vertex buffer, so they must also share
+	// the vertex format
+	for (SMesh* mesh : Meshes)
+	{
+		*mesh->VertexFormat = *VertexFormat;
+
+		size_t vertexCount = mesh->Data.size();
+		mesh->Data.reserve(vertexCount * batchSize);
+
+		for (size_t id = 1; id < batchSize; ++id)
+		{
+			for (size_t i = 0; i < vertexCount; ++i)
+			{
+				SVertex* vertex = new SVertex(*mesh->Data[i]);
+				vertex->Id = (int)id;
+				mesh->Data.push_back(vertex);
+			}
+		}
+	}
+
+	return true;
+}
+
+SModelSections SModel::GetSections() const
+{
+	SModelSections sections;
+
+	sections.Header = sizeof(char) * 6 + sizeof(Version);
+	sections.VertexFormat = VertexFormat->GetSize();
+
+	sections.Meshes = sizeof(uint32_t) * 2;
+	for (SMesh* mesh : Meshes)
+	{
+		sections.Meshes += mesh->GetSize();
+	}
+
+	sections.InverseTransform = sizeof(float) * 16;
+	sections.Nodes = sizeof(uint32_t) + RootNode->GetSize();
+
+	sections.Bones = sizeof(uint32_t);
+	for (SBone* bone : Skeleton)
+	{
+		sections.Bones += bone->GetSize();
+	}
+
+	sections.Materials = sizeof(uint32_t);
+	for (const std::string& materialName : MaterialNames)
+	{
+		sections.Materials += materialName.size() + 1;
+	}
+
+	sections.BVH = SBVH::GetSize(BVH);
+
+	return sections;
+}
+
 SModel* SModel::Load(std::string path)
 {
 	std::ifstream file(path, std::ios::in | std::ios::binary);
@@ -268,22 +365,24 @@ SModel* SModel::Load(std::string path)
 	SVertexFormat* vertexFormat = SVertexFormat::Load(file);
 	model->VertexFormat = vertexFormat;
 
+	FILE_READ_SIZE(file, model->BatchSize);
+
 	size_t meshCount;
-	FILE_READ_DATA(file, meshCount);
+	FILE_READ_SIZE(file, meshCount);
 
 	for (size_t i = 0; i < meshCount; ++i)
 	{
-		SMesh* mesh = SMesh::Load(file, vertexFormat);
+		SMesh* mesh = SMesh::Load(file);
 		model->Meshes.push_back(mesh);
 	}
 
 	FILE_READ_MATRIX(file, model->InverseTransformMatrix);
 
-	FILE_READ_DATA(file, model->NodeCount);
+	FILE_READ_SIZE(file, model->NodeCount);
 
 	model->RootNode = SNode::Load(file);
 
-	FILE_READ_DATA(file, model->BoneCount);
+	FILE_READ_SIZE(file, model->BoneCount);
 
 	for (size_t i = 0; i < model->BoneCount; ++i)
 	{
@@ -292,7 +391,7 @@ SModel* SModel::Load(std::string path)
 	}
 
 	size_t materialCount;
-	FILE_READ_DATA(file, materialCount);
+	FILE_READ_SIZE(file, materialCount);
 
 	for (size_t i = 0; i < materialCount; ++i)
 	{
@@ -301,6 +400,8 @@ SModel* SModel::Load(std::string path)
 		model->MaterialNames.push_back(materialName);
 	}
 
+	model->BVH = SBVH::Load(file);
+
 	file.close();
 	return model;
 }
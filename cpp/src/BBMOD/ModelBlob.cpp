@@ -0,0 +1,331 @@
+#include <BBMOD/ModelBlob.hpp>
+#include <BBMOD/common.hpp>
+
+#include <cstdint>
+#include <cstring>
+#include <fstream>
+#include <iterator>
+
+/** Size of a matrix saved in a file. */
+#define MATRIX_SIZE (16 * sizeof(float))
+
+/** Reads data of a BBMOD file with bounds checking. */
+struct SReader
+{
+	SReader(const unsigned char* data, size_t size)
+		: Data(data)
+		, Size(size)
+	{
+	}
+
+	/**
+	 * Returns a pointer to the next count * elementSize bytes or nullptr if
+	 * there are not enough.
+	 */
+	const unsigned char* Take(size_t count, size_t elementSize = 1)
+	{
+		if (elementSize > 0 && count > (Size - Position) / elementSize)
+		{
+			return nullptr;
+		}
+		const unsigned char* data = Data + Position;
+		Position += count * elementSize;
+		return data;
+	}
+
+	bool ReadSize(size_t& size)
+	{
+		const unsigned char* data = Take(sizeof(uint32_t));
+		if (!data)
+		{
+			return false;
+		}
+		uint32_t value;
+		std::memcpy(&value, data, sizeof(value));
+		size = (size_t)value;
+		return true;
+	}
+
+	/** Reads a null-terminated string, including the terminator. */
+	const unsigned char* TakeString(size_t& size)
+	{
+		const void* end = std::memchr(Data + Position, '\0', Size - Position);
+		if (!end)
+		{
+			return nullptr;
+		}
+		size = (const unsigned char*)end - (Data + Position) + 1;
+		return Take(size);
+	}
+
+	const unsigned char* Data;
+
+	size_t Size;
+
+	size_t Position = 0;
+};
+
+/** Writes data into a blob. */
+struct SWriter
+{
+	void Write(const void* data, size_t size)
+	{
+		const unsigned char* bytes = (const unsigned char*)data;
+		Data.insert(Data.end(), bytes, bytes + size);
+	}
+
+	void WriteSize(size_t size)
+	{
+		uint32_t value = (uint32_t)size;
+		Write(&value, sizeof(value));
+	}
+
+	std::vector<unsigned char> Data;
+};
+
+/** Returns the size of a vertex in a vertex format saved in a file. */
+static size_t GetVertexSize(const unsigned char* vertexFormat)
+{
+	// The bones attribute is saved as the number of bone influences, where a
+	// single influence has no weight
+	size_t influences = vertexFormat[5];
+	return (0
+		+ (vertexFormat[0] != 0) * 3 * sizeof(float)
+		+ (vertexFormat[1] != 0) * 3 * sizeof(float)
+		+ (vertexFormat[2] != 0) * 2 * sizeof(float)
+		+ (vertexFormat[3] != 0) * sizeof(uint32_t)
+		+ (vertexFormat[4] != 0) * 4 * sizeof(float)
+		+ ((influences > 1) ? influences * 2 : influences) * sizeof(float)
+		+ (vertexFormat[6] != 0) * sizeof(float));
+}
+
+/**
+ * Returns a vertex format saved in a file as a bit mask, where bit i is set
+ * if the i-th attribute is enabled and bits 8 to 15 hold the number of bone
+ * influences.
+ */
+static uint32_t GetVertexFormatMask(const unsigned char* vertexFormat)
+{
+	uint32_t mask = 0;
+	for (uint32_t i = 0; i < 7; ++i)
+	{
+		mask |= (uint32_t)(vertexFormat[i] != 0) << i;
+	}
+	mask |= (uint32_t)vertexFormat[5] << 8;
+	return mask;
+}
+
+/** Copies a node and its children into node entries in pre-order. */
+static bool RepackNode(SReader& reader, SWriter& writer, int32_t parent, int32_t& entryCount)
+{
+	int32_t index = entryCount++;
+	writer.Write(&parent, sizeof(parent));
+
+	// Name, index, is bone and transform matrix
+	size_t size;
+	const unsigned char* name = reader.TakeString(size);
+	if (!name)
+	{
+		return false;
+	}
+	writer.Write(name, size);
+
+	const unsigned char* data = reader.Take(sizeof(float) + sizeof(bool) + MATRIX_SIZE);
+	if (!data)
+	{
+		return false;
+	}
+	writer.Write(data, sizeof(float) + sizeof(bool) + MATRIX_SIZE);
+
+	// Mesh indices
+	size_t meshCount;
+	if (!reader.ReadSize(meshCount)
+		|| !(data = reader.Take(meshCount, sizeof(uint32_t))))
+	{
+		return false;
+	}
+	writer.WriteSize(meshCount);
+	writer.Write(data, meshCount * sizeof(uint32_t));
+
+	// Child nodes
+	size_t childCount;
+	if (!reader.ReadSize(childCount))
+	{
+		return false;
+	}
+	writer.WriteSize(childCount);
+
+	for (size_t i = 0; i < childCount; ++i)
+	{
+		if (!RepackNode(reader, writer, index, entryCount))
+		{
+			return false;
+		}
+	}
+
+	return true;
+}
+
+SModelBlob* SModelBlob::Load(std::string path)
+{
+	std::ifstream file(path, std::ios::in | std::ios::binary);
+
+	if (!file.is_open())
+	{
+		return nullptr;
+	}
+
+	std::vector<unsigned char> data(
+		(std::istreambuf_iterator<char>(file)),
+		std::istreambuf_iterator<char>());
+	file.close();
+
+	return FromMemory(data.data(), data.size());
+}
+
+SModelBlob* SModelBlob::FromMemory(const unsigned char* data, size_t size)
+{
+	SReader reader(data, size);
+	SWriter writer;
+	writer.Data.reserve(size);
+
+	// Header
+	const unsigned char* header = reader.Take(6);
+	if (!header || std::memcmp(header, "bbmod", 6) != 0)
+	{
+		return nullptr;
+	}
+
+	const unsigned char* version = reader.Take(sizeof(uint8_t));
+	if (!version || *version != BBMOD_VERSION)
+	{
+		return nullptr;
+	}
+
+	// Vertex format
+	const unsigned char* vertexFormat = reader.Take(7 * sizeof(bool));
+	if (!vertexFormat)
+	{
+		return nullptr;
+	}
+	writer.Write(vertexFormat, 7 * sizeof(bool));
+
+	// Batch size
+	const unsigned char* batchSize = reader.Take(sizeof(uint32_t));
+	if (!batchSize)
+	{
+		return nullptr;
+	}
+	writer.Write(batchSize, sizeof(uint32_t));
+
+	// Mesh descriptors, offsets are filled in once the size of the rest is known
+	size_t meshCount;
+	if (!reader.ReadSize(meshCount))
+	{
+		return nullptr;
+	}
+	writer.WriteSize(meshCount);
+
+	size_t descriptors = writer.Data.size();
+	std::vector<const unsigned char*> vertexData;
+	std::vector<size_t> vertexDataSize;
+
+	for (size_t i = 0; i < meshCount; ++i)
+	{
+		size_t materialIndex;
+		const unsigned char* primitiveType;
+		const unsigned char* meshVertexFormat;
+		size_t vertexCount;
+		if (!reader.ReadSize(materialIndex)
+			|| !(primitiveType = reader.Take(sizeof(uint8_t)))
+			|| !(meshVertexFormat = reader.Take(7 * sizeof(bool)))
+			|| !reader.ReadSize(vertexCount))
+		{
+			return nullptr;
+		}
+
+		size_t vertexSize = GetVertexSize(meshVertexFormat);
+		const unsigned char* vertices = reader.Take(vertexCount, vertexSize);
+		if (!vertices)
+		{
+			return nullptr;
+		}
+		vertexData.push_back(vertices);
+		vertexDataSize.push_back(vertexCount * vertexSize);
+
+		writer.WriteSize(materialIndex);
+		writer.WriteSize(*primitiveType);
+		writer.WriteSize(GetVertexFormatMask(meshVertexFormat));
+		writer.WriteSize(0);
+		writer.WriteSize(vertexCount);
+	}
+
+	// Global inverse transform matrix
+	const unsigned char* inverseTransform = reader.Take(MATRIX_SIZE);
+	if (!inverseTransform)
+	{
+		return nullptr;
+	}
+	writer.Write(inverseTransform, MATRIX_SIZE);
+
+	// Nodes
+	size_t nodeCount;
+	if (!reader.ReadSize(nodeCount))
+	{
+		return nullptr;
+	}
+	writer.WriteSize(nodeCount);
+
+	size_t entryCountPosition = writer.Data.size();
+	writer.WriteSize(0);
+
+	int32_t entryCount = 0;
+	if (!RepackNode(reader, writer, -1, entryCount))
+	{
+		return nullptr;
+	}
+	uint32_t entryCountValue = (uint32_t)entryCount;
+	std::memcpy(&writer.Data[entryCountPosition], &entryCountValue, sizeof(entryCountValue));
+
+	// Bones
+	size_t boneCount;
+	const unsigned char* bones;
+	if (!reader.ReadSize(boneCount)
+		|| !(bones = reader.Take(boneCount, sizeof(float) + MATRIX_SIZE)))
+	{
+		return nullptr;
+	}
+	writer.WriteSize(boneCount);
+	writer.Write(bones, boneCount * (sizeof(float) + MATRIX_SIZE));
+
+	// Materials
+	size_t materialCount;
+	if (!reader.ReadSize(materialCount))
+	{
+		return nullptr;
+	}
+	writer.WriteSize(materialCount);
+
+	for (size_t i = 0; i < materialCount; ++i)
+	{
+		size_t nameSize;
+		const unsigned char* name = reader.TakeString(nameSize);
+		if (!name)
+		{
+			return nullptr;
+		}
+		writer.Write(name, nameSize);
+	}
+
+	// Vertex data
+	for (size_t i = 0; i < meshCount; ++i)
+	{
+		uint32_t offset = (uint32_t)writer.Data.size();
+		std::memcpy(&writer.Data[descriptors + (i * 5 + 3) * sizeof(uint32_t)], &offset, sizeof(offset));
+		writer.Write(vertexData[i], vertexDataSize[i]);
+	}
+
+	SModelBlob* blob = new SModelBlob();
+	blob->Data = std::move(writer.Data);
+	return blob;
+}
@@ -2,6 +2,14 @@
 #include <utils.hpp>
 #include <iostream>
 
+SNode::~SNode()
+{
+	for (SNode* child : Children)
+	{
+		delete child;
+	}
+}
+
 bool SNode::Save(std::ofstream& file)
 {
 	const char* str = Name.c_str();
@@ -12,15 +20,15 @@ bool SNode::Save(std::ofstream& file)
 	FILE_WRITE_MATRIX(file, TransformMatrix);
 
 	size_t meshCount = Meshes.size();
-	FILE_WRITE_DATA(file, meshCount);
+	FILE_WRITE_SIZE(file, meshCount);
 
 	for (size_t meshIndex : Meshes)
 	{
-		FILE_WRITE_DATA(file, meshIndex);
+		FILE_WRITE_SIZE(file, meshIndex);
 	}
 
 	size_t childCount = Children.size();
-	FILE_WRITE_DATA(file, childCount);
+	FILE_WRITE_SIZE(file, childCount);
 	
 	for (SNode* child : Children)
 	{
@@ -33,6 +41,23 @@ bool SNode::Save(std::ofstream& file)
 	return true;
 }
 
+size_t SNode::GetSize() const
+{
+	size_t size = (Name.size() + 1
+		+ sizeof(Index)
+		+ sizeof(IsBone)
+		+ sizeof(float) * 16
+		+ sizeof(uint32_t) * (Meshes.size() + 1)
+		+ sizeof(uint32_t));
+
+	for (SNode* child : Children)
+	{
+		size += child->GetSize();
+	}
+
+	return size;
+}
+
 SNode* SNode::Load(std::ifstream& file)
 {
 	SNode* node = new SNode();
@@ -46,17 +71,17 @@ SNode* SNode::Load(std::ifstream& file)
 	FILE_READ_MATRIX(file, node->TransformMatrix);
 
 	size_t meshCount;
-	FILE_READ_DATA(file, meshCount);
+	FILE_READ_SIZE(file, meshCount);
 
 	for (size_t i = 0; i < meshCount; ++i)
 	{
 		size_t meshIndex;
-		FILE_READ_DATA(file, meshIndex);
+		FILE_READ_SIZE(file, meshIndex);
 		node->Meshes.push_back(meshIndex);
 	}
 
 	size_t childCount;
-	FILE_READ_DATA(file, childCount);
+	FILE_READ_SIZE(file, childCount);
 
 	for (size_t i = 0; i < childCount; ++i)
 	{
@@ -0,0 +1,320 @@
+#include <BBMOD/Overdraw.hpp>
+
+#include <algorithm>
+#include <cfloat>
+#include <cmath>
+#include <cstring>
+#include <vector>
+
+static inline void TriangleNormal(const float* a, const float* b, const float* c, float* out)
+{
+	vec3_t ab, ac;
+	for (size_t i = 0; i < 3; ++i)
+	{
+		ab[i] = b[i] - a[i];
+		ac[i] = c[i] - a[i];
+	}
+	out[0] = ab[1] * ac[2] - ab[2] * ac[1];
+	out[1] = ab[2] * ac[0] - ab[0] * ac[2];
+	out[2] = ab[0] * ac[1] - ab[1] * ac[0];
+}
+
+static inline float Length(const float* v)
+{
+	return std::sqrt(v[0] * v[0] + v[1] * v[1] + v[2] * v[2]);
+}
+
+static inline bool SharesVertex(SVertex* const* a, SVertex* const* b)
+{
+	for (size_t i = 0; i < 3; ++i)
+	{
+		for (size_t j = 0; j < 3; ++j)
+		{
+			if (!std::memcmp(a[i]->Position, b[j]->Position, sizeof(vec3_t)))
+			{
+				return true;
+			}
+		}
+	}
+	return false;
+}
+
+/** A run of consecutive triangles of a mesh. */
+struct SOverdrawCluster
+{
+	size_t Begin = 0;
+
+	size_t End = 0;
+
+	/** Distance of the center of the cluster from the center of the mesh along its normal. */
+	float Sort = 0.0f;
+};
+
+bool OptimizeOverdraw(SMesh* mesh)
+{
+	if (mesh->PrimitiveType != BBMOD_PRIMITIVE_TRIANGLE_LIST)
+	{
+		return false;
+	}
+
+	std::vector<SVertex*>& data = mesh->Data;
+	size_t triangleCount = data.size() / 3;
+
+	if (triangleCount < 2)
+	{
+		return true;
+	}
+
+	// Area weighted center of the mesh
+	vec3_t center = VEC3_ZERO;
+	float areaTotal = 0.0f;
+
+	for (size_t i = 0; i < triangleCount; ++i)
+	{
+		SVertex* const* triangle = &data[i * 3];
+		vec3_t normal;
+		TriangleNormal(triangle[0]->Position, triangle[1]->Position, triangle[2]->Position, normal);
+		float area = Length(normal);
+
+		for (size_t j = 0; j < 3; ++j)
+		{
+			center[j] += (triangle[0]->Position[j] + triangle[1]->Position[j] + triangle[2]->Position[j])
+				* (area / 3.0f);
+		}
+		areaTotal += area;
+	}
+
+	if (areaTotal <= 0.0f)
+	{
+		return true;
+	}
+
+	for (size_t i = 0; i < 3; ++i)
+	{
+		center[i] /= areaTotal;
+	}
+
+	// Split triangles into clusters, keeping connected runs together
+	std::vector<SOverdrawCluster> clusters;
+	SOverdrawCluster cluster;
+
+	for (size_t i = 1; i <= triangleCount; ++i)
+	{
+		if (i == triangleCount
+			|| i - cluster.Begin >= BBMOD_OVERDRAW_CLUSTER_SIZE
+			|| !SharesVertex(&data[(i - 1) * 3], &data[i * 3]))
+		{
+			cluster.End = i;
+			clusters.push_back(cluster);
+			cluster.Begin = i;
+		}
+	}
+
+	for (SOverdrawCluster& c : clusters)
+	{
+		vec3_t clusterCenter = VEC3_ZERO;
+		vec3_t clusterNormal = VEC3_ZERO;
+		float clusterArea = 0.0f;
+
+		for (size_t i = c.Begin; i < c.End; ++i)
+		{
+			SVertex* const* triangle = &data[i * 3];
+			vec3_t normal;
+			TriangleNormal(triangle[0]->Position, triangle[1]->Position, triangle[2]->Position, normal);
+			float area = Length(normal);
+
+			for (size_t j = 0; j < 3; ++j)
+			{
+				clusterCenter[j] += (triangle[0]->Position[j] + triangle[1]->Position[j] + triangle[2]->Position[j])
+					* (area / 3.0f);
+				clusterNormal[j] += normal[j];
+			}
+			clusterArea += area;
+		}
+
+		if (clusterArea <= 0.0f || Length(clusterNormal) <= 0.0f)
+		{
+			continue;
+		}
+
+		vec3_normalize(clusterNormal);
+
+		for (size_t j = 0; j < 3; ++j)
+		{
+			c.Sort += (clusterCenter[j] / clusterArea - center[j]) * clusterNormal[j];
+		}
+	}
+
+	// Clusters facing outwards go first, since they are likely to occlude
+	// the rest of the mesh
+	std::stable_sort(clusters.begin(), clusters.end(),
+		[](const SOverdrawCluster& a, const SOverdrawCluster& b) {
+			return a.Sort > b.Sort;
+		});
+
+	std::vector<SVertex*> reordered;
+	reordered.reserve(data.size());
+
+	for (const SOverdrawCluster& c : clusters)
+	{
+		reordered.insert(reordered.end(), data.begin() + c.Begin * 3, data.begin() + c.End * 3);
+	}
+
+	data = std::move(reordered);
+	return true;
+}
+
+void OptimizeOverdraw(SModel* model)
+{
+	for (SMesh* mesh : model->Meshes)
+	{
+		OptimizeOverdraw(mesh);
+	}
+}
+
+/** Depth buffers of a pair of opposite views along one axis. */
+struct SOverdrawBuffer
+{
+	SOverdrawBuffer()
+		: Depth(BBMOD_OVERDRAW_VIEWPORT * BBMOD_OVERDRAW_VIEWPORT * 2, FLT_MAX)
+		, Shaded(BBMOD_OVERDRAW_VIEWPORT * BBMOD_OVERDRAW_VIEWPORT * 2, 0)
+	{
+	}
+
+	std::vector<float> Depth;
+
+	std::vector<uint32_t> Shaded;
+};
+
+/**
+ * Rasterizes a triangle given in pixel coordinates, with depth already
+ * converted so that smaller values are closer to the view.
+ */
+static void Rasterize(SOverdrawBuffer& buffer, size_t view, const float* x, const float* y, const float* z)
+{
+	float area = (x[1] - x[0]) * (y[2] - y[0]) - (x[2] - x[0]) * (y[1] - y[0]);
+	if (area == 0.0f)
+	{
+		return;
+	}
+
+	int minX = std::max((int)std::floor(std::min({ x[0], x[1], x[2] })), 0);
+	int minY = std::max((int)std::floor(std::min({ y[0], y[1], y[2] })), 0);
+	int maxX = std::min((int)std::ceil(std::max({ x[0], x[1], x[2] })), BBMOD_OVERDRAW_VIEWPORT - 1);
+	int maxY = std::min((int)std::ceil(std::max({ y[0], y[1], y[2] })), BBMOD_OVERDRAW_VIEWPORT - 1);
+
+	float* depth = &buffer.Depth[view * BBMOD_OVERDRAW_VIEWPORT * BBMOD_OVERDRAW_VIEWPORT];
+	uint32_t* shaded = &buffer.Shaded[view * BBMOD_OVERDRAW_VIEWPORT * BBMOD_OVERDRAW_VIEWPORT];
+
+	for (int py = minY; py <= maxY; ++py)
+	{
+		for (int px = minX; px <= maxX; ++px)
+		{
+			float cx = (float)px + 0.5f;
+			float cy = (float)py + 0.5f;
+
+			// Barycentric coordinates of the pixel center
+			float w0 = ((x[1] - cx) * (y[2] - cy) - (x[2] - cx) * (y[1] - cy)) / area;
+			float w1 = ((x[2] - cx) * (y[0] - cy) - (x[0] - cx) * (y[2] - cy)) / area;
+			float w2 = 1.0f - w0 - w1;
+
+			if (w0 < 0.0f || w1 < 0.0f || w2 < 0.0f)
+			{
+				continue;
+			}
+
+			float d = w0 * z[0] + w1 * z[1] + w2 * z[2];
+			size_t index = (size_t)py * BBMOD_OVERDRAW_VIEWPORT + (size_t)px;
+
+			if (d < depth[index])
+			{
+				depth[index] = d;
+				++shaded[index];
+			}
+		}
+	}
+}
+
+float AnalyzeOverdraw(const SModel* model)
+{
+	vec3_t min = { FLT_MAX, FLT_MAX, FLT_MAX };
+	vec3_t max = { -FLT_MAX, -FLT_MAX, -FLT_MAX };
+
+	std::vector<std::vector<const SVertex*>> triangleLists(model->Meshes.size());
+
+	for (size_t i = 0; i < model->Meshes.size(); ++i)
+	{
+		model->Meshes[i]->GetTriangleList(triangleLists[i]);
+
+		for (const SVertex* vertex : triangleLists[i])
+		{
+			for (size_t j = 0; j < 3; ++j)
+			{
+				min[j] = std::min(min[j], vertex->Position[j]);
+				max[j] = std::max(max[j], vertex->Position[j]);
+			}
+		}
+	}
+
+	float extent = 0.0f;
+	for (size_t i = 0; i < 3; ++i)
+	{
+		extent = std::max(extent, max[i] - min[i]);
+	}
+
+	if (extent <= 0.0f)
+	{
+		return 0.0f;
+	}
+
+	float scale = (float)BBMOD_OVERDRAW_VIEWPORT / extent;
+	size_t covered = 0;
+	size_t shaded = 0;
+
+	for (size_t axis = 0; axis < 3; ++axis)
+	{
+		size_t axisX = (axis + 1) % 3;
+		size_t axisY = (axis + 2) % 3;
+
+		SOverdrawBuffer buffer;
+
+		for (const std::vector<const SVertex*>& triangles : triangleLists)
+		{
+			for (size_t i = 0; i + 2 < triangles.size(); i += 3)
+			{
+				const SVertex* const* triangle = &triangles[i];
+
+				vec3_t normal;
+				TriangleNormal(triangle[0]->Position, triangle[1]->Position, triangle[2]->Position, normal);
+				if (normal[axis] == 0.0f)
+				{
+					continue;
+				}
+
+				// Triangles facing the positive direction of the axis are
+				// seen from there, so larger coordinates are closer
+				size_t view = (normal[axis] > 0.0f) ? 0 : 1;
+				float sign = (view == 0) ? -1.0f : 1.0f;
+
+				float x[3], y[3], z[3];
+				for (size_t j = 0; j < 3; ++j)
+				{
+					const float* position = triangle[j]->Position;
+					x[j] = (position[axisX] - min[axisX]) * scale;
+					y[j] = (position[axisY] - min[axisY]) * scale;
+					z[j] = position[axis] * sign;
+				}
+
+				Rasterize(buffer, view, x, y, z);
+			}
+		}
+
+		for (uint32_t count : buffer.Shaded)
+		{
+			covered += (count > 0);
+			shaded += count;
+		}
+	}
+
+	return (covered > 0) ? (float)shaded / (float)covered : 0.0f;
+}
@@ -0,0 +1,302 @@
+#include <BBMOD/Pose.hpp>
+#include <BBMOD/Math.hpp>
+
+#include <algorithm>
+
+/**
+ * Finds a key preceding given time and the key following it. The search
+ * starts at the key used last time and wraps around, same as in
+ * BBMOD_AnimationPlayer.animate.
+ */
+template<typename T>
+static size_t FindKeys(const std::vector<T*>& keys, double time, size_t index, T*& key, T*& keyNext)
+{
+	size_t size = keys.size();
+
+	key = nullptr;
+	keyNext = nullptr;
+
+	if (size == 0)
+	{
+		return 0;
+	}
+
+	for (size_t i = 0; i < size; ++i)
+	{
+		if (index + 1 >= size)
+		{
+			index = 0;
+		}
+		key = keys[index];
+		keyNext = keys[std::min(index + 1, size - 1)];
+		if (time < keyNext->Time)
+		{
+			break;
+		}
+		++index;
+	}
+
+	return index;
+}
+
+/**
+ * Returns the interpolation factor between two keys, clamped to [0, 1] like in
+ * bbmod_get_animation_key_interpolation_factor, so times past the last key do
+ * not extrapolate.
+ */
+static inline float GetFactor(const SAnimationKey* key, const SAnimationKey* keyNext, double time)
+{
+	double delta = keyNext->Time - key->Time;
+	if (delta == 0.0)
+	{
+		return 0.0f;
+	}
+	return (float)std::min(std::max((time - key->Time) / delta, 0.0), 1.0);
+}
+
+/** Finds a node with given index in a subtree of nodes. */
+static const SNode* FindNode(const SNode* node, size_t index)
+{
+	if ((size_t)node->Index == index)
+	{
+		return node;
+	}
+	for (const SNode* child : node->Children)
+	{
+		const SNode* found = FindNode(child, index);
+		if (found)
+		{
+			return found;
+		}
+	}
+	return nullptr;
+}
+
+static void SetSubtreeWeight(std::vector<float>& weights, const SNode* node, float weight)
+{
+	size_t index = (size_t)node->Index;
+	if (index < weights.size())
+	{
+		weights[index] = weight;
+	}
+	for (const SNode* child : node->Children)
+	{
+		SetSubtreeWeight(weights, child, weight);
+	}
+}
+
+SPoseMask::SPoseMask(const SModel* model)
+	: Model(model)
+	, Weights(model->NodeCount, 0.0f)
+{
+}
+
+bool SPoseMask::SetWeight(size_t index, float weight, bool children)
+{
+	const SNode* node = Model->RootNode ? FindNode(Model->RootNode, index) : nullptr;
+	if (!node || index >= Weights.size())
+	{
+		return false;
+	}
+
+	if (children)
+	{
+		SetSubtreeWeight(Weights, node, weight);
+	}
+	else
+	{
+		Weights[index] = weight;
+	}
+
+	return true;
+}
+
+SPose::SPose(const SModel* model)
+	: Model(model)
+	, Positions(model->NodeCount * 3, 0.0f)
+	, Rotations(model->NodeCount * 4, 0.0f)
+	, Animated(model->NodeCount, 0)
+	, PositionKeyLast(model->NodeCount, 0)
+	, RotationKeyLast(model->NodeCount, 0)
+	, NodeMatrix(model->NodeCount * 16, 0.0f)
+	, NodeTransform(model->NodeCount * 16, 0.0f)
+{
+	Stack.reserve(model->NodeCount);
+}
+
+void SPose::Sample(const SAnimation* animation, double time, bool interpolate)
+{
+	if (animation != AnimationLast || time < TimeLast)
+	{
+		std::fill(PositionKeyLast.begin(), PositionKeyLast.end(), 0);
+		std::fill(RotationKeyLast.begin(), RotationKeyLast.end(), 0);
+		AnimationLast = animation;
+	}
+	TimeLast = time;
+
+	size_t nodeCount = std::min(Model->NodeCount, animation->AnimationNodes.size());
+
+	for (size_t i = 0; i < nodeCount; ++i)
+	{
+		const SAnimationNode* animationNode = animation->AnimationNodes[i];
+
+		if (!animationNode
+			|| animationNode->PositionKeys.empty()
+			|| animationNode->RotationKeys.empty())
+		{
+			Animated[i] = 0;
+			continue;
+		}
+
+		Animated[i] = 1;
+
+		// Position
+		SPositionKey* positionKey = nullptr;
+		SPositionKey* positionKeyNext = nullptr;
+		PositionKeyLast[i] = FindKeys(animationNode->PositionKeys, time,
+			PositionKeyLast[i], positionKey, positionKeyNext);
+
+		float* position = &Positions[i * 3];
+
+		if (interpolate)
+		{
+			float factor = GetFactor(positionKey, positionKeyNext, time);
+			position[0] = LERP(positionKey->Position[0], positionKeyNext->Position[0], factor);
+			position[1] = LERP(positionKey->Position[1], positionKeyNext->Position[1], factor);
+			position[2] = LERP(positionKey->Position[2], positionKeyNext->Position[2], factor);
+		}
+		else
+		{
+			vec3_copy(positionKey->Position, position);
+		}
+
+		// Rotation
+		SRotationKey* rotationKey = nullptr;
+		SRotationKey* rotationKeyNext = nullptr;
+		RotationKeyLast[i] = FindKeys(animationNode->RotationKeys, time,
+			RotationKeyLast[i], rotationKey, rotationKeyNext);
+
+		float* rotation = &Rotations[i * 4];
+		quaternion_copy(rotationKey->Rotation, rotation);
+
+		if (interpolate)
+		{
+			float factor = GetFactor(rotationKey, rotationKeyNext, time);
+			quaternion_slerp(rotation, rotationKeyNext->Rotation, factor);
+		}
+	}
+
+	for (size_t i = nodeCount; i < Model->NodeCount; ++i)
+	{
+		Animated[i] = 0;
+	}
+}
+
+void SPose::Copy(const SPose& other)
+{
+	// Same model, so the vectors are only overwritten and nothing is allocated
+	Positions = other.Positions;
+	Rotations = other.Rotations;
+	Animated = other.Animated;
+}
+
+void SPose::Blend(const SPose& other, float factor, const SPoseMask* mask)
+{
+	size_t nodeCount = std::min(Animated.size(), other.Animated.size());
+	if (mask)
+	{
+		nodeCount = std::min(nodeCount, mask->Weights.size());
+	}
+
+	for (size_t i = 0; i < nodeCount; ++i)
+	{
+		float weight = mask ? factor * mask->Weights[i] : factor;
+
+		if (weight <= 0.0f || !other.Animated[i])
+		{
+			continue;
+		}
+
+		float* position = &Positions[i * 3];
+		float* rotation = &Rotations[i * 4];
+		const float* positionOther = &other.Positions[i * 3];
+		const float* rotationOther = &other.Rotations[i * 4];
+
+		if (!Animated[i] || weight >= 1.0f)
+		{
+			vec3_copy(positionOther, position);
+			quaternion_copy(rotationOther, rotation);
+			Animated[i] = 1;
+			continue;
+		}
+
+		position[0] = LERP(position[0], positionOther[0], weight);
+		position[1] = LERP(position[1], positionOther[1], weight);
+		position[2] = LERP(position[2], positionOther[2], weight);
+
+		// Nlerp along the shorter arc
+		float weightOther = (quaternion_dot(rotation, rotationOther) < 0.0f) ? -weight : weight;
+		rotation[0] = (rotation[0] * (1.0f - weight)) + (rotationOther[0] * weightOther);
+		rotation[1] = (rotation[1] * (1.0f - weight)) + (rotationOther[1] * weightOther);
+		rotation[2] = (rotation[2] * (1.0f - weight)) + (rotationOther[2] * weightOther);
+		rotation[3] = (rotation[3] * (1.0f - weight)) + (rotationOther[3] * weightOther);
+		quaternion_normalize(rotation);
+	}
+}
+
+void SPose::Transform(float* transform)
+{
+	matrix_t local = MATRIX_IDENTITY;
+	const size_t noParent = (size_t)-1;
+
+	Stack.clear();
+	Stack.push_back({ Model->RootNode, noParent });
+
+	while (!Stack.empty())
+	{
+		const SNode* node = Stack.back().first;
+		size_t parent = Stack.back().second;
+		Stack.pop_back();
+
+		size_t index = (size_t)node->Index;
+		if (index >= Model->NodeCount)
+		{
+			continue;
+		}
+
+		const float* nodeTransform = node->TransformMatrix;
+
+		if (Animated[index])
+		{
+			const float* position = &Positions[index * 3];
+			quaternion_to_matrix(&Rotations[index * 4], local);
+			local[12] = position[0];
+			local[13] = position[1];
+			local[14] = position[2];
+			nodeTransform = local;
+		}
+
+		float* matrix = &NodeMatrix[index * 16];
+		matrix_copy(nodeTransform, matrix);
+		if (parent != noParent)
+		{
+			matrix_multiply(matrix, &NodeMatrix[parent * 16]);
+		}
+
+		float* finalTransform = &NodeTransform[index * 16];
+		matrix_copy(matrix, finalTransform);
+		matrix_multiply(finalTransform, Model->InverseTransformMatrix);
+
+		if (node->IsBone && index < Model->BoneCount)
+		{
+			float* boneTransform = &transform[index * 16];
+			matrix_copy(Model->Skeleton[index]->OffsetMatrix, boneTransform);
+			matrix_multiply(boneTransform, finalTransform);
+		}
+
+		for (const SNode* child : node->Children)
+		{
+			Stack.push_back({ child, index });
+		}
+	}
+}
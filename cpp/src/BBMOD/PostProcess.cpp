@@ -0,0 +1,508 @@
+#include <BBMOD/PostProcess.hpp>
+
+#include <algorithm>
+#include <cmath>
+#include <cstdint>
+#include <cstring>
+#include <vector>
+
+#define X_PI 3.14159265359f
+
+static inline float Dot(const float* a, const float* b)
+{
+	return (a[0] * b[0] + a[1] * b[1] + a[2] * b[2]);
+}
+
+static inline void Cross(const float* a, const float* b, float* out)
+{
+	out[0] = a[1] * b[2] - a[2] * b[1];
+	out[1] = a[2] * b[0] - a[0] * b[2];
+	out[2] = a[0] * b[1] - a[1] * b[0];
+}
+
+/** Normalizes a vector, leaving zero vectors as they are. */
+static inline void Normalize(float* v)
+{
+	float length = std::sqrt(Dot(v, v));
+	if (length > 0.0f)
+	{
+		v[0] /= length;
+		v[1] /= length;
+		v[2] /= length;
+	}
+}
+
+static inline bool IsZero(const float* v)
+{
+	return (v[0] == 0.0f && v[1] == 0.0f && v[2] == 0.0f);
+}
+
+/** Returns the angle between edges of a triangle at vertex a. */
+static inline float GetCornerAngle(const float* a, const float* b, const float* c)
+{
+	vec3_t ab, ac;
+	for (size_t i = 0; i < 3; ++i)
+	{
+		ab[i] = b[i] - a[i];
+		ac[i] = c[i] - a[i];
+	}
+	Normalize(ab);
+	Normalize(ac);
+	return std::acos(std::min(std::max(Dot(ab, ac), -1.0f), 1.0f));
+}
+
+/** Hashes bits of a position, mixed well enough to select a shard. */
+static inline uint64_t HashPosition(const float* position)
+{
+	uint32_t bits[3];
+	std::memcpy(bits, position, sizeof(bits));
+	uint64_t h = bits[0];
+	h = h * 0x9E3779B97F4A7C15ull ^ bits[1];
+	h = h * 0x9E3779B97F4A7C15ull ^ bits[2];
+	h ^= h >> 31;
+	h *= 0xBF58476D1CE4E5B9ull;
+	h ^= h >> 29;
+	return h;
+}
+
+static inline size_t GetShard(uint64_t hash)
+{
+	return (size_t)(hash % BBMOD_POST_PROCESS_SHARD_COUNT);
+}
+
+/** Vertices of a mesh grouped by bit-identical positions. */
+struct SPositionGroups
+{
+	/**
+	 * Indices of vertices, ordered so that vertices with the same position
+	 * are next to each other.
+	 */
+	std::vector<size_t> Order;
+
+	/** For each vertex, the range of Order with vertices of its position. */
+	std::vector<std::pair<size_t, size_t>> Groups;
+};
+
+/**
+ * Groups vertices of a mesh by their positions. Vertices are distributed into
+ * shards by hashes of their positions and each shard is sorted by a separate
+ * job.
+ */
+static void GroupPositions(const SMesh* mesh, SPositionGroups& groups, SJobSystem& jobSystem)
+{
+	const std::vector<SVertex*>& vertices = mesh->Data;
+	size_t vertexCount = vertices.size();
+
+	std::vector<uint64_t> hashes(vertexCount);
+
+	jobSystem.Dispatch(vertexCount, BBMOD_POST_PROCESS_BATCH_SIZE, [&](size_t begin, size_t end) {
+		for (size_t i = begin; i < end; ++i)
+		{
+			hashes[i] = HashPosition(vertices[i]->Position);
+		}
+	});
+	jobSystem.Wait();
+
+	std::vector<size_t> shardStart(BBMOD_POST_PROCESS_SHARD_COUNT + 1, 0);
+	for (size_t i = 0; i < vertexCount; ++i)
+	{
+		++shardStart[GetShard(hashes[i]) + 1];
+	}
+	for (size_t i = 0; i < BBMOD_POST_PROCESS_SHARD_COUNT; ++i)
+	{
+		shardStart[i + 1] += shardStart[i];
+	}
+
+	std::vector<size_t> shardNext(shardStart.begin(), shardStart.end() - 1);
+	groups.Order.resize(vertexCount);
+	for (size_t i = 0; i < vertexCount; ++i)
+	{
+		groups.Order[shardNext[GetShard(hashes[i])]++] = i;
+	}
+
+	groups.Groups.resize(vertexCount);
+
+	auto samePosition = [&](size_t a, size_t b) {
+		return (hashes[a] == hashes[b]
+			&& !std::memcmp(vertices[a]->Position, vertices[b]->Position, sizeof(vec3_t)));
+	};
+
+	jobSystem.Dispatch(BBMOD_POST_PROCESS_SHARD_COUNT, 1, [&](size_t begin, size_t end) {
+		for (size_t shard = begin; shard < end; ++shard)
+		{
+			size_t first = shardStart[shard];
+			size_t last = shardStart[shard + 1];
+
+			std::sort(groups.Order.begin() + first, groups.Order.begin() + last,
+				[&](size_t a, size_t b) {
+					if (hashes[a] != hashes[b])
+					{
+						return hashes[a] < hashes[b];
+					}
+					int compare = std::memcmp(vertices[a]->Position, vertices[b]->Position, sizeof(vec3_t));
+					return (compare != 0) ? (compare < 0) : (a < b);
+				});
+
+			for (size_t i = first; i < last;)
+			{
+				size_t j = i + 1;
+				while (j < last && samePosition(groups.Order[i], groups.Order[j]))
+				{
+					++j;
+				}
+				for (size_t k = i; k < j; ++k)
+				{
+					groups.Groups[groups.Order[k]] = { i, j };
+				}
+				i = j;
+			}
+		}
+	});
+	jobSystem.Wait();
+}
+
+/** Remaps mesh indices of a node and its children. */
+static void RemapMeshes(SNode* node, const std::vector<size_t>& remap)
+{
+	std::vector<size_t> meshes;
+	for (size_t meshIndex : node->Meshes)
+	{
+		if (remap[meshIndex] != SIZE_MAX)
+		{
+			meshes.push_back(remap[meshIndex]);
+		}
+	}
+	node->Meshes = meshes;
+
+	for (SNode* child : node->Children)
+	{
+		RemapMeshes(child, remap);
+	}
+}
+
+size_t RemoveDegenerates(SModel* model, SJobSystem& jobSystem)
+{
+	size_t removed = 0;
+	size_t meshCount = model->Meshes.size();
+	std::vector<size_t> remap(meshCount, SIZE_MAX);
+	std::vector<SMesh*> meshes;
+
+	for (size_t m = 0; m < meshCount; ++m)
+	{
+		SMesh* mesh = model->Meshes[m];
+		std::vector<SVertex*>& vertices = mesh->Data;
+		size_t triangleCount = vertices.size() / 3;
+
+		if (mesh->PrimitiveType == BBMOD_PRIMITIVE_TRIANGLE_LIST && triangleCount > 0)
+		{
+			std::vector<uint8_t> degenerate(triangleCount, 0);
+
+			jobSystem.Dispatch(triangleCount, BBMOD_POST_PROCESS_BATCH_SIZE, [&](size_t begin, size_t end) {
+				for (size_t i = begin; i < end; ++i)
+				{
+					const float* a = vertices[i * 3]->Position;
+					const float* b = vertices[i * 3 + 1]->Position;
+					const float* c = vertices[i * 3 + 2]->Position;
+
+					vec3_t ab, ac, normal;
+					for (size_t j = 0; j < 3; ++j)
+					{
+						ab[j] = b[j] - a[j];
+						ac[j] = c[j] - a[j];
+					}
+					Cross(ab, ac, normal);
+
+					degenerate[i] = (IsZero(ab) || IsZero(ac) || IsZero(normal)) ? 1 : 0;
+				}
+			});
+			jobSystem.Wait();
+
+			size_t next = 0;
+			for (size_t i = 0; i < triangleCount; ++i)
+			{
+				if (degenerate[i])
+				{
+					for (size_t j = 0; j < 3; ++j)
+					{
+						delete vertices[i * 3 + j];
+					}
+					++removed;
+					continue;
+				}
+				for (size_t j = 0; j < 3; ++j)
+				{
+					vertices[next++] = vertices[i * 3 + j];
+				}
+			}
+			vertices.resize(next);
+
+			if (vertices.empty())
+			{
+				delete mesh;
+				continue;
+			}
+		}
+
+		remap[m] = meshes.size();
+		meshes.push_back(mesh);
+	}
+
+	if (meshes.size() != meshCount)
+	{
+		RemapMeshes(model->RootNode, remap);
+		model->Meshes = meshes;
+	}
+
+	return removed;
+}
+
+/** A normal of a triangle and its angle at one of its vertices. */
+struct SNormalCorner
+{
+	vec3_t Normal;
+
+	float Angle = 0.0f;
+};
+
+size_t GenerateNormals(SModel* model, float angle, bool flip, SJobSystem& jobSystem)
+{
+	float cosAngle = std::cos(angle * X_PI / 180.0f);
+	size_t generated = 0;
+	SPositionGroups groups;
+
+	for (SMesh* mesh : model->Meshes)
+	{
+		if (mesh->VertexFormat->Normals
+			|| mesh->PrimitiveType != BBMOD_PRIMITIVE_TRIANGLE_LIST)
+		{
+			continue;
+		}
+
+		std::vector<SVertex*>& vertices = mesh->Data;
+		size_t vertexCount = vertices.size();
+		std::vector<SNormalCorner> corners(vertexCount);
+
+		jobSystem.Dispatch(vertexCount / 3, BBMOD_POST_PROCESS_BATCH_SIZE, [&](size_t begin, size_t end) {
+			for (size_t i = begin; i < end; ++i)
+			{
+				const SVertex* triangle[3] = { vertices[i * 3], vertices[i * 3 + 1], vertices[i * 3 + 2] };
+
+				vec3_t ab, ac, normal;
+				for (size_t j = 0; j < 3; ++j)
+				{
+					ab[j] = triangle[1]->Position[j] - triangle[0]->Position[j];
+					ac[j] = triangle[2]->Position[j] - triangle[0]->Position[j];
+				}
+				Cross(ab, ac, normal);
+				Normalize(normal);
+				if (flip)
+				{
+					for (size_t j = 0; j < 3; ++j)
+					{
+						normal[j] = -normal[j];
+					}
+				}
+
+				for (size_t j = 0; j < 3; ++j)
+				{
+					SNormalCorner& corner = corners[i * 3 + j];
+					vec3_copy(normal, corner.Normal);
+					corner.Angle = GetCornerAngle(triangle[j]->Position,
+						triangle[(j + 1) % 3]->Position, triangle[(j + 2) % 3]->Position);
+				}
+			}
+		});
+		jobSystem.Wait();
+
+		GroupPositions(mesh, groups, jobSystem);
+
+		jobSystem.Dispatch(vertexCount, BBMOD_POST_PROCESS_BATCH_SIZE, [&](size_t begin, size_t end) {
+			for (size_t i = begin; i < end; ++i)
+			{
+				const SNormalCorner& corner = corners[i];
+				vec3_t normal = VEC3_ZERO;
+
+				for (size_t k = groups.Groups[i].first; k < groups.Groups[i].second; ++k)
+				{
+					size_t other = groups.Order[k];
+					const SNormalCorner& otherCorner = corners[other];
+					if (other == i || Dot(corner.Normal, otherCorner.Normal) >= cosAngle)
+					{
+						for (size_t j = 0; j < 3; ++j)
+						{
+							normal[j] += otherCorner.Normal[j] * otherCorner.Angle;
+						}
+					}
+				}
+
+				Normalize(normal);
+				vec3_copy(IsZero(normal) ? corner.Normal : normal, vertices[i]->Normal);
+			}
+		});
+		jobSystem.Wait();
+
+		mesh->VertexFormat->Normals = true;
+		model->VertexFormat->Normals = true;
+		++generated;
+	}
+
+	return generated;
+}
+
+/** A tangent of a triangle orthogonalized against a vertex normal. */
+struct STangentCorner
+{
+	vec3_t Tangent;
+
+	float BitangentSign = 1.0f;
+
+	float Angle = 0.0f;
+};
+
+/** Writes a unit vector perpendicular to a normal into out. */
+static inline void GetPerpendicular(const float* normal, float* out)
+{
+	vec3_t axis = { 1.0f, 0.0f, 0.0f };
+	if (std::abs(normal[0]) > 0.9f)
+	{
+		axis[0] = 0.0f;
+		axis[1] = 1.0f;
+	}
+	Cross(normal, axis, out);
+	Normalize(out);
+}
+
+size_t GenerateTangents(SModel* model, bool flipHorizontally, bool flipVertically,
+	SJobSystem& jobSystem)
+{
+	// Directions of the original texture coordinates
+	float signU = flipHorizontally ? -1.0f : 1.0f;
+	float signV = flipVertically ? -1.0f : 1.0f;
+
+	size_t generated = 0;
+	SPositionGroups groups;
+
+	for (SMesh* mesh : model->Meshes)
+	{
+		const SVertexFormat* vertexFormat = mesh->VertexFormat;
+
+		if (vertexFormat->TangentW
+			|| !vertexFormat->Normals
+			|| !vertexFormat->TextureCoords
+			|| mesh->PrimitiveType != BBMOD_PRIMITIVE_TRIANGLE_LIST)
+		{
+			continue;
+		}
+
+		std::vector<SVertex*>& vertices = mesh->Data;
+		size_t vertexCount = vertices.size();
+		std::vector<STangentCorner> corners(vertexCount);
+
+		jobSystem.Dispatch(vertexCount / 3, BBMOD_POST_PROCESS_BATCH_SIZE, [&](size_t begin, size_t end) {
+			for (size_t i = begin; i < end; ++i)
+			{
+				const SVertex* triangle[3] = { vertices[i * 3], vertices[i * 3 + 1], vertices[i * 3 + 2] };
+
+				vec3_t e1, e2;
+				for (size_t j = 0; j < 3; ++j)
+				{
+					e1[j] = triangle[1]->Position[j] - triangle[0]->Position[j];
+					e2[j] = triangle[2]->Position[j] - triangle[0]->Position[j];
+				}
+				float du1 = (triangle[1]->Texture[0] - triangle[0]->Texture[0]) * signU;
+				float dv1 = (triangle[1]->Texture[1] - triangle[0]->Texture[1]) * signV;
+				float du2 = (triangle[2]->Texture[0] - triangle[0]->Texture[0]) * signU;
+				float dv2 = (triangle[2]->Texture[1] - triangle[0]->Texture[1]) * signV;
+
+				// Triangles with degenerate texture coordinates do not contribute
+				vec3_t tangent = VEC3_ZERO;
+				vec3_t bitangent = VEC3_ZERO;
+				float det = du1 * dv2 - du2 * dv1;
+				if (det != 0.0f)
+				{
+					for (size_t j = 0; j < 3; ++j)
+					{
+						tangent[j] = (e1[j] * dv2 - e2[j] * dv1) / det;
+						bitangent[j] = (e2[j] * du1 - e1[j] * du2) / det;
+					}
+				}
+
+				for (size_t j = 0; j < 3; ++j)
+				{
+					const float* normal = triangle[j]->Normal;
+					STangentCorner& corner = corners[i * 3 + j];
+
+					float d = Dot(tangent, normal);
+					for (size_t k = 0; k < 3; ++k)
+					{
+						corner.Tangent[k] = tangent[k] - normal[k] * d;
+					}
+					Normalize(corner.Tangent);
+
+					vec3_t cross;
+					Cross(normal, corner.Tangent, cross);
+					corner.BitangentSign = (Dot(cross, bitangent) < 0.0f) ? -1.0f : 1.0f;
+
+					corner.Angle = IsZero(corner.Tangent)
+						? 0.0f
+						: GetCornerAngle(triangle[j]->Position,
+							triangle[(j + 1) % 3]->Position, triangle[(j + 2) % 3]->Position);
+				}
+			}
+		});
+		jobSystem.Wait();
+
+		GroupPositions(mesh, groups, jobSystem);
+
+		jobSystem.Dispatch(vertexCount, BBMOD_POST_PROCESS_BATCH_SIZE, [&](size_t begin, size_t end) {
+			for (size_t i = begin; i < end; ++i)
+			{
+				SVertex* vertex = vertices[i];
+				const STangentCorner& corner = corners[i];
+				vec3_t tangent = VEC3_ZERO;
+
+				for (size_t k = groups.Groups[i].first; k < groups.Groups[i].second; ++k)
+				{
+					size_t other = groups.Order[k];
+					const SVertex* otherVertex = vertices[other];
+					const STangentCorner& otherCorner = corners[other];
+
+					if (otherCorner.BitangentSign != corner.BitangentSign
+						|| std::memcmp(otherVertex->Normal, vertex->Normal, sizeof(vec3_t))
+						|| std::memcmp(otherVertex->Texture, vertex->Texture, sizeof(vec2_t)))
+					{
+						continue;
+					}
+
+					for (size_t j = 0; j < 3; ++j)
+					{
+						tangent[j] += otherCorner.Tangent[j] * otherCorner.Angle;
+					}
+				}
+
+				// Keep the tangent perpendicular to the normal
+				float d = Dot(tangent, vertex->Normal);
+				for (size_t j = 0; j < 3; ++j)
+				{
+					tangent[j] -= vertex->Normal[j] * d;
+				}
+				Normalize(tangent);
+
+				if (IsZero(tangent))
+				{
+					GetPerpendicular(vertex->Normal, tangent);
+				}
+
+				vec3_copy(tangent, vertex->Tangent);
+				vertex->BitangentSign = corner.BitangentSign;
+			}
+		});
+		jobSystem.Wait();
+
+		mesh->VertexFormat->TangentW = true;
+		model->VertexFormat->TangentW = true;
+		++generated;
+	}
+
+	return generated;
+}
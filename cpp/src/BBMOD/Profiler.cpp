@@ -0,0 +1,351 @@
+#include <BBMOD/Profiler.hpp>
+#include <utils.hpp>
+
+#include <assimp/Importer.hpp>
+#include <assimp/ProgressHandler.hpp>
+#include <assimp/DefaultLogger.hpp>
+#include <assimp/LogStream.hpp>
+
+#include <algorithm>
+#include <fstream>
+#include <iomanip>
+#include <iostream>
+#include <map>
+
+#ifdef _WIN32
+#ifndef NOMINMAX
+#define NOMINMAX
+#endif
+#include <Windows.h>
+#include <Psapi.h>
+#else
+#include <sys/resource.h>
+#endif
+
+SProfiler::SProfiler()
+	: Epoch(std::chrono::steady_clock::now())
+{
+}
+
+SProfiler& SProfiler::Get()
+{
+	static SProfiler profiler;
+	return profiler;
+}
+
+size_t SProfiler::GetPeakMemory()
+{
+#ifdef _WIN32
+	PROCESS_MEMORY_COUNTERS counters;
+	if (GetProcessMemoryInfo(GetCurrentProcess(), &counters, sizeof(counters)))
+	{
+		return (size_t)counters.PeakWorkingSetSize;
+	}
+	return 0;
+#else
+	struct rusage usage;
+	if (getrusage(RUSAGE_SELF, &usage) == 0)
+	{
+#ifdef __APPLE__
+		return (size_t)usage.ru_maxrss;
+#else
+		return (size_t)usage.ru_maxrss * 1024;
+#endif
+	}
+	return 0;
+#endif
+}
+
+uint64_t SProfiler::Now() const
+{
+	auto elapsed = std::chrono::steady_clock::now() - Epoch;
+	return (uint64_t)std::chrono::duration_cast<std::chrono::microseconds>(elapsed).count();
+}
+
+uint32_t SProfiler::GetThreadIndex()
+{
+	std::thread::id id = std::this_thread::get_id();
+	for (size_t i = 0; i < Threads.size(); ++i)
+	{
+		if (Threads[i] == id)
+		{
+			return (uint32_t)i;
+		}
+	}
+	Threads.push_back(id);
+	return (uint32_t)(Threads.size() - 1);
+}
+
+void SProfiler::AddEvent(const std::string& name, const char* category, uint64_t start)
+{
+	if (!Enabled)
+	{
+		return;
+	}
+
+	SProfilerEvent event;
+	event.Name = name;
+	event.Category = category;
+	event.Start = start;
+	event.Duration = Now() - start;
+	event.PeakMemory = GetPeakMemory();
+
+	std::lock_guard<std::mutex> lock(Mutex);
+	event.ThreadId = GetThreadIndex();
+	Events.push_back(event);
+}
+
+void SProfiler::Clear()
+{
+	std::lock_guard<std::mutex> lock(Mutex);
+	Events.clear();
+	Threads.clear();
+}
+
+void SProfiler::PrintSummary() const
+{
+	struct SSummary
+	{
+		std::string Category;
+		size_t Count = 0;
+		uint64_t Total = 0;
+		uint64_t Max = 0;
+		size_t PeakMemory = 0;
+	};
+
+	std::vector<std::string> order;
+	std::map<std::string, SSummary> summaries;
+	uint64_t wallTime = 0;
+
+	{
+		std::lock_guard<std::mutex> lock(Mutex);
+		uint64_t first = UINT64_MAX;
+		uint64_t last = 0;
+
+		for (const SProfilerEvent& event : Events)
+		{
+			auto it = summaries.find(event.Name);
+			if (it == summaries.end())
+			{
+				order.push_back(event.Name);
+				it = summaries.emplace(event.Name, SSummary()).first;
+				it->second.Category = event.Category;
+			}
+			SSummary& summary = it->second;
+			++summary.Count;
+			summary.Total += event.Duration;
+			summary.Max = std::max(summary.Max, event.Duration);
+			summary.PeakMemory = std::max(summary.PeakMemory, event.PeakMemory);
+			first = std::min(first, event.Start);
+			last = std::max(last, event.Start + event.Duration);
+		}
+
+		wallTime = (last > first) ? (last - first) : 0;
+	}
+
+	std::ios_base::fmtflags flags = std::cout.flags();
+
+	std::cout << std::endl
+		<< std::left << std::setw(40) << "Event"
+		<< std::setw(10) << "Category"
+		<< std::right << std::setw(8) << "Count"
+		<< std::setw(12) << "Total [ms]"
+		<< std::setw(12) << "Max [ms]"
+		<< std::setw(9) << "Wall %"
+		<< std::setw(12) << "Peak [MB]" << std::endl
+		<< std::string(103, '-') << std::endl
+		<< std::fixed;
+
+	for (const std::string& name : order)
+	{
+		const SSummary& summary = summaries[name];
+		double percent = wallTime ? (100.0 * summary.Total / wallTime) : 0.0;
+
+		std::cout
+			<< std::left << std::setw(40) << name.substr(0, 39)
+			<< std::setw(10) << summary.Category
+			<< std::right << std::setw(8) << summary.Count
+			<< std::setprecision(3)
+			<< std::setw(12) << summary.Total / 1000.0
+			<< std::setw(12) << summary.Max / 1000.0
+			<< std::setprecision(1)
+			<< std::setw(9) << percent
+			<< std::setw(12) << summary.PeakMemory / (1024.0 * 1024.0)
+			<< std::endl;
+	}
+
+	std::cout << std::string(103, '-') << std::endl
+		<< "Wall time: " << std::setprecision(3) << wallTime / 1000.0 << " ms, "
+		<< "peak memory: " << std::setprecision(1) << GetPeakMemory() / (1024.0 * 1024.0) << " MB"
+		<< std::endl << std::endl;
+
+	std::cout.flags(flags);
+}
+
+bool SProfiler::SaveTrace(std::string path) const
+{
+	std::ofstream file(path, std::ios::out);
+
+	if (!file.is_open())
+	{
+		return false;
+	}
+
+	std::lock_guard<std::mutex> lock(Mutex);
+
+	file << "{\"displayTimeUnit\":\"ms\",\"traceEvents\":[";
+
+	for (size_t i = 0; i < Events.size(); ++i)
+	{
+		const SProfilerEvent& event = Events[i];
+		file << ((i > 0) ? ",\n" : "\n")
+			<< "{\"name\":\"" << JsonEscape(event.Name) << "\""
+			<< ",\"cat\":\"" << JsonEscape(event.Category) << "\""
+			<< ",\"ph\":\"X\""
+			<< ",\"ts\":" << event.Start
+			<< ",\"dur\":" << event.Duration
+			<< ",\"pid\":1"
+			<< ",\"tid\":" << event.ThreadId
+			<< ",\"args\":{\"peakMemory\":" << event.PeakMemory << "}}";
+	}
+
+	file << "\n]}" << std::endl;
+	file.close();
+
+	return true;
+}
+
+SProfileScope::SProfileScope(const char* name, const char* category)
+	: Name(name)
+	, Category(category)
+{
+	if (SProfiler::Get().IsEnabled())
+	{
+		Start = SProfiler::Get().Now();
+	}
+}
+
+SProfileScope::~SProfileScope()
+{
+	SProfiler& profiler = SProfiler::Get();
+	if (profiler.IsEnabled())
+	{
+		profiler.AddEvent(Name, Category, Start);
+	}
+}
+
+/** Records time of file reading reported by Assimp's progress callbacks.
+ * Post-processing steps are recorded by SProfilerLogStream under their
+ * names. */
+struct SProfilerProgressHandler : public Assimp::ProgressHandler
+{
+	bool Update(float) override
+	{
+		return true;
+	}
+
+	void UpdateFileRead(int currentStep, int numberOfSteps) override
+	{
+		SProfiler& profiler = SProfiler::Get();
+		if (currentStep == 0)
+		{
+			FileReadStart = profiler.Now();
+		}
+		else if (currentStep >= numberOfSteps)
+		{
+			profiler.AddEvent("ReadFile", "assimp", FileReadStart);
+		}
+	}
+
+	uint64_t FileReadStart = 0;
+};
+
+/**
+ * Records times of named post-processing steps from Assimp's debug log
+ * messages, which come in pairs like "JoinVerticesProcess begin" and
+ * "JoinVerticesProcess finished".
+ */
+struct SProfilerLogStream : public Assimp::LogStream
+{
+	void write(const char* message) override
+	{
+		std::string str = message;
+
+		// Strip "Debug, T0: " prefix
+		size_t pos = str.find(": ");
+		if (pos != std::string::npos)
+		{
+			str = str.substr(pos + 2);
+		}
+
+		size_t space = str.find(' ');
+		if (space == std::string::npos)
+		{
+			return;
+		}
+
+		std::string name = str.substr(0, space);
+		std::string rest = str.substr(space + 1);
+
+		if (name.size() < 8 || name.compare(name.size() - 7, 7, "Process") != 0)
+		{
+			return;
+		}
+
+		SProfiler& profiler = SProfiler::Get();
+		std::lock_guard<std::mutex> lock(Mutex);
+
+		if (rest.compare(0, 5, "begin") == 0)
+		{
+			Open[name] = profiler.Now();
+		}
+		else if (rest.compare(0, 8, "finished") == 0 || rest.compare(0, 3, "end") == 0)
+		{
+			auto it = Open.find(name);
+			if (it != Open.end())
+			{
+				profiler.AddEvent(name, "assimp", it->second);
+				Open.erase(it);
+			}
+		}
+	}
+
+	std::mutex Mutex;
+
+	std::map<std::string, uint64_t> Open;
+};
+
+/** True if the Assimp logger was created by ProfileAssimpImporter. */
+static bool gProfilerOwnsLogger = false;
+
+void ProfileAssimpImporter(Assimp::Importer* importer)
+{
+	if (!SProfiler::Get().IsEnabled())
+	{
+		return;
+	}
+
+	// The importer takes ownership of the handler
+	importer->SetProgressHandler(new SProfilerProgressHandler());
+
+	if (!Assimp::DefaultLogger::isNullLogger())
+	{
+		return;
+	}
+
+	Assimp::DefaultLogger::create(nullptr, Assimp::Logger::VERBOSE, 0);
+	gProfilerOwnsLogger = true;
+	Assimp::DefaultLogger::get()->attachStream(
+		new SProfilerLogStream(), Assimp::Logger::Debugging);
+}
+
+void ProfileAssimpImporterEnd()
+{
+	if (!gProfilerOwnsLogger)
+	{
+		return;
+	}
+
+	Assimp::DefaultLogger::kill();
+	gProfilerOwnsLogger = false;
+}
@@ -0,0 +1,213 @@
+#include <BBMOD/Report.hpp>
+#include <utils.hpp>
+
+#include <fstream>
+
+static void WriteVertexFormat(std::ofstream& file, const SVertexFormat* vformat)
+{
+	file << "{"
+		<< "\"vertices\": " << (vformat->Vertices ? "true" : "false")
+		<< ", \"normals\": " << (vformat->Normals ? "true" : "false")
+		<< ", \"textureCoords\": " << (vformat->TextureCoords ? "true" : "false")
+		<< ", \"colors\": " << (vformat->Colors ? "true" : "false")
+		<< ", \"tangentW\": " << (vformat->TangentW ? "true" : "false")
+		<< ", \"bones\": " << (vformat->Bones ? "true" : "false")
+		<< ", \"boneInfluences\": " << (vformat->Bones ? (int)vformat->BoneInfluences : 0)
+		<< ", \"ids\": " << (vformat->Ids ? "true" : "false")
+		<< ", \"vertexSize\": " << vformat->GetVertexSize()
+		<< "}";
+}
+
+static void WriteNodes(std::ofstream& file, SNode* node, int parent, bool& first)
+{
+	file << (first ? "\n" : ",\n")
+		<< "\t\t{\"index\": " << (int)node->Index
+		<< ", \"name\": \"" << JsonEscape(node->Name) << "\""
+		<< ", \"isBone\": " << (node->IsBone ? "true" : "false")
+		<< ", \"parent\": " << parent
+		<< ", \"meshes\": [";
+
+	for (size_t i = 0; i < node->Meshes.size(); ++i)
+	{
+		file << ((i > 0) ? ", " : "") << node->Meshes[i];
+	}
+
+	file << "]}";
+	first = false;
+
+	for (SNode* child : node->Children)
+	{
+		WriteNodes(file, child, (int)node->Index, first);
+	}
+}
+
+void SReport::AddWarning(int code, std::string message)
+{
+	SReportWarning warning;
+	warning.Code = code;
+	warning.Message = message;
+	Warnings.push_back(warning);
+}
+
+void SReport::AddTiming(std::string name, double milliseconds)
+{
+	Timings.push_back(std::make_pair(name, milliseconds));
+}
+
+bool SReport::Save(std::string path) const
+{
+	std::ofstream file(path, std::ios::out);
+
+	if (!file.is_open())
+	{
+		return false;
+	}
+
+	file << "{" << std::endl
+		<< "\t\"input\": \"" << JsonEscape(Input) << "\"," << std::endl
+		<< "\t\"output\": \"" << JsonEscape(Output) << "\"," << std::endl
+		<< "\t\"version\": " << (int)BBMOD_VERSION << "," << std::endl;
+
+	if (Model)
+	{
+		file << "\t\"vertexFormat\": ";
+		WriteVertexFormat(file, Model->VertexFormat);
+		file << "," << std::endl;
+
+		// Meshes
+		size_t vertexCountTotal = 0;
+		size_t triangleCountTotal = 0;
+
+		file << "\t\"meshes\": [";
+		for (size_t i = 0; i < Model->Meshes.size(); ++i)
+		{
+			SMesh* mesh = Model->Meshes[i];
+			size_t vertexCount = mesh->Data.size();
+			size_t meshSize = mesh->GetSize();
+			vertexCountTotal += vertexCount;
+			triangleCountTotal += mesh->GetTriangleCount();
+
+			file << ((i > 0) ? ",\n" : "\n")
+				<< "\t\t{\"index\": " << i
+				<< ", \"materialIndex\": " << mesh->MaterialIndex
+				<< ", \"vertexCount\": " << vertexCount
+				<< ", \"triangleCount\": " << mesh->GetTriangleCount()
+				<< ", \"triangleStrip\": " << ((mesh->PrimitiveType == BBMOD_PRIMITIVE_TRIANGLE_STRIP) ? "true" : "false")
+				<< ", \"bytes\": " << meshSize
+				<< ", \"vertexFormat\": ";
+			WriteVertexFormat(file, mesh->VertexFormat);
+			file << "}";
+		}
+		file << "\n\t]," << std::endl;
+
+		// File sections
+		SModelSections sections = Model->GetSections();
+
+		file << "\t\"sections\": {"
+			<< "\"header\": " << sections.Header
+			<< ", \"vertexFormat\": " << sections.VertexFormat
+			<< ", \"meshes\": " << sections.Meshes
+			<< ", \"inverseTransform\": " << sections.InverseTransform
+			<< ", \"nodes\": " << sections.Nodes
+			<< ", \"bones\": " << sections.Bones
+			<< ", \"materials\": " << sections.Materials
+			<< ", \"bvh\": " << sections.BVH
+			<< ", \"total\": " << sections.GetTotal()
+			<< "}," << std::endl;
+
+		file << "\t\"vertexCount\": " << vertexCountTotal << "," << std::endl
+			<< "\t\"triangleCount\": " << triangleCountTotal << "," << std::endl
+			<< "\t\"nodeCount\": " << Model->NodeCount << "," << std::endl
+			<< "\t\"boneCount\": " << Model->BoneCount << "," << std::endl;
+
+		if (OverdrawBefore > 0.0f)
+		{
+			file << "\t\"overdraw\": {"
+				<< "\"before\": " << OverdrawBefore
+				<< ", \"after\": " << OverdrawAfter
+				<< "}," << std::endl;
+		}
+
+		// Nodes
+		bool first = true;
+		file << "\t\"nodes\": [";
+		WriteNodes(file, Model->RootNode, -1, first);
+		file << "\n\t]," << std::endl;
+
+		// Bones
+		file << "\t\"bones\": [";
+		for (size_t i = 0; i < Model->Skeleton.size(); ++i)
+		{
+			SBone* bone = Model->Skeleton[i];
+			file << ((i > 0) ? ",\n" : "\n")
+				<< "\t\t{\"index\": " << (int)bone->Index
+				<< ", \"name\": \"" << JsonEscape(bone->Name) << "\"}";
+		}
+		file << "\n\t]," << std::endl;
+
+		// Materials
+		file << "\t\"materials\": [";
+		for (size_t i = 0; i < Model->MaterialNames.size(); ++i)
+		{
+			file << ((i > 0) ? ",\n" : "\n")
+				<< "\t\t{\"index\": " << i
+				<< ", \"name\": \"" << JsonEscape(Model->MaterialNames[i]) << "\"}";
+		}
+		file << "\n\t]," << std::endl;
+	}
+
+	// Animations
+	file << "\t\"animations\": [";
+	for (size_t i = 0; i < Animations.size(); ++i)
+	{
+		SAnimation* animation = Animations[i].Animation;
+		size_t positionKeyCount = 0;
+		size_t rotationKeyCount = 0;
+
+		for (SAnimationNode* animationNode : animation->AnimationNodes)
+		{
+			positionKeyCount += animationNode->PositionKeys.size();
+			rotationKeyCount += animationNode->RotationKeys.size();
+		}
+
+		double seconds = (animation->TicsPerSecond > 0.0)
+			? animation->Duration / animation->TicsPerSecond
+			: 0.0;
+
+		file << ((i > 0) ? ",\n" : "\n")
+			<< "\t\t{\"name\": \"" << JsonEscape(animation->Name) << "\""
+			<< ", \"path\": \"" << JsonEscape(Animations[i].Path) << "\""
+			<< ", \"duration\": " << animation->Duration
+			<< ", \"ticsPerSecond\": " << animation->TicsPerSecond
+			<< ", \"seconds\": " << seconds
+			<< ", \"nodeCount\": " << animation->AnimationNodes.size()
+			<< ", \"positionKeyCount\": " << positionKeyCount
+			<< ", \"rotationKeyCount\": " << rotationKeyCount
+			<< ", \"bytes\": " << animation->GetSize() << "}";
+	}
+	file << "\n\t]," << std::endl;
+
+	// Timings
+	file << "\t\"timings\": {";
+	for (size_t i = 0; i < Timings.size(); ++i)
+	{
+		file << ((i > 0) ? ", " : "")
+			<< "\"" << JsonEscape(Timings[i].first) << "\": " << Timings[i].second;
+	}
+	file << "}," << std::endl;
+
+	// Warnings
+	file << "\t\"warnings\": [";
+	for (size_t i = 0; i < Warnings.size(); ++i)
+	{
+		file << ((i > 0) ? ",\n" : "\n")
+			<< "\t\t{\"code\": " << Warnings[i].Code
+			<< ", \"message\": \"" << JsonEscape(Warnings[i].Message) << "\"}";
+	}
+	file << (Warnings.empty() ? "]" : "\n\t]") << std::endl
+		<< "}" << std::endl;
+
+	file.close();
+
+	return true;
+}
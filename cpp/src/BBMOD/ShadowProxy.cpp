@@ -0,0 +1,229 @@
+#include <BBMOD/ShadowProxy.hpp>
+#include <utils.hpp>
+
+#include <algorithm>
+#include <array>
+#include <cfloat>
+#include <cmath>
+#include <cstdint>
+#include <fstream>
+#include <map>
+#include <set>
+#include <tuple>
+
+/** Vertex positions and triangles referencing them by index. */
+struct SIndexedMesh
+{
+	std::vector<std::array<float, 3>> Positions;
+
+	std::vector<std::array<size_t, 3>> Triangles;
+};
+
+/** Joins triangles of meshes of a node and welds vertices with the same position. */
+static void WeldNode(const SModel* model, const SNode* node, SIndexedMesh& out)
+{
+	std::map<std::array<float, 3>, size_t> indices;
+
+	for (size_t meshIndex : node->Meshes)
+	{
+		const SMesh* mesh = model->Meshes[meshIndex];
+
+		for (size_t i = 0; i + 2 < mesh->Data.size(); i += 3)
+		{
+			std::array<size_t, 3> triangle;
+
+			for (size_t j = 0; j < 3; ++j)
+			{
+				const float* position = mesh->Data[i + j]->Position;
+				std::array<float, 3> key = { position[0], position[1], position[2] };
+
+				auto it = indices.find(key);
+				if (it == indices.end())
+				{
+					it = indices.emplace(key, out.Positions.size()).first;
+					out.Positions.push_back(key);
+				}
+				triangle[j] = it->second;
+			}
+
+			if (triangle[0] != triangle[1]
+				&& triangle[1] != triangle[2]
+				&& triangle[2] != triangle[0])
+			{
+				out.Triangles.push_back(triangle);
+			}
+		}
+	}
+}
+
+/**
+ * Moves vertices in each cell of a uniform grid into their average position
+ * and removes triangles which become degenerate or duplicate.
+ */
+static void ClusterVertices(SIndexedMesh& mesh, size_t gridSize)
+{
+	float min[3] = { FLT_MAX, FLT_MAX, FLT_MAX };
+	float max[3] = { -FLT_MAX, -FLT_MAX, -FLT_MAX };
+
+	for (const auto& position : mesh.Positions)
+	{
+		for (size_t i = 0; i < 3; ++i)
+		{
+			min[i] = std::min(min[i], position[i]);
+			max[i] = std::max(max[i], position[i]);
+		}
+	}
+
+	float extent = std::max({ max[0] - min[0], max[1] - min[1], max[2] - min[2] });
+	if (extent <= 0.0f)
+	{
+		return;
+	}
+	float cellSize = extent / (float)gridSize;
+
+	// Average positions of vertices in each cell
+	std::map<std::tuple<int, int, int>, size_t> cells;
+	std::vector<size_t> remap(mesh.Positions.size());
+	std::vector<std::array<float, 3>> positions;
+	std::vector<size_t> counts;
+
+	for (size_t i = 0; i < mesh.Positions.size(); ++i)
+	{
+		const auto& position = mesh.Positions[i];
+		std::tuple<int, int, int> key(
+			(int)std::floor((position[0] - min[0]) / cellSize),
+			(int)std::floor((position[1] - min[1]) / cellSize),
+			(int)std::floor((position[2] - min[2]) / cellSize));
+
+		auto it = cells.find(key);
+		if (it == cells.end())
+		{
+			it = cells.emplace(key, positions.size()).first;
+			positions.push_back({ 0.0f, 0.0f, 0.0f });
+			counts.push_back(0);
+		}
+
+		size_t cluster = it->second;
+		for (size_t j = 0; j < 3; ++j)
+		{
+			positions[cluster][j] += position[j];
+		}
+		++counts[cluster];
+		remap[i] = cluster;
+	}
+
+	for (size_t i = 0; i < positions.size(); ++i)
+	{
+		for (size_t j = 0; j < 3; ++j)
+		{
+			positions[i][j] /= (float)counts[i];
+		}
+	}
+
+	// Keep triangles with three different clusters, each only once
+	std::set<std::array<size_t, 3>> unique;
+	std::vector<std::array<size_t, 3>> triangles;
+
+	for (const auto& triangle : mesh.Triangles)
+	{
+		std::array<size_t, 3> clustered = {
+			remap[triangle[0]], remap[triangle[1]], remap[triangle[2]],
+		};
+
+		if (clustered[0] == clustered[1]
+			|| clustered[1] == clustered[2]
+			|| clustered[2] == clustered[0])
+		{
+			continue;
+		}
+
+		// Rotate the smallest index first, which keeps the winding order
+		std::rotate(clustered.begin(),
+			std::min_element(clustered.begin(), clustered.end()),
+			clustered.end());
+
+		if (unique.insert(clustered).second)
+		{
+			triangles.push_back(clustered);
+		}
+	}
+
+	mesh.Positions = positions;
+	mesh.Triangles = triangles;
+}
+
+static void BuildNode(const SModel* model, const SNode* node, size_t gridSize,
+	std::vector<SShadowProxy>& proxies)
+{
+	if (!node->Meshes.empty())
+	{
+		SIndexedMesh mesh;
+		WeldNode(model, node, mesh);
+
+		if (gridSize > 0)
+		{
+			ClusterVertices(mesh, gridSize);
+		}
+
+		if (!mesh.Triangles.empty())
+		{
+			SShadowProxy proxy;
+			proxy.Node = (size_t)node->Index;
+
+			for (const auto& triangle : mesh.Triangles)
+			{
+				for (size_t index : triangle)
+				{
+					const auto& position = mesh.Positions[index];
+					proxy.Vertices.insert(proxy.Vertices.end(), position.begin(), position.end());
+				}
+			}
+
+			proxies.push_back(std::move(proxy));
+		}
+	}
+
+	for (const SNode* child : node->Children)
+	{
+		BuildNode(model, child, gridSize, proxies);
+	}
+}
+
+bool BuildShadowProxies(const SModel* model, size_t gridSize, std::vector<SShadowProxy>& proxies)
+{
+	if (model->VertexFormat->Bones)
+	{
+		return false;
+	}
+
+	BuildNode(model, model->RootNode, gridSize, proxies);
+	return true;
+}
+
+bool SaveShadowProxies(std::string path, const std::vector<SShadowProxy>& proxies)
+{
+	std::ofstream file;
+
+	if (!OpenSidecarFile(file, path, "bbshdw"))
+	{
+		return false;
+	}
+
+	size_t proxyCount = proxies.size();
+	FILE_WRITE_SIZE(file, proxyCount);
+
+	for (const SShadowProxy& proxy : proxies)
+	{
+		FILE_WRITE_SIZE(file, proxy.Node);
+
+		size_t vertexCount = proxy.Vertices.size() / 3;
+		FILE_WRITE_SIZE(file, vertexCount);
+		file.write(reinterpret_cast<const char*>(proxy.Vertices.data()),
+			sizeof(float) * proxy.Vertices.size());
+	}
+
+	file.flush();
+	file.close();
+
+	return true;
+}
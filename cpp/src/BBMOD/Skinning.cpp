@@ -0,0 +1,101 @@
+#include <BBMOD/Skinning.hpp>
+
+#include <cstring>
+
+/** Writes data into out and moves out after it. */
+static inline void Write(unsigned char*& out, const void* data, size_t size)
+{
+	std::memcpy(out, data, size);
+	out += size;
+}
+
+size_t GetSkinnedVertexSize(const SVertexFormat* vertexFormat)
+{
+	SVertexFormat staticFormat = *vertexFormat;
+	staticFormat.Bones = false;
+	staticFormat.Ids = false;
+	return staticFormat.GetVertexSize();
+}
+
+void SkinMesh(const SMesh* mesh, const float* transform, size_t boneCount,
+	unsigned char* out, size_t begin, size_t end)
+{
+	const SVertexFormat* vertexFormat = mesh->VertexFormat;
+	out += begin * GetSkinnedVertexSize(vertexFormat);
+
+	matrix_t boneTransform;
+	float vec[3];
+
+	for (size_t i = begin; i < end; ++i)
+	{
+		const SVertex* vertex = mesh->Data[i];
+
+		// Blend transforms of bones affecting the vertex
+		if (vertexFormat->Bones)
+		{
+			std::memset(boneTransform, 0, sizeof(boneTransform));
+
+			for (size_t j = 0; j < vertexFormat->BoneInfluences; ++j)
+			{
+				float weight = vertex->Weights[j];
+				size_t bone = (size_t)vertex->Bones[j];
+				if (weight == 0.0f || bone >= boneCount)
+				{
+					continue;
+				}
+				const float* m = &transform[bone * 16];
+				for (size_t k = 0; k < 16; ++k)
+				{
+					boneTransform[k] += m[k] * weight;
+				}
+			}
+		}
+		else
+		{
+			matrix_t identity = MATRIX_IDENTITY;
+			matrix_copy(identity, boneTransform);
+		}
+
+		if (vertexFormat->Vertices)
+		{
+			matrix_transform_vec3(boneTransform, vertex->Position, 1.0f, vec);
+			Write(out, vec, sizeof(float) * 3);
+		}
+
+		if (vertexFormat->Normals)
+		{
+			matrix_transform_vec3(boneTransform, vertex->Normal, 0.0f, vec);
+			vec3_normalize(vec);
+			Write(out, vec, sizeof(float) * 3);
+		}
+
+		if (vertexFormat->TextureCoords)
+		{
+			Write(out, vertex->Texture, sizeof(float) * 2);
+		}
+
+		if (vertexFormat->Colors)
+		{
+			Write(out, &vertex->Color, sizeof(uint32_t));
+		}
+
+		if (vertexFormat->TangentW)
+		{
+			matrix_transform_vec3(boneTransform, vertex->Tangent, 0.0f, vec);
+			vec3_normalize(vec);
+			Write(out, vec, sizeof(float) * 3);
+			Write(out, &vertex->BitangentSign, sizeof(float));
+		}
+	}
+}
+
+void SkinMesh(const SMesh* mesh, const float* transform, size_t boneCount,
+	unsigned char* out, SJobSystem& jobSystem)
+{
+	jobSystem.Dispatch(mesh->Data.size(), BBMOD_SKINNING_BATCH_SIZE,
+		[mesh, transform, boneCount, out](size_t begin, size_t end)
+		{
+			SkinMesh(mesh, transform, boneCount, out, begin, end);
+		});
+	jobSystem.Wait();
+}
@@ -0,0 +1,121 @@
+#include <BBMOD/StaticBatch.hpp>
+#include <BBMOD/Skinning.hpp>
+
+#include <algorithm>
+#include <cstring>
+
+/** Writes data into out and moves out after it. */
+static inline void Write(unsigned char*& out, const void* data, size_t size)
+{
+	std::memcpy(out, data, size);
+	out += size;
+}
+
+/** Returns vertices of all meshes of a model as a single triangle list. */
+static std::vector<const SVertex*> GetTriangleList(const SModel* model)
+{
+	std::vector<const SVertex*> vertices;
+	for (const SMesh* mesh : model->Meshes)
+	{
+		mesh->GetTriangleList(vertices);
+	}
+	return vertices;
+}
+
+static size_t GetVertexCount(const SModel* model)
+{
+	size_t vertexCount = 0;
+	for (const SMesh* mesh : model->Meshes)
+	{
+		if (mesh->PrimitiveType == BBMOD_PRIMITIVE_TRIANGLE_LIST)
+		{
+			vertexCount += mesh->Data.size();
+		}
+		else
+		{
+			std::vector<const SVertex*> vertices;
+			mesh->GetTriangleList(vertices);
+			vertexCount += vertices.size();
+		}
+	}
+	return vertexCount;
+}
+
+size_t GetStaticBatchSize(const SModel* model, size_t instanceCount)
+{
+	return (GetVertexCount(model) * GetSkinnedVertexSize(model->VertexFormat) * instanceCount);
+}
+
+void BuildStaticBatch(const SModel* model, const float* transforms,
+	unsigned char* out, size_t begin, size_t end)
+{
+	const SVertexFormat* vertexFormat = model->VertexFormat;
+	std::vector<const SVertex*> vertices = GetTriangleList(model);
+	out += begin * vertices.size() * GetSkinnedVertexSize(vertexFormat);
+
+	matrix_t normalTransform;
+	vec3_t vec;
+
+	for (size_t i = begin; i < end; ++i)
+	{
+		const float* transform = &transforms[i * 16];
+
+		// Normals need the inverse transpose to stay perpendicular to surfaces
+		// under non-uniform scale
+		matrix_copy(transform, normalTransform);
+		matrix_inverse(normalTransform);
+		matrix_transpose(normalTransform);
+
+		// Mirroring transforms flip the bitangent
+		float bitangentSign = (matrix_determinant(transform) < 0.0f) ? -1.0f : 1.0f;
+
+		for (const SVertex* vertex : vertices)
+		{
+			if (vertexFormat->Vertices)
+			{
+				matrix_transform_vec3(transform, vertex->Position, 1.0f, vec);
+				Write(out, vec, sizeof(float) * 3);
+			}
+
+			if (vertexFormat->Normals)
+			{
+				matrix_transform_vec3(normalTransform, vertex->Normal, 0.0f, vec);
+				vec3_normalize(vec);
+				Write(out, vec, sizeof(float) * 3);
+			}
+
+			if (vertexFormat->TextureCoords)
+			{
+				Write(out, vertex->Texture, sizeof(float) * 2);
+			}
+
+			if (vertexFormat->Colors)
+			{
+				Write(out, &vertex->Color, sizeof(uint32_t));
+			}
+
+			if (vertexFormat->TangentW)
+			{
+				matrix_transform_vec3(transform, vertex->Tangent, 0.0f, vec);
+				vec3_normalize(vec);
+				Write(out, vec, sizeof(float) * 3);
+				float sign = vertex->BitangentSign * bitangentSign;
+				Write(out, &sign, sizeof(float));
+			}
+		}
+	}
+}
+
+void BuildStaticBatch(const SModel* model, const float* transforms, size_t instanceCount,
+	unsigned char* out, SJobSystem& jobSystem)
+{
+	size_t vertexCount = std::max<size_t>(GetVertexCount(model), 1);
+	size_t batchSize = (BBMOD_STATIC_BATCH_JOB_SIZE + vertexCount - 1) / vertexCount;
+
+	jobSystem.Dispatch(instanceCount, batchSize,
+		[model, transforms, out](size_t begin, size_t end)
+		{
+			BuildStaticBatch(model, transforms, out, begin, end);
+		});
+	jobSystem.Wait();
+}
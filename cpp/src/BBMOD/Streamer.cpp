@@ -0,0 +1,275 @@
+#include <BBMOD/Streamer.hpp>
+#include <BBMOD/ModelBlob.hpp>
+#include <BBMOD/common.hpp>
+
+#include <algorithm>
+#include <cstring>
+#include <fstream>
+#include <iterator>
+
+/** Orders a heap of items so that the one with the highest priority is on top. */
+static bool CompareItems(const SStreamItem* a, const SStreamItem* b)
+{
+	if (a->Priority != b->Priority)
+	{
+		return (a->Priority < b->Priority);
+	}
+	return (a->Sequence > b->Sequence);
+}
+
+static bool ReadFile(const std::string& path, std::vector<unsigned char>& data)
+{
+	std::ifstream file(path, std::ios::in | std::ios::binary);
+
+	if (!file.is_open())
+	{
+		return false;
+	}
+
+	data.assign(
+		(std::istreambuf_iterator<char>(file)),
+		std::istreambuf_iterator<char>());
+	file.close();
+	return true;
+}
+
+SStreamer::SStreamer(size_t threadCount)
+{
+	threadCount = std::max<size_t>(threadCount, 1);
+
+	for (size_t i = 0; i < threadCount; ++i)
+	{
+		Threads.emplace_back(&SStreamer::WorkerMain, this);
+	}
+}
+
+SStreamer::~SStreamer()
+{
+	{
+		std::lock_guard<std::mutex> lock(Mutex);
+		Stop = true;
+	}
+	Condition.notify_all();
+
+	for (std::thread& thread : Threads)
+	{
+		thread.join();
+	}
+
+	// Removed items are only referenced by the queue
+	for (SStreamItem* item : Queue)
+	{
+		if (item->Removed)
+		{
+			delete item;
+		}
+	}
+
+	for (auto& pair : Items)
+	{
+		delete pair.second;
+	}
+}
+
+size_t SStreamer::Enqueue(std::string path, int type, double priority)
+{
+	SStreamItem* item = new SStreamItem();
+	item->Path = path;
+	item->Type = type;
+	item->Priority = priority;
+
+	{
+		std::lock_guard<std::mutex> lock(Mutex);
+		item->Id = NextId++;
+		item->Sequence = item->Id;
+		Items[item->Id] = item;
+		Queue.push_back(item);
+		std::push_heap(Queue.begin(), Queue.end(), CompareItems);
+	}
+	Condition.notify_one();
+
+	return item->Id;
+}
+
+bool SStreamer::Remove(size_t id)
+{
+	std::unique_lock<std::mutex> lock(Mutex);
+
+	auto it = Items.find(id);
+	if (it == Items.end())
+	{
+		return false;
+	}
+
+	SStreamItem* item = it->second;
+	Items.erase(it);
+
+	if (item->State == BBMOD_STREAM_QUEUED || item->State == BBMOD_STREAM_LOADING)
+	{
+		// Deleted by the worker which takes it
+		item->Removed = true;
+		return true;
+	}
+
+	StagedSize -= item->Data.size();
+	delete item;
+	lock.unlock();
+
+	Condition.notify_all();
+	return true;
+}
+
+bool SStreamer::Poll(size_t& id)
+{
+	std::lock_guard<std::mutex> lock(Mutex);
+
+	while (!Finished.empty())
+	{
+		id = Finished.front();
+		Finished.pop_front();
+
+		if (Items.find(id) != Items.end())
+		{
+			return true;
+		}
+	}
+
+	return false;
+}
+
+int SStreamer::GetState(size_t id)
+{
+	std::lock_guard<std::mutex> lock(Mutex);
+	auto it = Items.find(id);
+	return (it != Items.end()) ? it->second->State : -1;
+}
+
+bool SStreamer::GetData(size_t id, unsigned char* out, size_t& size)
+{
+	std::lock_guard<std::mutex> lock(Mutex);
+
+	auto it = Items.find(id);
+	if (it == Items.end() || it->second->State != BBMOD_STREAM_DONE)
+	{
+		return false;
+	}
+
+	const std::vector<unsigned char>& data = it->second->Data;
+	size = data.size();
+	if (out)
+	{
+		std::memcpy(out, data.data(), size);
+	}
+	return true;
+}
+
+void SStreamer::SetBudget(size_t budget)
+{
+	{
+		std::lock_guard<std::mutex> lock(Mutex);
+		Budget = budget;
+	}
+	Condition.notify_all();
+}
+
+size_t SStreamer::GetBudget()
+{
+	std::lock_guard<std::mutex> lock(Mutex);
+	return Budget;
+}
+
+size_t SStreamer::GetStagedSize()
+{
+	std::lock_guard<std::mutex> lock(Mutex);
+	return StagedSize;
+}
+
+bool SStreamer::LoadItem(const std::string& path, int type, std::vector<unsigned char>& data)
+{
+	std::vector<unsigned char> file;
+	if (!ReadFile(path, file))
+	{
+		return false;
+	}
+
+	if (type == BBMOD_STREAM_MODEL)
+	{
+		SModelBlob* blob = SModelBlob::FromMemory(file.data(), file.size());
+		if (!blob)
+		{
+			return false;
+		}
+		data = std::move(blob->Data);
+		delete blob;
+		return true;
+	}
+
+	if (type == BBMOD_STREAM_ANIMATION)
+	{
+		// Header "bbanim\0" and version
+		const size_t headerSize = 8;
+		if (file.size() < headerSize
+			|| std::memcmp(file.data(), "bbanim", 7) != 0
+			|| file[7] != BBMOD_VERSION)
+		{
+			return false;
+		}
+		data.assign(file.begin() + headerSize, file.end());
+		return true;
+	}
+
+	return false;
+}
+
+void SStreamer::WorkerMain()
+{
+	while (true)
+	{
+		SStreamItem* item;
+
+		{
+			std::unique_lock<std::mutex> lock(Mutex);
+
+			// At least one item can always be staged, even if it is over budget
+			Condition.wait(lock, [this]
+			{
+				return Stop || (!Queue.empty() && (StagedSize < Budget || StagedSize == 0));
+			});
+
+			if (Stop)
+			{
+				return;
+			}
+
+			std::pop_heap(Queue.begin(), Queue.end(), CompareItems);
+			item = Queue.back();
+			Queue.pop_back();
+
+			if (item->Removed)
+			{
+				delete item;
+				continue;
+			}
+
+			item->State = BBMOD_STREAM_LOADING;
+		}
+
+		std::vector<unsigned char> data;
+		bool loaded = LoadItem(item->Path, item->Type, data);
+
+		{
+			std::lock_guard<std::mutex> lock(Mutex);
+
+			if (item->Removed)
+			{
+				delete item;
+				continue;
+			}
+
+			item->State = loaded ? BBMOD_STREAM_DONE : BBMOD_STREAM_FAILED;
+			item->Data = std::move(data);
+			StagedSize += item->Data.size();
+			Finished.push_back(item->Id);
+		}
+	}
+}
@@ -0,0 +1,278 @@
+#include <BBMOD/Stripify.hpp>
+
+#include <array>
+#include <cstdint>
+#include <cstring>
+#include <map>
+#include <unordered_map>
+#include <vector>
+
+/** Number of 32-bit words compared when welding vertices. */
+#define VERTEX_KEY_SIZE 21
+
+using VertexKey = std::array<uint32_t, VERTEX_KEY_SIZE>;
+
+/** Creates a key which is equal for vertices with the same attributes. */
+static VertexKey GetVertexKey(const SVertex* vertex, const SVertexFormat* vertexFormat)
+{
+	VertexKey key = {};
+	uint32_t* k = key.data();
+
+	std::memcpy(k, vertex->Position, sizeof(vec3_t));
+	if (vertexFormat->Normals)
+	{
+		std::memcpy(k + 3, vertex->Normal, sizeof(vec3_t));
+	}
+	if (vertexFormat->TextureCoords)
+	{
+		std::memcpy(k + 6, vertex->Texture, sizeof(vec2_t));
+	}
+	if (vertexFormat->Colors)
+	{
+		k[8] = vertex->Color;
+	}
+	if (vertexFormat->TangentW)
+	{
+		std::memcpy(k + 9, vertex->Tangent, sizeof(vec3_t));
+		std::memcpy(k + 12, &vertex->BitangentSign, sizeof(float));
+	}
+	if (vertexFormat->Bones)
+	{
+		std::memcpy(k + 13, vertex->Bones, sizeof(vec4_t));
+		std::memcpy(k + 17, vertex->Weights, sizeof(vec4_t));
+	}
+	if (vertexFormat->Ids)
+	{
+		k[20] = (uint32_t)vertex->Id;
+	}
+
+	return key;
+}
+
+static inline uint64_t EdgeKey(uint32_t from, uint32_t to)
+{
+	return ((uint64_t)from << 32) | (uint64_t)to;
+}
+
+/** Finds triangles of a welded mesh by their directed edges. */
+struct SEdgeMap
+{
+	/** Adds a triangle with vertices a, b, c in winding order. */
+	void Add(uint32_t triangle, uint32_t a, uint32_t b, uint32_t c)
+	{
+		Edges[EdgeKey(a, b)].push_back(triangle);
+		Edges[EdgeKey(b, c)].push_back(triangle);
+		Edges[EdgeKey(c, a)].push_back(triangle);
+	}
+
+	/**
+	 * Finds a triangle with an edge going from vertex "from" to vertex "to",
+	 * for which "available" returns true.
+	 */
+	template<typename F>
+	bool Find(uint32_t from, uint32_t to, const F& available, uint32_t& triangle) const
+	{
+		auto it = Edges.find(EdgeKey(from, to));
+		if (it == Edges.end())
+		{
+			return false;
+		}
+		for (uint32_t t : it->second)
+		{
+			if (available(t))
+			{
+				triangle = t;
+				return true;
+			}
+		}
+		return false;
+	}
+
+	std::unordered_map<uint64_t, std::vector<uint32_t>> Edges;
+};
+
+/** Returns the vertex of a triangle which is neither a nor b. */
+static inline uint32_t GetThirdVertex(const uint32_t* triangle, uint32_t a, uint32_t b)
+{
+	for (size_t i = 0; i < 3; ++i)
+	{
+		if (triangle[i] != a && triangle[i] != b)
+		{
+			return triangle[i];
+		}
+	}
+	return triangle[0];
+}
+
+bool StripifyMesh(SMesh* mesh, size_t window)
+{
+	if (mesh->PrimitiveType != BBMOD_PRIMITIVE_TRIANGLE_LIST
+		|| mesh->Data.size() < 6)
+	{
+		return false;
+	}
+
+	// Weld identical vertices
+	std::vector<SVertex*> unique;
+	std::vector<uint32_t> indices;
+	std::map<VertexKey, uint32_t> uniqueIndices;
+
+	indices.reserve(mesh->Data.size());
+
+	for (SVertex* vertex : mesh->Data)
+	{
+		auto it = uniqueIndices.emplace(GetVertexKey(vertex, mesh->VertexFormat), (uint32_t)unique.size());
+		if (it.second)
+		{
+			unique.push_back(vertex);
+		}
+		indices.push_back(it.first->second);
+	}
+
+	// Triangles which do not reference the same vertex twice
+	std::vector<uint32_t> triangles;
+	SEdgeMap edgeMap;
+
+	for (size_t i = 0; i + 2 < indices.size(); i += 3)
+	{
+		uint32_t a = indices[i];
+		uint32_t b = indices[i + 1];
+		uint32_t c = indices[i + 2];
+		if (a == b || b == c || c == a)
+		{
+			continue;
+		}
+		edgeMap.Add((uint32_t)(triangles.size() / 3), a, b, c);
+		triangles.push_back(a);
+		triangles.push_back(b);
+		triangles.push_back(c);
+	}
+
+	size_t triangleCount = triangles.size() / 3;
+	std::vector<bool> used(triangleCount, false);
+
+	// Triangles visited by the strip currently being tried
+	std::vector<uint32_t> visited(triangleCount, 0);
+	uint32_t visitStamp = 0;
+
+	std::vector<uint32_t> result;
+	std::vector<uint32_t> strip;
+	std::vector<uint32_t> stripTriangles;
+	std::vector<uint32_t> bestStrip;
+	std::vector<uint32_t> bestTriangles;
+
+	// Grows a strip starting with the given vertices of a triangle
+	auto growStrip = [&](uint32_t start, uint32_t a, uint32_t b, uint32_t c) {
+		++visitStamp;
+		strip.assign({ a, b, c });
+		stripTriangles.assign({ start });
+		visited[start] = visitStamp;
+
+		auto available = [&](uint32_t t) {
+			return (!used[t] && visited[t] != visitStamp
+				&& (window == 0 || t < start + window));
+		};
+
+		while (true)
+		{
+			size_t n = strip.size();
+			uint32_t p = strip[n - 2];
+			uint32_t q = strip[n - 1];
+
+			// Triangles at odd positions of a strip have a flipped winding
+			// order, so the next triangle must continue the edge p->q if its
+			// position is even or q->p if it is odd
+			bool even = ((n - 2) % 2 == 0);
+			uint32_t t;
+			if (!edgeMap.Find(even ? p : q, even ? q : p, available, t))
+			{
+				break;
+			}
+
+			visited[t] = visitStamp;
+			strip.push_back(GetThirdVertex(&triangles[t * 3], p, q));
+			stripTriangles.push_back(t);
+		}
+	};
+
+	for (size_t i = 0; i < triangleCount; ++i)
+	{
+		if (used[i])
+		{
+			continue;
+		}
+
+		const uint32_t* tri = &triangles[i * 3];
+		bestStrip.clear();
+		bestTriangles.clear();
+
+		// Try all rotations of the first triangle and keep the longest strip
+		for (size_t r = 0; r < 3; ++r)
+		{
+			growStrip((uint32_t)i, tri[r], tri[(r + 1) % 3], tri[(r + 2) % 3]);
+			if (strip.size() > bestStrip.size())
+			{
+				bestStrip.swap(strip);
+				bestTriangles.swap(stripTriangles);
+			}
+		}
+
+		for (uint32_t t : bestTriangles)
+		{
+			used[t] = true;
+		}
+
+		// Stitch with degenerate triangles, so that each strip starts at an
+		// even position and keeps its winding order
+		if (!result.empty())
+		{
+			result.push_back(result.back());
+			result.push_back(bestStrip[0]);
+			if (result.size() % 2 != 0)
+			{
+				result.push_back(bestStrip[0]);
+			}
+		}
+		result.insert(result.end(), bestStrip.begin(), bestStrip.end());
+	}
+
+	if (result.size() >= mesh->Data.size())
+	{
+		return false;
+	}
+
+	// Each vertex of a strip is owned by the mesh
+	std::vector<SVertex*> data;
+	data.reserve(result.size());
+	for (uint32_t index : result)
+	{
+		data.push_back(new SVertex(*unique[index]));
+	}
+
+	for (SVertex* vertex : mesh->Data)
+	{
+		delete vertex;
+	}
+
+	mesh->Data = std::move(data);
+	mesh->PrimitiveType = BBMOD_PRIMITIVE_TRIANGLE_STRIP;
+	return true;
+}
+
+size_t Stripify(SModel* model, size_t window)
+{
+	if (model->BatchSize > 0)
+	{
+		return 0;
+	}
+
+	size_t converted = 0;
+	for (SMesh* mesh : model->Meshes)
+	{
+		if (StripifyMesh(mesh, window))
+		{
+			++converted;
+		}
+	}
+	return converted;
+}
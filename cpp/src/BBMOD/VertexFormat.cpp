@@ -1,6 +1,8 @@
 #include <BBMOD/VertexFormat.hpp>
 #include <utils.hpp>
 
+#include <algorithm>
+
 bool SVertexFormat::Save(std::ofstream& file)
 {
 	FILE_WRITE_DATA(file, Vertices);
@@ -8,11 +10,72 @@ bool SVertexFormat::Save(std::ofstream& file)
 	FILE_WRITE_DATA(file, TextureCoords);
 	FILE_WRITE_DATA(file, Colors);
 	FILE_WRITE_DATA(file, TangentW);
-	FILE_WRITE_DATA(file, Bones);
+	uint8_t bones = Bones ? BoneInfluences : 0;
+	FILE_WRITE_DATA(file, bones);
 	FILE_WRITE_DATA(file, Ids);
 	return true;
 }
 
+size_t SVertexFormat::GetSize() const
+{
+	return sizeof(bool) * 7;
+}
+
+size_t SVertexFormat::GetVertexSize() const
+{
+	return (0
+		+ (Vertices ? sizeof(float) * 3 : 0)
+		+ (Normals ? sizeof(float) * 3 : 0)
+		+ (TextureCoords ? sizeof(float) * 2 : 0)
+		+ (Colors ? sizeof(uint32_t) : 0)
+		+ (TangentW ? sizeof(float) * 4 : 0)
+		+ GetBoneSize()
+		+ (Ids ? sizeof(int) : 0));
+}
+
+size_t SVertexFormat::GetBoneSize() const
+{
+	if (!Bones)
+	{
+		return 0;
+	}
+	// A single influence has no weight
+	return sizeof(float) * ((BoneInfluences > 1) ? BoneInfluences * 2 : 1);
+}
+
+void SVertexFormat::Add(const SVertexFormat& other)
+{
+	Vertices = Vertices || other.Vertices;
+	Normals = Normals || other.Normals;
+	TextureCoords = TextureCoords || other.TextureCoords;
+	Colors = Colors || other.Colors;
+	TangentW = TangentW || other.TangentW;
+	if (other.Bones)
+	{
+		BoneInfluences = Bones ? std::max(BoneInfluences, other.BoneInfluences) : other.BoneInfluences;
+	}
+	Bones = Bones || other.Bones;
+	Ids = Ids || other.Ids;
+}
+
+uint32_t SVertexFormat::GetMask() const
+{
+	return (0
+		| ((uint32_t)Vertices << 0)
+		| ((uint32_t)Normals << 1)
+		| ((uint32_t)TextureCoords << 2)
+		| ((uint32_t)Colors << 3)
+		| ((uint32_t)TangentW << 4)
+		| ((uint32_t)Bones << 5)
+		| ((uint32_t)Ids << 6)
+		| ((uint32_t)(Bones ? BoneInfluences : 0) << 8));
+}
+
+bool SVertexFormat::operator==(const SVertexFormat& other) const
+{
+	return (GetMask() == other.GetMask());
+}
+
 SVertexFormat* SVertexFormat::Load(std::ifstream& file)
 {
 	SVertexFormat* vertexFormat = new SVertexFormat();
@@ -21,7 +84,10 @@ SVertexFormat* SVertexFormat::Load(std::ifstream& file)
 	FILE_READ_DATA(file, vertexFormat->TextureCoords);
 	FILE_READ_DATA(file, vertexFormat->Colors);
 	FILE_READ_DATA(file, vertexFormat->TangentW);
-	FILE_READ_DATA(file, vertexFormat->Bones);
+	uint8_t bones;
+	FILE_READ_DATA(file, bones);
+	vertexFormat->Bones = (bones != 0);
+	vertexFormat->BoneInfluences = (bones != 0) ? bones : 4;
 	FILE_READ_DATA(file, vertexFormat->Ids);
 	return vertexFormat;
 }
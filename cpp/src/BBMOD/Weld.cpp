@@ -0,0 +1,261 @@
+#include <BBMOD/Weld.hpp>
+
+#include <cmath>
+#include <cstdint>
+#include <cstring>
+#include <unordered_map>
+#include <vector>
+
+#define X_PI 3.14159265359f
+
+/** Coordinates of a cell of a spatial hash. */
+struct SWeldCell
+{
+	int64_t X;
+
+	int64_t Y;
+
+	int64_t Z;
+
+	bool operator==(const SWeldCell& other) const
+	{
+		return (X == other.X && Y == other.Y && Z == other.Z);
+	}
+};
+
+struct SWeldCellHash
+{
+	size_t operator()(const SWeldCell& cell) const
+	{
+		uint64_t h = (uint64_t)cell.X * 73856093ull;
+		h ^= (uint64_t)cell.Y * 19349663ull;
+		h ^= (uint64_t)cell.Z * 83492791ull;
+		return (size_t)h;
+	}
+};
+
+/** Tolerances of a welding pass. */
+struct SWeldTolerance
+{
+	float DistanceSqr = 0.0f;
+
+	/** Compare normals, tangents and texture coordinates too. */
+	bool Attributes = false;
+
+	float CosAngle = 1.0f;
+
+	float UVDistanceSqr = 0.0f;
+};
+
+static inline float DistanceSqr(const float* a, const float* b, size_t size)
+{
+	float d = 0.0f;
+	for (size_t i = 0; i < size; ++i)
+	{
+		d += (a[i] - b[i]) * (a[i] - b[i]);
+	}
+	return d;
+}
+
+/** Returns cosine of the angle between two vectors. */
+static inline float CosAngle(const float* a, const float* b)
+{
+	float lengths = std::sqrt((a[0] * a[0] + a[1] * a[1] + a[2] * a[2])
+		* (b[0] * b[0] + b[1] * b[1] + b[2] * b[2]));
+	if (lengths <= 0.0f)
+	{
+		return 1.0f;
+	}
+	return (a[0] * b[0] + a[1] * b[1] + a[2] * b[2]) / lengths;
+}
+
+static bool CanWeld(const SVertex* a, const SVertex* b, const SVertexFormat* vertexFormat,
+	const SWeldTolerance& tolerance)
+{
+	if (DistanceSqr(a->Position, b->Position, 3) > tolerance.DistanceSqr)
+	{
+		return false;
+	}
+
+	if ((vertexFormat->Colors && a->Color != b->Color)
+		|| (vertexFormat->Bones
+			&& (std::memcmp(a->Bones, b->Bones, sizeof(vec4_t))
+				|| std::memcmp(a->Weights, b->Weights, sizeof(vec4_t))))
+		|| (vertexFormat->Ids && a->Id != b->Id))
+	{
+		return false;
+	}
+
+	if (!tolerance.Attributes)
+	{
+		return true;
+	}
+
+	if (vertexFormat->Normals && CosAngle(a->Normal, b->Normal) < tolerance.CosAngle)
+	{
+		return false;
+	}
+
+	if (vertexFormat->TextureCoords
+		&& DistanceSqr(a->Texture, b->Texture, 2) > tolerance.UVDistanceSqr)
+	{
+		return false;
+	}
+
+	if (vertexFormat->TangentW
+		&& (a->BitangentSign != b->BitangentSign
+			|| CosAngle(a->Tangent, b->Tangent) < tolerance.CosAngle))
+	{
+		return false;
+	}
+
+	return true;
+}
+
+/**
+ * Finds the vertex with the smallest index in the neighbourhood of a vertex
+ * which it can be welded with, considering only vertices for which "accept"
+ * returns true.
+ */
+template<typename F>
+static size_t FindWeld(const std::vector<SVertex*>& vertices, size_t index, const SWeldCell& cell,
+	const std::unordered_map<SWeldCell, std::vector<size_t>, SWeldCellHash>& cells,
+	const SVertexFormat* vertexFormat, const SWeldTolerance& tolerance, const F& accept)
+{
+	size_t result = index;
+
+	for (int64_t x = -1; x <= 1; ++x)
+	{
+		for (int64_t y = -1; y <= 1; ++y)
+		{
+			for (int64_t z = -1; z <= 1; ++z)
+			{
+				auto it = cells.find({ cell.X + x, cell.Y + y, cell.Z + z });
+				if (it == cells.end())
+				{
+					continue;
+				}
+
+				// Indices in cells are sorted
+				for (size_t other : it->second)
+				{
+					if (other >= result)
+					{
+						break;
+					}
+					if (accept(other)
+						&& CanWeld(vertices[index], vertices[other], vertexFormat, tolerance))
+					{
+						result = other;
+						break;
+					}
+				}
+			}
+		}
+	}
+
+	return result;
+}
+
+/**
+ * Welds vertices of a mesh in two parallel steps. First each vertex finds the
+ * first vertex it can be welded with. Vertices which found themselves become
+ * leaders, whose attributes are then taken by the rest of the vertices. Since
+ * leaders are never modified, vertices do not drift further than the
+ * tolerance.
+ */
+template<typename F>
+static size_t WeldMesh(SMesh* mesh, float cellSize, const SWeldTolerance& tolerance,
+	SJobSystem& jobSystem, const F& merge)
+{
+	std::vector<SVertex*>& vertices = mesh->Data;
+	size_t vertexCount = vertices.size();
+
+	std::vector<SWeldCell> vertexCells(vertexCount);
+	std::unordered_map<SWeldCell, std::vector<size_t>, SWeldCellHash> cells;
+
+	for (size_t i = 0; i < vertexCount; ++i)
+	{
+		const float* position = vertices[i]->Position;
+		SWeldCell cell = {
+			(int64_t)std::floor(position[0] / cellSize),
+			(int64_t)std::floor(position[1] / cellSize),
+			(int64_t)std::floor(position[2] / cellSize),
+		};
+		vertexCells[i] = cell;
+		cells[cell].push_back(i);
+	}
+
+	std::vector<size_t> parent(vertexCount);
+
+	auto any = [](size_t) { return true; };
+
+	jobSystem.Dispatch(vertexCount, BBMOD_WELD_BATCH_SIZE, [&](size_t begin, size_t end) {
+		for (size_t i = begin; i < end; ++i)
+		{
+			parent[i] = FindWeld(vertices, i, vertexCells[i], cells, mesh->VertexFormat, tolerance, any);
+		}
+	});
+	jobSystem.Wait();
+
+	std::vector<size_t> leader(vertexCount);
+
+	auto isLeader = [&](size_t index) { return parent[index] == index; };
+
+	jobSystem.Dispatch(vertexCount, BBMOD_WELD_BATCH_SIZE, [&](size_t begin, size_t end) {
+		for (size_t i = begin; i < end; ++i)
+		{
+			leader[i] = isLeader(i)
+				? i
+				: FindWeld(vertices, i, vertexCells[i], cells, mesh->VertexFormat, tolerance, isLeader);
+		}
+	});
+	jobSystem.Wait();
+
+	size_t welded = 0;
+	for (size_t i = 0; i < vertexCount; ++i)
+	{
+		if (leader[i] != i)
+		{
+			merge(vertices[i], vertices[leader[i]]);
+			++welded;
+		}
+	}
+
+	return welded;
+}
+
+size_t WeldVertices(SModel* model, float distance, float angle, float uvDistance,
+	SJobSystem& jobSystem)
+{
+	if (distance <= 0.0f)
+	{
+		return 0;
+	}
+
+	SWeldTolerance positions;
+	positions.DistanceSqr = distance * distance;
+
+	SWeldTolerance attributes = positions;
+	attributes.Attributes = true;
+	attributes.CosAngle = std::cos(angle * X_PI / 180.0f);
+	attributes.UVDistanceSqr = uvDistance * uvDistance;
+
+	size_t welded = 0;
+
+	for (SMesh* mesh : model->Meshes)
+	{
+		// Close cracks along seams and hard edges
+		WeldMesh(mesh, distance, positions, jobSystem,
+			[](SVertex* vertex, const SVertex* other) {
+				vec3_copy(other->Position, vertex->Position);
+			});
+
+		welded += WeldMesh(mesh, distance, attributes, jobSystem,
+			[](SVertex* vertex, const SVertex* other) {
+				*vertex = *other;
+			});
+	}
+
+	return welded;
+}
@@ -0,0 +1,751 @@
+#include <BBMOD/Model.hpp>
+#include <BBMOD/Mesh.hpp>
+#include <BBMOD/Animation.hpp>
+#include <BBMOD/Profiler.hpp>
+#include <terminal.hpp>
+
+#include <assimp/scene.h>
+#include <assimp/StandardShapes.h>
+
+#include <algorithm>
+#include <cmath>
+#include <cstdlib>
+#include <cstring>
+#include <filesystem>
+#include <fstream>
+#include <functional>
+#include <iostream>
+#include <map>
+#include <regex>
+#include <sstream>
+#include <string>
+#include <vector>
+
+/** Default number of runs of each stage. The fastest run is reported. */
+#define BBMOD_BENCHMARK_REPEAT 3
+
+/** A relative slowdown against the baseline reported as a regression. */
+#define BBMOD_BENCHMARK_THRESHOLD 0.1
+
+const char* gUsage = "Usage: BBMODBenchmark.exe [-h] [-r=N] [results_file [baseline_file]]";
+
+void PrintHelp()
+{
+	std::cout
+		<< gUsage << std::endl
+		<< std::endl
+		<< "Converts synthetic scenes generated in memory and measures times of individual" << std::endl
+		<< "conversion stages." << std::endl
+		<< std::endl
+		<< "Arguments:" << std::endl
+		<< std::endl
+		<< "  -h                                   Show this help message and exit." << std::endl
+		<< "  -r|--repeat=N                        Number of runs of each stage. The fastest run is reported." << std::endl
+		<< "                                       Default is " << BBMOD_BENCHMARK_REPEAT << "." << std::endl
+		<< "  results_file                         Where to save the results. Default is benchmark.txt." << std::endl
+		<< "  baseline_file                        Results of a previous run to compare with. Stages slower" << std::endl
+		<< "                                       by more than " << (int)(BBMOD_BENCHMARK_THRESHOLD * 100.0) << "% are reported as regressions." << std::endl
+		<< std::endl;
+}
+
+/** A time of a single stage of a benchmark. */
+struct SBenchmarkResult
+{
+	std::string Scene;
+
+	std::string Stage;
+
+	double Milliseconds = 0.0;
+
+	/** Number of processed vertices, keys or bytes. */
+	double Amount = 0.0;
+
+	std::string Unit;
+
+	size_t PeakMemory = 0;
+
+	double GetThroughput() const
+	{
+		return (Milliseconds > 0.0) ? (Amount / (Milliseconds / 1000.0)) : 0.0;
+	}
+};
+
+/** A synthetic scene together with the amount of data it contains. */
+struct SBenchmarkScene
+{
+	std::string Name;
+
+	aiScene* Scene = nullptr;
+
+	size_t VertexCount = 0;
+
+	size_t KeyCount = 0;
+};
+
+static aiNode* CreateNode(std::string name, aiNode* parent)
+{
+	aiNode* node = new aiNode(name);
+	node->mParent = parent;
+	return node;
+}
+
+static void SetChildren(aiNode* node, const std::vector<aiNode*>& children)
+{
+	node->mNumChildren = (unsigned int)children.size();
+	node->mChildren = new aiNode*[children.size()];
+	std::copy(children.begin(), children.end(), node->mChildren);
+}
+
+static void SetMeshes(aiNode* node, const std::vector<unsigned int>& meshes)
+{
+	node->mNumMeshes = (unsigned int)meshes.size();
+	node->mMeshes = new unsigned int[meshes.size()];
+	std::copy(meshes.begin(), meshes.end(), node->mMeshes);
+}
+
+static void SetMaterial(aiScene* scene)
+{
+	aiString name("Material");
+	aiMaterial* material = new aiMaterial();
+	material->AddProperty(&name, AI_MATKEY_NAME);
+
+	scene->mNumMaterials = 1;
+	scene->mMaterials = new aiMaterial*[1];
+	scene->mMaterials[0] = material;
+}
+
+static void SetMeshList(aiScene* scene, const std::vector<aiMesh*>& meshes)
+{
+	scene->mNumMeshes = (unsigned int)meshes.size();
+	scene->mMeshes = new aiMesh*[meshes.size()];
+	std::copy(meshes.begin(), meshes.end(), scene->mMeshes);
+}
+
+/**
+ * Creates a sphere mesh using Assimp's StandardShapes, with normals, texture
+ * coordinates and tangents, so all vertex attributes are converted.
+ */
+static aiMesh* CreateSphere(unsigned int tess, float radius)
+{
+	std::vector<aiVector3D> positions;
+	Assimp::StandardShapes::MakeSphere(tess, positions);
+
+	aiMesh* mesh = Assimp::StandardShapes::MakeMesh(positions, 3);
+	unsigned int vertexCount = mesh->mNumVertices;
+
+	mesh->mNormals = new aiVector3D[vertexCount];
+	mesh->mTangents = new aiVector3D[vertexCount];
+	mesh->mBitangents = new aiVector3D[vertexCount];
+	mesh->mTextureCoords[0] = new aiVector3D[vertexCount];
+	mesh->mNumUVComponents[0] = 2;
+
+	for (unsigned int i = 0; i < vertexCount; ++i)
+	{
+		aiVector3D normal = mesh->mVertices[i];
+		normal.Normalize();
+
+		aiVector3D tangent(-normal.z, 0.0f, normal.x);
+		if (tangent.SquareLength() == 0.0f)
+		{
+			tangent = aiVector3D(1.0f, 0.0f, 0.0f);
+		}
+		tangent.Normalize();
+
+		mesh->mVertices[i] = normal * radius;
+		mesh->mNormals[i] = normal;
+		mesh->mTangents[i] = tangent;
+		mesh->mBitangents[i] = normal ^ tangent;
+		mesh->mTextureCoords[0][i] = aiVector3D(
+			0.5f + std::atan2(normal.z, normal.x) / 6.2831853f,
+			0.5f - std::asin(normal.y) / 3.1415927f,
+			0.0f);
+	}
+
+	mesh->mMaterialIndex = 0;
+
+	return mesh;
+}
+
+/** Creates an animation channel with keyCount position and rotation keys. */
+static aiNodeAnim* CreateChannel(std::string nodeName, unsigned int keyCount, float phase)
+{
+	aiNodeAnim* channel = new aiNodeAnim();
+	channel->mNodeName = aiString(nodeName);
+
+	channel->mNumPositionKeys = keyCount;
+	channel->mPositionKeys = new aiVectorKey[keyCount];
+	channel->mNumRotationKeys = keyCount;
+	channel->mRotationKeys = new aiQuatKey[keyCount];
+
+	for (unsigned int i = 0; i < keyCount; ++i)
+	{
+		float t = (float)i / (float)std::max(keyCount - 1, 1u);
+		float angle = (t + phase) * 6.2831853f;
+
+		channel->mPositionKeys[i].mTime = (double)i;
+		channel->mPositionKeys[i].mValue = aiVector3D(0.0f, 1.0f + 0.1f * std::sin(angle), 0.0f);
+
+		channel->mRotationKeys[i].mTime = (double)i;
+		channel->mRotationKeys[i].mValue = aiQuaternion(aiVector3D(0.0f, 0.0f, 1.0f), 0.5f * std::sin(angle));
+	}
+
+	return channel;
+}
+
+static aiAnimation* CreateAnimation(std::string name, const std::vector<aiNodeAnim*>& channels, unsigned int keyCount)
+{
+	aiAnimation* animation = new aiAnimation();
+	animation->mName = aiString(name);
+	animation->mDuration = (double)(keyCount - 1);
+	animation->mTicksPerSecond = 60.0;
+	animation->mNumChannels = (unsigned int)channels.size();
+	animation->mChannels = new aiNodeAnim*[channels.size()];
+	std::copy(channels.begin(), channels.end(), animation->mChannels);
+	return animation;
+}
+
+/** A single large static mesh. */
+static SBenchmarkScene CreateSceneLargeMesh()
+{
+	SBenchmarkScene benchmarkScene;
+	benchmarkScene.Name = "LargeMesh";
+
+	aiScene* scene = new aiScene();
+	SetMaterial(scene);
+
+	aiMesh* mesh = CreateSphere(7, 1.0f);
+	SetMeshList(scene, { mesh });
+	benchmarkScene.VertexCount = mesh->mNumFaces * 3;
+
+	scene->mRootNode = CreateNode("Root", nullptr);
+	SetMeshes(scene->mRootNode, { 0 });
+
+	benchmarkScene.Scene = scene;
+	return benchmarkScene;
+}
+
+/** A chain of nodes, each with its own small mesh and an animation channel. */
+static SBenchmarkScene CreateSceneDeepHierarchy()
+{
+	const unsigned int depth = 1024;
+	const unsigned int keyCount = 2;
+
+	SBenchmarkScene benchmarkScene;
+	benchmarkScene.Name = "DeepHierarchy";
+
+	aiScene* scene = new aiScene();
+	SetMaterial(scene);
+
+	std::vector<aiMesh*> meshes;
+	std::vector<aiNodeAnim*> channels;
+
+	scene->mRootNode = CreateNode("Root", nullptr);
+	aiNode* parent = scene->mRootNode;
+
+	for (unsigned int i = 0; i < depth; ++i)
+	{
+		std::string name = "Node" + std::to_string(i);
+		aiNode* node = CreateNode(name, parent);
+		node->mTransformation = aiMatrix4x4(
+			aiVector3D(1.0f, 1.0f, 1.0f),
+			aiQuaternion(0.0f, 0.01f, 0.0f),
+			aiVector3D(0.0f, 0.1f, 0.0f));
+		SetChildren(parent, { node });
+		SetMeshes(node, { i });
+
+		aiMesh* mesh = CreateSphere(1, 0.05f);
+		benchmarkScene.VertexCount += mesh->mNumFaces * 3;
+		meshes.push_back(mesh);
+
+		channels.push_back(CreateChannel(name, keyCount, (float)i / (float)depth));
+		benchmarkScene.KeyCount += keyCount * 2;
+
+		parent = node;
+	}
+
+	SetMeshList(scene, meshes);
+
+	scene->mNumAnimations = 1;
+	scene->mAnimations = new aiAnimation*[1];
+	scene->mAnimations[0] = CreateAnimation("Wave", channels, keyCount);
+
+	benchmarkScene.Scene = scene;
+	return benchmarkScene;
+}
+
+/** A skinned mesh with 256 bones and dense keyframes on each bone. */
+static SBenchmarkScene CreateSceneSkinned()
+{
+	const unsigned int boneCount = 256;
+	const unsigned int chainCount = 8;
+	const unsigned int keyCount = 60 * 30;
+
+	SBenchmarkScene benchmarkScene;
+	benchmarkScene.Name = "Skinned";
+
+	aiScene* scene = new aiScene();
+	SetMaterial(scene);
+
+	aiMesh* mesh = CreateSphere(5, 1.0f);
+	unsigned int vertexCount = mesh->mNumVertices;
+	benchmarkScene.VertexCount = mesh->mNumFaces * 3;
+
+	// Each vertex is influenced by 4 bones
+	std::vector<std::vector<aiVertexWeight>> weights(boneCount);
+	for (unsigned int i = 0; i < vertexCount; ++i)
+	{
+		for (unsigned int j = 0; j < 4; ++j)
+		{
+			weights[(i + j * 7) % boneCount].push_back(aiVertexWeight(i, 0.25f));
+		}
+	}
+
+	mesh->mNumBones = boneCount;
+	mesh->mBones = new aiBone*[boneCount];
+
+	// Bones form chainCount chains starting at the root node
+	scene->mRootNode = CreateNode("Root", nullptr);
+	aiNode* meshNode = CreateNode("Mesh", scene->mRootNode);
+	SetMeshes(meshNode, { 0 });
+
+	std::vector<aiNode*> rootChildren = { meshNode };
+	std::vector<aiNodeAnim*> channels;
+	aiNode* parent = nullptr;
+
+	for (unsigned int i = 0; i < boneCount; ++i)
+	{
+		std::string name = "Bone" + std::to_string(i);
+		bool chainStart = (i % (boneCount / chainCount) == 0);
+
+		aiNode* node = CreateNode(name, chainStart ? scene->mRootNode : parent);
+		node->mTransformation = aiMatrix4x4(
+			aiVector3D(1.0f, 1.0f, 1.0f),
+			aiQuaternion(0.0f, 0.0f, 0.05f),
+			aiVector3D(0.0f, 0.1f, 0.0f));
+
+		if (chainStart)
+		{
+			rootChildren.push_back(node);
+		}
+		else
+		{
+			SetChildren(parent, { node });
+		}
+
+		aiBone* bone = new aiBone();
+		bone->mName = aiString(name);
+		bone->mNumWeights = (unsigned int)weights[i].size();
+		bone->mWeights = new aiVertexWeight[weights[i].size()];
+		std::copy(weights[i].begin(), weights[i].end(), bone->mWeights);
+		mesh->mBones[i] = bone;
+
+		channels.push_back(CreateChannel(name, keyCount, (float)i / (float)boneCount));
+		benchmarkScene.KeyCount += keyCount * 2;
+
+		parent = node;
+	}
+
+	SetChildren(scene->mRootNode, rootChildren);
+	SetMeshList(scene, { mesh });
+
+	scene->mNumAnimations = 1;
+	scene->mAnimations = new aiAnimation*[1];
+	scene->mAnimations[0] = CreateAnimation("Dance", channels, keyCount);
+
+	benchmarkScene.Scene = scene;
+	return benchmarkScene;
+}
+
+/**
+ * Runs a stage repeat times and returns the time of the fastest run in
+ * milliseconds. The cleanup function is executed after each run and it is
+ * not included in the measured time.
+ */
+static double MeasureStage(size_t repeat, std::function<void()> stage, std::function<void()> cleanup)
+{
+	double best = -1.0;
+
+	for (size_t i = 0; i < repeat; ++i)
+	{
+		SStopwatch stopwatch;
+		stage();
+		double milliseconds = stopwatch.GetMilliseconds();
+
+		if (best < 0.0 || milliseconds < best)
+		{
+			best = milliseconds;
+		}
+
+		if (cleanup && i + 1 < repeat)
+		{
+			cleanup();
+		}
+	}
+
+	return best;
+}
+
+static size_t GetFileSize(const std::string& path)
+{
+	std::error_code error;
+	uintmax_t size = std::filesystem::file_size(path, error);
+	return error ? 0 : (size_t)size;
+}
+
+static void AddResult(
+	std::vector<SBenchmarkResult>& results,
+	const std::string& scene,
+	const std::string& stage,
+	double milliseconds,
+	double amount,
+	const std::string& unit)
+{
+	SBenchmarkResult result;
+	result.Scene = scene;
+	result.Stage = stage;
+	result.Milliseconds = milliseconds;
+	result.Amount = amount;
+	result.Unit = unit;
+	result.PeakMemory = SProfiler::GetPeakMemory();
+	results.push_back(result);
+}
+
+static bool RunScene(const SBenchmarkScene& benchmarkScene, size_t repeat, std::vector<SBenchmarkResult>& results)
+{
+	const std::string& name = benchmarkScene.Name;
+	const aiScene* scene = benchmarkScene.Scene;
+	double vertexCount = (double)benchmarkScene.VertexCount;
+	double keyCount = (double)benchmarkScene.KeyCount;
+	SConfig config;
+
+	std::filesystem::path directory = std::filesystem::temp_directory_path();
+	std::string modelPath = (directory / ("BBMODBenchmark_" + name + ".bbmod")).string();
+	std::string animationPath = (directory / ("BBMODBenchmark_" + name + ".bbanim")).string();
+
+	PRINT_INFO("Running scene %s...", name.c_str());
+
+	// Model
+	SModel* model = nullptr;
+	double milliseconds = MeasureStage(repeat,
+		[&]() { model = SModel::FromAssimp(scene, config); },
+		[&]() { delete model; });
+	AddResult(results, name, "SModel::FromAssimp", milliseconds, vertexCount, "vertices/s");
+
+	// Meshes only, reusing the converted model for the vertex format and bones
+	std::vector<SMesh*> meshes;
+	milliseconds = MeasureStage(repeat,
+		[&]() {
+			for (unsigned int i = 0; i < scene->mNumMeshes; ++i)
+			{
+				meshes.push_back(SMesh::FromAssimp(scene->mMeshes[i], model, config));
+			}
+		},
+		[&]() {
+			for (SMesh* mesh : meshes)
+			{
+				delete mesh;
+			}
+			meshes.clear();
+		});
+	AddResult(results, name, "SMesh::FromAssimp", milliseconds, vertexCount, "vertices/s");
+	for (SMesh* mesh : meshes)
+	{
+		delete mesh;
+	}
+
+	// Save and load
+	bool saved = true;
+	milliseconds = MeasureStage(repeat, [&]() { saved = model->Save(modelPath) && saved; }, nullptr);
+	if (!saved)
+	{
+		PRINT_ERROR("Could not save model to \"%s\"!", modelPath.c_str());
+		return false;
+	}
+	double modelSize = (double)GetFileSize(modelPath);
+	AddResult(results, name, "SModel::Save", milliseconds, modelSize / (1024.0 * 1024.0), "MB/s");
+
+	SModel* modelLoaded = nullptr;
+	milliseconds = MeasureStage(repeat,
+		[&]() { modelLoaded = SModel::Load(modelPath); },
+		[&]() { delete modelLoaded; });
+	if (!modelLoaded)
+	{
+		PRINT_ERROR("Could not load model from \"%s\"!", modelPath.c_str());
+		return false;
+	}
+	AddResult(results, name, "SModel::Load", milliseconds, modelSize / (1024.0 * 1024.0), "MB/s");
+	delete modelLoaded;
+	std::filesystem::remove(modelPath);
+
+	// Animations
+	for (unsigned int i = 0; i < scene->mNumAnimations; ++i)
+	{
+		aiAnimation* aiAnimation = scene->mAnimations[i];
+
+		SAnimation* animation = nullptr;
+		milliseconds = MeasureStage(repeat,
+			[&]() { animation = SAnimation::FromAssimp(aiAnimation, model, config); },
+			[&]() { delete animation; });
+		if (!animation)
+		{
+			PRINT_ERROR("Could not convert animation \"%s\"!", aiAnimation->mName.C_Str());
+			return false;
+		}
+		AddResult(results, name, "SAnimation::FromAssimp", milliseconds, keyCount, "keys/s");
+
+		saved = true;
+		milliseconds = MeasureStage(repeat, [&]() { saved = animation->Save(animationPath) && saved; }, nullptr);
+		if (!saved)
+		{
+			PRINT_ERROR("Could not save animation to \"%s\"!", animationPath.c_str());
+			return false;
+		}
+		double animationSize = (double)GetFileSize(animationPath);
+		AddResult(results, name, "SAnimation::Save", milliseconds, animationSize / (1024.0 * 1024.0), "MB/s");
+
+		SAnimation* animationLoaded = nullptr;
+		milliseconds = MeasureStage(repeat,
+			[&]() { animationLoaded = SAnimation::Load(animationPath); },
+			[&]() { delete animationLoaded; });
+		if (!animationLoaded)
+		{
+			PRINT_ERROR("Could not load animation from \"%s\"!", animationPath.c_str());
+			return false;
+		}
+		AddResult(results, name, "SAnimation::Load", milliseconds, animationSize / (1024.0 * 1024.0), "MB/s");
+
+		delete animationLoaded;
+		delete animation;
+		std::filesystem::remove(animationPath);
+	}
+
+	delete model;
+
+	return true;
+}
+
+static bool SaveResults(const std::string& path, const std::vector<SBenchmarkResult>& results, size_t repeat)
+{
+	std::ofstream file(path, std::ios::out);
+
+	if (!file.is_open())
+	{
+		return false;
+	}
+
+	file << "# BBMOD benchmark, version " << (int)BBMOD_VERSION
+		<< ", fastest of " << repeat << " runs" << std::endl
+		<< "# scene\tstage\tms\tthroughput\tunit\tpeak_mb" << std::endl;
+
+	for (const SBenchmarkResult& result : results)
+	{
+		char line[256];
+		snprintf(line, sizeof(line), "%s\t%s\t%.3f\t%.1f\t%s\t%.1f",
+			result.Scene.c_str(),
+			result.Stage.c_str(),
+			result.Milliseconds,
+			result.GetThroughput(),
+			result.Unit.c_str(),
+			result.PeakMemory / (1024.0 * 1024.0));
+		file << line << std::endl;
+	}
+
+	file.close();
+
+	return true;
+}
+
+/** Loads times in milliseconds from a results file, indexed by "scene stage". */
+static bool LoadBaseline(const std::string& path, std::map<std::string, double>& baseline)
+{
+	std::ifstream file(path, std::ios::in);
+
+	if (!file.is_open())
+	{
+		return false;
+	}
+
+	std::string line;
+	while (std::getline(file, line))
+	{
+		if (line.empty() || line[0] == '#')
+		{
+			continue;
+		}
+
+		std::istringstream stream(line);
+		std::string scene;
+		std::string stage;
+		std::string milliseconds;
+
+		if (std::getline(stream, scene, '\t')
+			&& std::getline(stream, stage, '\t')
+			&& std::getline(stream, milliseconds, '\t'))
+		{
+			baseline[scene + " " + stage] = strtod(milliseconds.c_str(), nullptr);
+		}
+	}
+
+	file.close();
+
+	return true;
+}
+
+static size_t PrintResults(const std::vector<SBenchmarkResult>& results, const std::map<std::string, double>* baseline)
+{
+	size_t regressions = 0;
+
+	printf("\n%-16s %-24s %12s %16s %-11s %10s %10s\n",
+		"Scene", "Stage", "Time [ms]", "Throughput", "", "Peak [MB]", "Change");
+	printf("%s\n", std::string(105, '-').c_str());
+
+	for (const SBenchmarkResult& result : results)
+	{
+		std::string change;
+
+		if (baseline)
+		{
+			auto it = baseline->find(result.Scene + " " + result.Stage);
+			if (it != baseline->end() && it->second > 0.0)
+			{
+				double ratio = (result.Milliseconds - it->second) / it->second;
+				char buffer[32];
+				snprintf(buffer, sizeof(buffer), "%+.1f%%", ratio * 100.0);
+				change = buffer;
+
+				if (ratio > BBMOD_BENCHMARK_THRESHOLD)
+				{
+					change += " !";
+					++regressions;
+				}
+			}
+			else
+			{
+				change = "new";
+			}
+		}
+
+		printf("%-16s %-24s %12.3f %16.1f %-11s %10.1f %10s\n",
+			result.Scene.c_str(),
+			result.Stage.c_str(),
+			result.Milliseconds,
+			result.GetThroughput(),
+			result.Unit.c_str(),
+			result.PeakMemory / (1024.0 * 1024.0),
+			change.c_str());
+	}
+
+	printf("%s\n\n", std::string(105, '-').c_str());
+
+	return regressions;
+}
+
+int main(int argc, const char* argv[])
+{
+	if (!InitTerminal())
+	{
+		return EXIT_FAILURE;
+	}
+
+	const char* resultsPath = nullptr;
+	const char* baselinePath = nullptr;
+	size_t repeat = BBMOD_BENCHMARK_REPEAT;
+
+	std::regex options_regex("(-[a-z]+|--[a-z\\-]+)=([0-9]+)");
+	std::cmatch match;
+
+	for (int i = 1; i < argc; ++i)
+	{
+		if (*argv[i] == '-')
+		{
+			if (strcmp(argv[i], "-h") == 0)
+			{
+				PrintHelp();
+				return EXIT_SUCCESS;
+			}
+			else if (std::regex_match(argv[i], match, options_regex))
+			{
+				auto o = match[1];
+				size_t n = (size_t)strtol(match[2].str().c_str(), (char**)NULL, 10);
+
+				if (o == "-r" || o == "--repeat")
+				{
+					repeat = std::max(n, (size_t)1);
+				}
+				else
+				{
+					PRINT_ERROR("Unrecognized option %s!", argv[i]);
+					return EXIT_FAILURE;
+				}
+			}
+			else
+			{
+				PRINT_ERROR("Unrecognized option %s!", argv[i]);
+				return EXIT_FAILURE;
+			}
+		}
+		else if (!resultsPath)
+		{
+			resultsPath = argv[i];
+		}
+		else if (!baselinePath)
+		{
+			baselinePath = argv[i];
+		}
+		else
+		{
+			PRINT_ERROR("Too many arguments!");
+			std::cout << std::endl << gUsage << std::endl;
+			return EXIT_FAILURE;
+		}
+	}
+
+	if (!resultsPath)
+	{
+		resultsPath = "benchmark.txt";
+	}
+
+	std::map<std::string, double> baseline;
+	if (baselinePath && !LoadBaseline(baselinePath, baseline))
+	{
+		PRINT_ERROR("Could not load baseline from \"%s\"!", baselinePath);
+		return EXIT_FAILURE;
+	}
+
+	std::vector<SBenchmarkResult> results;
+	std::vector<std::function<SBenchmarkScene()>> generators = {
+		CreateSceneLargeMesh,
+		CreateSceneDeepHierarchy,
+		CreateSceneSkinned,
+	};
+
+	for (auto& generator : generators)
+	{
+		SBenchmarkScene benchmarkScene = generator();
+		bool success = RunScene(benchmarkScene, repeat, results);
+		delete benchmarkScene.Scene;
+
+		if (!success)
+		{
+			return EXIT_FAILURE;
+		}
+	}
+
+	size_t regressions = PrintResults(results, baselinePath ? &baseline : nullptr);
+
+	if (!SaveResults(resultsPath, results, repeat))
+	{
+		PRINT_ERROR("Could not save results to \"%s\"!", resultsPath);
+		return EXIT_FAILURE;
+	}
+
+	PRINT_SUCCESS("Results saved to \"%s\"!", resultsPath);
+
+	if (regressions > 0)
+	{
+		PRINT_WARNING("%d stages are more than %d%% slower than the baseline!",
+			(int)regressions, (int)(BBMOD_BENCHMARK_THRESHOLD * 100.0));
+	}
+
+	return EXIT_SUCCESS;
+}
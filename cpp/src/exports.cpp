@@ -1,6 +1,15 @@
 #ifdef _WINDLL
 
 #include <BBMOD/Importer.hpp>
+#include <BBMOD/Pose.hpp>
+#include <BBMOD/Crowd.hpp>
+#include <BBMOD/Skinning.hpp>
+#include <BBMOD/StaticBatch.hpp>
+#include <BBMOD/ModelBlob.hpp>
+#include <BBMOD/Streamer.hpp>
+
+#include <cstring>
+#include <vector>
 
 #define GM_EXPORT extern "C" __declspec (dllexport)
 
@@ -16,6 +25,151 @@ typedef void* gmptr_t;
 
 SConfig gConfig;
 
+/** Models loaded through bbmod_dll_model_load, indexed by handles. */
+std::vector<SModel*> gModels;
+
+/** Model blobs loaded through bbmod_dll_blob_load, indexed by handles. */
+std::vector<SModelBlob*> gBlobs;
+
+/** Animations loaded through bbmod_dll_animation_load, indexed by handles. */
+std::vector<SAnimation*> gAnimations;
+
+/** Poses created through bbmod_dll_pose_create, indexed by handles. */
+std::vector<SPose*> gPoses;
+
+/** Masks created through bbmod_dll_mask_create, indexed by handles. */
+std::vector<SPoseMask*> gMasks;
+
+/** Animation instances created through bbmod_dll_instance_create, indexed by handles. */
+std::vector<SAnimationInstance*> gInstances;
+
+/**
+ * The job system used by bbmod_dll_update_all. Created on first use, so no
+ * threads are started while the DLL is being loaded, and never destroyed,
+ * since joining threads while the DLL is being unloaded can deadlock.
+ */
+SJobSystem* gJobSystem = nullptr;
+
+/** Number of worker threads of gJobSystem, 0 for default. */
+size_t gThreadCount = 0;
+
+/**
+ * The streamer used by bbmod_dll_stream_* functions. Like gJobSystem, it is
+ * created on first use and never destroyed.
+ */
+SStreamer* gStreamer = nullptr;
+
+/** Returns gJobSystem, creating it if it does not exist yet. */
+static SJobSystem& GetJobSystem()
+{
+	if (!gJobSystem)
+	{
+		gJobSystem = new SJobSystem(gThreadCount);
+	}
+	return *gJobSystem;
+}
+
+/** Returns gStreamer, creating it if it does not exist yet. */
+static SStreamer& GetStreamer()
+{
+	if (!gStreamer)
+	{
+		gStreamer = new SStreamer();
+	}
+	return *gStreamer;
+}
+
+/** Waits for animation instances to finish updating. */
+static void WaitForJobs()
+{
+	if (gJobSystem)
+	{
+		gJobSystem->Wait();
+	}
+}
+
+/** Stores an object into the first free slot and returns its handle. */
+template<typename T>
+static gmreal_t AddHandle(std::vector<T*>& handles, T* object)
+{
+	for (size_t i = 0; i < handles.size(); ++i)
+	{
+		if (!handles[i])
+		{
+			handles[i] = object;
+			return (gmreal_t)i;
+		}
+	}
+	handles.push_back(object);
+	return (gmreal_t)(handles.size() - 1);
+}
+
+/** Returns an object with given handle or nullptr if the handle is not valid. */
+template<typename T>
+static T* GetHandle(const std::vector<T*>& handles, gmreal_t handle)
+{
+	if (handle < 0.0 || (size_t)handle >= handles.size())
+	{
+		return nullptr;
+	}
+	return handles[(size_t)handle];
+}
+
+/** Deletes an object with given handle and frees the handle. */
+template<typename T>
+static gmreal_t DestroyHandle(std::vector<T*>& handles, gmreal_t handle)
+{
+	WaitForJobs();
+	T* object = GetHandle(handles, handle);
+	if (!object)
+	{
+		return BBMOD_FAILURE;
+	}
+	delete object;
+	handles[(size_t)handle] = nullptr;
+	return BBMOD_SUCCESS;
+}
+
+/** Returns true if a pose, a mask or an animation instance still references a model. */
+static bool IsModelUsed(const SModel* model)
+{
+	for (const SPose* pose : gPoses)
+	{
+		if (pose && pose->Model == model)
+		{
+			return true;
+		}
+	}
+	for (const SPoseMask* mask : gMasks)
+	{
+		if (mask && mask->Model == model)
+		{
+			return true;
+		}
+	}
+	for (const SAnimationInstance* instance : gInstances)
+	{
+		if (instance && instance->Pose.Model == model)
+		{
+			return true;
+		}
+	}
+	return false;
+}
+
+/** Returns true if an animation instance still plays an animation. */
+static bool IsAnimationUsed(const SAnimation* animation)
+{
+	for (const SAnimationInstance* instance : gInstances)
+	{
+		if (instance && instance->Animation == animation)
+		{
+			return true;
+		}
+	}
+	return false;
+}
+
 GM_EXPORT gmreal_t bbmod_dll_get_left_handed()
 {
 	return (gmreal_t)gConfig.LeftHanded;
@@ -159,6 +313,285 @@ GM_EXPORT gmreal_t bbmod_dll_set_optimize_meshes(gmreal_t optimize)
 	return BBMOD_SUCCESS;
 }
 
+GM_EXPORT gmreal_t bbmod_dll_get_batch_size()
+{
+	return (gmreal_t)gConfig.BatchSize;
+}
+
+GM_EXPORT gmreal_t bbmod_dll_set_batch_size(gmreal_t batchSize)
+{
+	if (batchSize < 0.0)
+	{
+		return BBMOD_FAILURE;
+	}
+	gConfig.BatchSize = (size_t)batchSize;
+	return BBMOD_SUCCESS;
+}
+
+GM_EXPORT gmreal_t bbmod_dll_get_detect_instances()
+{
+	return (gmreal_t)gConfig.DetectInstances;
+}
+
+GM_EXPORT gmreal_t bbmod_dll_set_detect_instances(gmreal_t detect)
+{
+	gConfig.DetectInstances = (bool)detect;
+	return BBMOD_SUCCESS;
+}
+
+GM_EXPORT gmreal_t bbmod_dll_get_cell_size()
+{
+	return (gmreal_t)gConfig.CellSize;
+}
+
+GM_EXPORT gmreal_t bbmod_dll_set_cell_size(gmreal_t cellSize)
+{
+	if (cellSize < 0.0)
+	{
+		return BBMOD_FAILURE;
+	}
+	gConfig.CellSize = (float)cellSize;
+	return BBMOD_SUCCESS;
+}
+
+GM_EXPORT gmreal_t bbmod_dll_get_build_bvh()
+{
+	return (gmreal_t)gConfig.BuildBVH;
+}
+
+GM_EXPORT gmreal_t bbmod_dll_set_build_bvh(gmreal_t build)
+{
+	gConfig.BuildBVH = (bool)build;
+	return BBMOD_SUCCESS;
+}
+
+GM_EXPORT gmreal_t bbmod_dll_get_hull_count()
+{
+	return (gmreal_t)gConfig.HullCount;
+}
+
+GM_EXPORT gmreal_t bbmod_dll_set_hull_count(gmreal_t hullCount)
+{
+	if (hullCount < 0.0)
+	{
+		return BBMOD_FAILURE;
+	}
+	gConfig.HullCount = (size_t)hullCount;
+	return BBMOD_SUCCESS;
+}
+
+GM_EXPORT gmreal_t bbmod_dll_get_hull_vertex_count()
+{
+	return (gmreal_t)gConfig.HullVertexCount;
+}
+
+GM_EXPORT gmreal_t bbmod_dll_set_hull_vertex_count(gmreal_t vertexCount)
+{
+	if (vertexCount < 4.0)
+	{
+		return BBMOD_FAILURE;
+	}
+	gConfig.HullVertexCount = (size_t)vertexCount;
+	return BBMOD_SUCCESS;
+}
+
+GM_EXPORT gmreal_t bbmod_dll_get_ao_ray_count()
+{
+	return (gmreal_t)gConfig.AORayCount;
+}
+
+GM_EXPORT gmreal_t bbmod_dll_set_ao_ray_count(gmreal_t rayCount)
+{
+	if (rayCount < 0.0)
+	{
+		return BBMOD_FAILURE;
+	}
+	gConfig.AORayCount = (size_t)rayCount;
+	return BBMOD_SUCCESS;
+}
+
+GM_EXPORT gmreal_t bbmod_dll_get_ao_distance()
+{
+	return (gmreal_t)gConfig.AODistance;
+}
+
+GM_EXPORT gmreal_t bbmod_dll_set_ao_distance(gmreal_t distance)
+{
+	if (distance < 0.0)
+	{
+		return BBMOD_FAILURE;
+	}
+	gConfig.AODistance = (float)distance;
+	return BBMOD_SUCCESS;
+}
+
+GM_EXPORT gmreal_t bbmod_dll_get_bent_normals()
+{
+	return (gmreal_t)gConfig.BentNormals;
+}
+
+GM_EXPORT gmreal_t bbmod_dll_set_bent_normals(gmreal_t bentNormals)
+{
+	gConfig.BentNormals = (bool)bentNormals;
+	return BBMOD_SUCCESS;
+}
+
+GM_EXPORT gmreal_t bbmod_dll_get_shadow_proxies()
+{
+	return (gmreal_t)gConfig.ShadowProxies;
+}
+
+GM_EXPORT gmreal_t bbmod_dll_set_shadow_proxies(gmreal_t shadowProxies)
+{
+	gConfig.ShadowProxies = (bool)shadowProxies;
+	return BBMOD_SUCCESS;
+}
+
+GM_EXPORT gmreal_t bbmod_dll_get_shadow_grid_size()
+{
+	return (gmreal_t)gConfig.ShadowGridSize;
+}
+
+GM_EXPORT gmreal_t bbmod_dll_set_shadow_grid_size(gmreal_t gridSize)
+{
+	if (gridSize < 0.0)
+	{
+		return BBMOD_FAILURE;
+	}
+	gConfig.ShadowGridSize = (size_t)gridSize;
+	return BBMOD_SUCCESS;
+}
+
+GM_EXPORT gmreal_t bbmod_dll_get_triangle_strips()
+{
+	return (gmreal_t)gConfig.TriangleStrips;
+}
+
+GM_EXPORT gmreal_t bbmod_dll_set_triangle_strips(gmreal_t triangleStrips)
+{
+	gConfig.TriangleStrips = (bool)triangleStrips;
+	return BBMOD_SUCCESS;
+}
+
+GM_EXPORT gmreal_t bbmod_dll_get_optimize_overdraw()
+{
+	return (gmreal_t)gConfig.OptimizeOverdraw;
+}
+
+GM_EXPORT gmreal_t bbmod_dll_set_optimize_overdraw(gmreal_t optimize)
+{
+	gConfig.OptimizeOverdraw = (bool)optimize;
+	return BBMOD_SUCCESS;
+}
+
+GM_EXPORT gmreal_t bbmod_dll_get_weld_distance()
+{
+	return (gmreal_t)gConfig.WeldDistance;
+}
+
+GM_EXPORT gmreal_t bbmod_dll_set_weld_distance(gmreal_t distance)
+{
+	if (distance < 0.0)
+	{
+		return BBMOD_FAILURE;
+	}
+	gConfig.WeldDistance = (float)distance;
+	return BBMOD_SUCCESS;
+}
+
+GM_EXPORT gmreal_t bbmod_dll_get_weld_angle()
+{
+	return (gmreal_t)gConfig.WeldAngle;
+}
+
+GM_EXPORT gmreal_t bbmod_dll_set_weld_angle(gmreal_t angle)
+{
+	if (angle < 0.0)
+	{
+		return BBMOD_FAILURE;
+	}
+	gConfig.WeldAngle = (float)angle;
+	return BBMOD_SUCCESS;
+}
+
+GM_EXPORT gmreal_t bbmod_dll_get_weld_uv_distance()
+{
+	return (gmreal_t)gConfig.WeldUVDistance;
+}
+
+GM_EXPORT gmreal_t bbmod_dll_set_weld_uv_distance(gmreal_t distance)
+{
+	if (distance < 0.0)
+	{
+		return BBMOD_FAILURE;
+	}
+	gConfig.WeldUVDistance = (float)distance;
+	return BBMOD_SUCCESS;
+}
+
+GM_EXPORT gmreal_t bbmod_dll_get_native_post_process()
+{
+	return (gmreal_t)gConfig.NativePostProcess;
+}
+
+GM_EXPORT gmreal_t bbmod_dll_set_native_post_process(gmreal_t native)
+{
+	gConfig.NativePostProcess = (bool)native;
+	return BBMOD_SUCCESS;
+}
+
+GM_EXPORT gmreal_t bbmod_dll_get_normal_angle()
+{
+	return (gmreal_t)gConfig.NormalAngle;
+}
+
+GM_EXPORT gmreal_t bbmod_dll_set_normal_angle(gmreal_t angle)
+{
+	if (angle < 0.0)
+	{
+		return BBMOD_FAILURE;
+	}
+	gConfig.NormalAngle = (float)angle;
+	return BBMOD_SUCCESS;
+}
+
+GM_EXPORT gmreal_t bbmod_dll_get_split_influences()
+{
+	return (gmreal_t)gConfig.SplitInfluences;
+}
+
+GM_EXPORT gmreal_t bbmod_dll_set_split_influences(gmreal_t split)
+{
+	gConfig.SplitInfluences = (bool)split;
+	return BBMOD_SUCCESS;
+}
+
+GM_EXPORT gmreal_t bbmod_dll_get_weight_threshold()
+{
+	return (gmreal_t)gConfig.WeightThreshold;
+}
+
+GM_EXPORT gmreal_t bbmod_dll_set_weight_threshold(gmreal_t threshold)
+{
+	if (threshold < 0.0)
+	{
+		return BBMOD_FAILURE;
+	}
+	gConfig.WeightThreshold = (float)threshold;
+	return BBMOD_SUCCESS;
+}
+
+GM_EXPORT gmreal_t bbmod_dll_get_merge_rigid()
+{
+	return (gmreal_t)gConfig.MergeRigid;
+}
+
+GM_EXPORT gmreal_t bbmod_dll_set_merge_rigid(gmreal_t merge)
+{
+	gConfig.MergeRigid = (bool)merge;
+	return BBMOD_SUCCESS;
+}
+
 GM_EXPORT gmreal_t bbmod_dll_get_optimize_nodes()
 {
 	return (gmreal_t)gConfig.OptimizeNodes;
@@ -175,4 +608,450 @@ GM_EXPORT gmreal_t bbmod_dll_convert(gmstring_t fin, gmstring_t fout)
 	return ConvertToBBMOD(fin, fout, gConfig);
 }
 
+GM_EXPORT gmreal_t bbmod_dll_model_load(gmstring_t path)
+{
+	SModel* model = SModel::Load(path);
+	if (!model)
+	{
+		return BBMOD_FAILURE;
+	}
+	return AddHandle(gModels, model);
+}
+
+GM_EXPORT gmreal_t bbmod_dll_model_destroy(gmreal_t modelHandle)
+{
+	SModel* model = GetHandle(gModels, modelHandle);
+	if (!model || IsModelUsed(model))
+	{
+		return BBMOD_FAILURE;
+	}
+	return DestroyHandle(gModels, modelHandle);
+}
+
+GM_EXPORT gmreal_t bbmod_dll_model_get_skinned_size(gmreal_t modelHandle, gmreal_t meshIndex)
+{
+	SModel* model = GetHandle(gModels, modelHandle);
+	if (!model || meshIndex < 0.0 || (size_t)meshIndex >= model->Meshes.size())
+	{
+		return BBMOD_FAILURE;
+	}
+	SMesh* mesh = model->Meshes[(size_t)meshIndex];
+	return (gmreal_t)(mesh->Data.size() * GetSkinnedVertexSize(mesh->VertexFormat));
+}
+
+GM_EXPORT gmreal_t bbmod_dll_model_skin_mesh(gmreal_t modelHandle, gmreal_t meshIndex, gmptr_t transform, gmptr_t buffer)
+{
+	SModel* model = GetHandle(gModels, modelHandle);
+	if (!model || meshIndex < 0.0 || (size_t)meshIndex >= model->Meshes.size() || !transform || !buffer)
+	{
+		return BBMOD_FAILURE;
+	}
+	SkinMesh(model->Meshes[(size_t)meshIndex], (float*)transform, model->BoneCount,
+		(unsigned char*)buffer, GetJobSystem());
+	return BBMOD_SUCCESS;
+}
+
+GM_EXPORT gmreal_t bbmod_dll_model_get_static_batch_size(gmreal_t modelHandle, gmreal_t instanceCount)
+{
+	SModel* model = GetHandle(gModels, modelHandle);
+	if (!model || instanceCount < 0.0)
+	{
+		return BBMOD_FAILURE;
+	}
+	return (gmreal_t)GetStaticBatchSize(model, (size_t)instanceCount);
+}
+
+GM_EXPORT gmreal_t bbmod_dll_model_to_static_batch(gmreal_t modelHandle, gmptr_t transforms, gmreal_t instanceCount, gmptr_t buffer)
+{
+	SModel* model = GetHandle(gModels, modelHandle);
+	if (!model || !transforms || !buffer || instanceCount < 0.0)
+	{
+		return BBMOD_FAILURE;
+	}
+	BuildStaticBatch(model, (const float*)transforms, (size_t)instanceCount,
+		(unsigned char*)buffer, GetJobSystem());
+	return BBMOD_SUCCESS;
+}
+
+GM_EXPORT gmreal_t bbmod_dll_model_has_bvh(gmreal_t modelHandle)
+{
+	SModel* model = GetHandle(gModels, modelHandle);
+	if (!model)
+	{
+		return BBMOD_FAILURE;
+	}
+	return (gmreal_t)(model->BVH != nullptr);
+}
+
+GM_EXPORT gmreal_t bbmod_dll_model_raycast(gmreal_t modelHandle, gmptr_t rays, gmreal_t rayCount, gmptr_t hits)
+{
+	SModel* model = GetHandle(gModels, modelHandle);
+	if (!model || !model->BVH || !rays || !hits || rayCount < 0.0)
+	{
+		return BBMOD_FAILURE;
+	}
+	return (gmreal_t)RaycastBatch(model->BVH, (const float*)rays, (size_t)rayCount,
+		(float*)hits, GetJobSystem());
+}
+
+GM_EXPORT gmreal_t bbmod_dll_model_overlap_sphere(gmreal_t modelHandle, gmptr_t spheres, gmreal_t sphereCount, gmptr_t hits)
+{
+	SModel* model = GetHandle(gModels, modelHandle);
+	if (!model || !model->BVH || !spheres || !hits || sphereCount < 0.0)
+	{
+		return BBMOD_FAILURE;
+	}
+	return (gmreal_t)OverlapSphereBatch(model->BVH, (const float*)spheres, (size_t)sphereCount,
+		(float*)hits, GetJobSystem());
+}
+
+GM_EXPORT gmreal_t bbmod_dll_blob_load(gmstring_t path)
+{
+	SModelBlob* blob = SModelBlob::Load(path);
+	if (!blob)
+	{
+		return BBMOD_FAILURE;
+	}
+	return AddHandle(gBlobs, blob);
+}
+
+GM_EXPORT gmreal_t bbmod_dll_blob_get_size(gmreal_t blobHandle)
+{
+	SModelBlob* blob = GetHandle(gBlobs, blobHandle);
+	return blob ? (gmreal_t)blob->Data.size() : BBMOD_FAILURE;
+}
+
+GM_EXPORT gmreal_t bbmod_dll_blob_write(gmreal_t blobHandle, gmptr_t buffer)
+{
+	SModelBlob* blob = GetHandle(gBlobs, blobHandle);
+	if (!blob || !buffer)
+	{
+		return BBMOD_FAILURE;
+	}
+	std::memcpy(buffer, blob->Data.data(), blob->Data.size());
+	return BBMOD_SUCCESS;
+}
+
+GM_EXPORT gmreal_t bbmod_dll_blob_destroy(gmreal_t blobHandle)
+{
+	return DestroyHandle(gBlobs, blobHandle);
+}
+
+GM_EXPORT gmreal_t bbmod_dll_animation_load(gmstring_t path)
+{
+	SAnimation* animation = SAnimation::Load(path);
+	if (!animation)
+	{
+		return BBMOD_FAILURE;
+	}
+	return AddHandle(gAnimations, animation);
+}
+
+GM_EXPORT gmreal_t bbmod_dll_animation_get_duration(gmreal_t animationHandle)
+{
+	SAnimation* animation = GetHandle(gAnimations, animationHandle);
+	return animation ? (gmreal_t)animation->Duration : BBMOD_FAILURE;
+}
+
+GM_EXPORT gmreal_t bbmod_dll_animation_get_tics_per_second(gmreal_t animationHandle)
+{
+	SAnimation* animation = GetHandle(gAnimations, animationHandle);
+	return animation ? (gmreal_t)animation->TicsPerSecond : BBMOD_FAILURE;
+}
+
+GM_EXPORT gmreal_t bbmod_dll_animation_destroy(gmreal_t animationHandle)
+{
+	WaitForJobs();
+	SAnimation* animation = GetHandle(gAnimations, animationHandle);
+	if (!animation || IsAnimationUsed(animation))
+	{
+		return BBMOD_FAILURE;
+	}
+	// Poses only remember the last sampled animation to reuse found keys, so
+	// a new animation loaded at the same address must not match it
+	for (SPose* pose : gPoses)
+	{
+		if (pose && pose->AnimationLast == animation)
+		{
+			pose->AnimationLast = nullptr;
+		}
+	}
+	for (SAnimationInstance* instance : gInstances)
+	{
+		if (instance)
+		{
+			if (instance->Pose.AnimationLast == animation)
+			{
+				instance->Pose.AnimationLast = nullptr;
+			}
+			if (instance->PoseFrom.AnimationLast == animation)
+			{
+				instance->PoseFrom.AnimationLast = nullptr;
+			}
+		}
+	}
+	return DestroyHandle(gAnimations, animationHandle);
+}
+
+GM_EXPORT gmreal_t bbmod_dll_pose_create(gmreal_t modelHandle)
+{
+	SModel* model = GetHandle(gModels, modelHandle);
+	if (!model)
+	{
+		return BBMOD_FAILURE;
+	}
+	return AddHandle(gPoses, new SPose(model));
+}
+
+GM_EXPORT gmreal_t bbmod_dll_pose_sample(gmreal_t poseHandle, gmreal_t animationHandle, gmreal_t time, gmreal_t interpolate)
+{
+	SPose* pose = GetHandle(gPoses, poseHandle);
+	SAnimation* animation = GetHandle(gAnimations, animationHandle);
+	if (!pose || !animation)
+	{
+		return BBMOD_FAILURE;
+	}
+	pose->Sample(animation, time, (bool)interpolate);
+	return BBMOD_SUCCESS;
+}
+
+GM_EXPORT gmreal_t bbmod_dll_pose_transform(gmreal_t poseHandle, gmptr_t buffer)
+{
+	SPose* pose = GetHandle(gPoses, poseHandle);
+	if (!pose || !buffer)
+	{
+		return BBMOD_FAILURE;
+	}
+	pose->Transform((float*)buffer);
+	return BBMOD_SUCCESS;
+}
+
+GM_EXPORT gmreal_t bbmod_dll_pose_get_node_transform(gmreal_t poseHandle, gmreal_t node, gmptr_t buffer)
+{
+	SPose* pose = GetHandle(gPoses, poseHandle);
+	if (!pose || !buffer || node < 0.0 || (size_t)node >= pose->Model->NodeCount)
+	{
+		return BBMOD_FAILURE;
+	}
+	std::memcpy(buffer, pose->GetNodeTransform((size_t)node), sizeof(float) * 16);
+	return BBMOD_SUCCESS;
+}
+
+GM_EXPORT gmreal_t bbmod_dll_pose_copy(gmreal_t poseHandle, gmreal_t otherHandle)
+{
+	SPose* pose = GetHandle(gPoses, poseHandle);
+	SPose* other = GetHandle(gPoses, otherHandle);
+	if (!pose || !other || pose->Model != other->Model)
+	{
+		return BBMOD_FAILURE;
+	}
+	pose->Copy(*other);
+	return BBMOD_SUCCESS;
+}
+
+GM_EXPORT gmreal_t bbmod_dll_pose_blend(gmreal_t poseHandle, gmreal_t otherHandle, gmreal_t factor, gmreal_t maskHandle)
+{
+	SPose* pose = GetHandle(gPoses, poseHandle);
+	SPose* other = GetHandle(gPoses, otherHandle);
+	SPoseMask* mask = GetHandle(gMasks, maskHandle);
+	if (!pose || !other || pose->Model != other->Model)
+	{
+		return BBMOD_FAILURE;
+	}
+	pose->Blend(*other, (float)factor, mask);
+	return BBMOD_SUCCESS;
+}
+
+GM_EXPORT gmreal_t bbmod_dll_pose_destroy(gmreal_t poseHandle)
+{
+	return DestroyHandle(gPoses, poseHandle);
+}
+
+GM_EXPORT gmreal_t bbmod_dll_mask_create(gmreal_t modelHandle)
+{
+	SModel* model = GetHandle(gModels, modelHandle);
+	if (!model)
+	{
+		return BBMOD_FAILURE;
+	}
+	return AddHandle(gMasks, new SPoseMask(model));
+}
+
+GM_EXPORT gmreal_t bbmod_dll_mask_set_weight(gmreal_t maskHandle, gmreal_t node, gmreal_t weight, gmreal_t children)
+{
+	SPoseMask* mask = GetHandle(gMasks, maskHandle);
+	if (!mask || node < 0.0 || !mask->SetWeight((size_t)node, (float)weight, (bool)children))
+	{
+		return BBMOD_FAILURE;
+	}
+	return BBMOD_SUCCESS;
+}
+
+GM_EXPORT gmreal_t bbmod_dll_mask_destroy(gmreal_t maskHandle)
+{
+	return DestroyHandle(gMasks, maskHandle);
+}
+
+GM_EXPORT gmreal_t bbmod_dll_instance_create(gmreal_t modelHandle, gmreal_t animationHandle, gmreal_t time, gmreal_t speed)
+{
+	SModel* model = GetHandle(gModels, modelHandle);
+	if (!model)
+	{
+		return BBMOD_FAILURE;
+	}
+	WaitForJobs();
+	SAnimationInstance* instance = new SAnimationInstance(model);
+	instance->Animation = GetHandle(gAnimations, animationHandle);
+	instance->Time = time;
+	instance->Speed = speed;
+	return AddHandle(gInstances, instance);
+}
+
+GM_EXPORT gmreal_t bbmod_dll_instance_set_buffer(gmreal_t instanceHandle, gmptr_t buffer)
+{
+	WaitForJobs();
+	SAnimationInstance* instance = GetHandle(gInstances, instanceHandle);
+	if (!instance)
+	{
+		return BBMOD_FAILURE;
+	}
+	instance->Transform = (float*)buffer;
+	return BBMOD_SUCCESS;
+}
+
+GM_EXPORT gmreal_t bbmod_dll_instance_play(gmreal_t instanceHandle, gmreal_t animationHandle, gmreal_t time, gmreal_t transition)
+{
+	WaitForJobs();
+	SAnimationInstance* instance = GetHandle(gInstances, instanceHandle);
+	if (!instance)
+	{
+		return BBMOD_FAILURE;
+	}
+	instance->Play(GetHandle(gAnimations, animationHandle), time, transition);
+	return BBMOD_SUCCESS;
+}
+
+GM_EXPORT gmreal_t bbmod_dll_instance_set_speed(gmreal_t instanceHandle, gmreal_t speed)
+{
+	WaitForJobs();
+	SAnimationInstance* instance = GetHandle(gInstances, instanceHandle);
+	if (!instance)
+	{
+		return BBMOD_FAILURE;
+	}
+	instance->Speed = speed;
+	return BBMOD_SUCCESS;
+}
+
+GM_EXPORT gmreal_t bbmod_dll_instance_destroy(gmreal_t instanceHandle)
+{
+	return DestroyHandle(gInstances, instanceHandle);
+}
+
+GM_EXPORT gmreal_t bbmod_dll_get_thread_count()
+{
+	return (gmreal_t)(gJobSystem ? gJobSystem->GetThreadCount() : gThreadCount);
+}
+
+GM_EXPORT gmreal_t bbmod_dll_set_thread_count(gmreal_t count)
+{
+	if (count < 0.0)
+	{
+		return BBMOD_FAILURE;
+	}
+	gThreadCount = (size_t)count;
+	if (gJobSystem)
+	{
+		delete gJobSystem;
+		gJobSystem = nullptr;
+	}
+	return BBMOD_SUCCESS;
+}
+
+GM_EXPORT gmreal_t bbmod_dll_update_all(gmreal_t deltaTime)
+{
+	UpdateAnimationInstances(gInstances, deltaTime, GetJobSystem());
+	return BBMOD_SUCCESS;
+}
+
+GM_EXPORT gmreal_t bbmod_dll_wait()
+{
+	WaitForJobs();
+	return BBMOD_SUCCESS;
+}
+
+GM_EXPORT gmreal_t bbmod_dll_stream_load(gmstring_t path, gmreal_t type, gmreal_t priority)
+{
+	if (type != BBMOD_STREAM_MODEL && type != BBMOD_STREAM_ANIMATION)
+	{
+		return BBMOD_FAILURE;
+	}
+	return (gmreal_t)GetStreamer().Enqueue(path, (int)type, priority);
+}
+
+GM_EXPORT gmreal_t bbmod_dll_stream_remove(gmreal_t id)
+{
+	if (id < 0.0)
+	{
+		return BBMOD_FAILURE;
+	}
+	return GetStreamer().Remove((size_t)id) ? BBMOD_SUCCESS : BBMOD_FAILURE;
+}
+
+GM_EXPORT gmreal_t bbmod_dll_stream_poll()
+{
+	size_t id;
+	return GetStreamer().Poll(id) ? (gmreal_t)id : BBMOD_FAILURE;
+}
+
+GM_EXPORT gmreal_t bbmod_dll_stream_get_state(gmreal_t id)
+{
+	if (id < 0.0)
+	{
+		return BBMOD_FAILURE;
+	}
+	return (gmreal_t)GetStreamer().GetState((size_t)id);
+}
+
+GM_EXPORT gmreal_t bbmod_dll_stream_get_size(gmreal_t id)
+{
+	size_t size;
+	if (id < 0.0 || !GetStreamer().GetData((size_t)id, nullptr, size))
+	{
+		return BBMOD_FAILURE;
+	}
+	return (gmreal_t)size;
+}
+
+GM_EXPORT gmreal_t bbmod_dll_stream_write(gmreal_t id, gmptr_t buffer)
+{
+	size_t size;
+	if (id < 0.0 || !buffer
+		|| !GetStreamer().GetData((size_t)id, (unsigned char*)buffer, size))
+	{
+		return BBMOD_FAILURE;
+	}
+	return BBMOD_SUCCESS;
+}
+
+GM_EXPORT gmreal_t bbmod_dll_stream_get_budget()
+{
+	return (gmreal_t)GetStreamer().GetBudget();
+}
+
+GM_EXPORT gmreal_t bbmod_dll_stream_set_budget(gmreal_t budget)
+{
+	if (budget < 0.0)
+	{
+		return BBMOD_FAILURE;
+	}
+	GetStreamer().SetBudget((size_t)budget);
+	return BBMOD_SUCCESS;
+}
+
+GM_EXPORT gmreal_t bbmod_dll_stream_get_staged_size()
+{
+	return (gmreal_t)GetStreamer().GetStagedSize();
+}
+
 #endif // _WINDLL
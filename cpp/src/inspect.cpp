@@ -0,0 +1,101 @@
+#include <BBMOD/Inspector.hpp>
+#include <terminal.hpp>
+#include <iostream>
+#include <filesystem>
+#include <string>
+#include <cstdlib>
+#include <cstring>
+
+const char* gUsage = "Usage: BBMODInspect.exe [-h] file [file...]";
+
+void PrintHelp()
+{
+	std::cout
+		<< gUsage << std::endl
+		<< std::endl
+		<< "Prints size breakdown, vertex and key statistics and estimated runtime cost of" << std::endl
+		<< "converted models and animations, together with converter options that would" << std::endl
+		<< "make them smaller or faster." << std::endl
+		<< std::endl
+		<< "Arguments:" << std::endl
+		<< std::endl
+		<< "  -h                                   Show this help message and exit." << std::endl
+		<< "  file                                 Path to a *.bbmod or *.bbanim file. Animations are" << std::endl
+		<< "                                       inspected against the last model preceding them," << std::endl
+		<< "                                       e.g. Character.bbmod Character_walk.bbanim." << std::endl
+		<< std::endl;
+}
+
+int main(int argc, const char* argv[])
+{
+	if (!InitTerminal())
+	{
+		return EXIT_FAILURE;
+	}
+
+	std::vector<const char*> files;
+
+	for (int i = 1; i < argc; ++i)
+	{
+		if (*argv[i] == '-')
+		{
+			if (strcmp(argv[i], "-h") == 0)
+			{
+				PrintHelp();
+				return EXIT_SUCCESS;
+			}
+
+			PRINT_ERROR("Unrecognized option %s!", argv[i]);
+			return EXIT_FAILURE;
+		}
+
+		files.push_back(argv[i]);
+	}
+
+	if (files.empty())
+	{
+		PRINT_ERROR("Input file not specified!");
+		std::cout << std::endl << gUsage << std::endl;
+		return EXIT_FAILURE;
+	}
+
+	std::vector<SFinding> findings;
+	SModel* model = nullptr;
+
+	for (const char* file : files)
+	{
+		std::string extension = std::filesystem::path(file).extension().string();
+
+		if (extension == ".bbmod")
+		{
+			model = SModel::Load(file);
+			if (!model)
+			{
+				PRINT_ERROR("Could not load model \"%s\"! Make sure it was saved in version %d.",
+					file, (int)BBMOD_VERSION);
+				return EXIT_FAILURE;
+			}
+			InspectModel(model, file, findings);
+		}
+		else if (extension == ".bbanim")
+		{
+			SAnimation* animation = SAnimation::Load(file);
+			if (!animation)
+			{
+				PRINT_ERROR("Could not load animation \"%s\"! Make sure it was saved in version %d.",
+					file, (int)BBMOD_VERSION);
+				return EXIT_FAILURE;
+			}
+			InspectAnimation(animation, model, file, findings);
+		}
+		else
+		{
+			PRINT_ERROR("Unsupported file \"%s\"!", file);
+			return EXIT_FAILURE;
+		}
+	}
+
+	PrintFindings(findings);
+
+	return EXIT_SUCCESS;
+}
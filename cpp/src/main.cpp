@@ -1,6 +1,7 @@
 #ifndef _WINDLL
 
 #include <BBMOD/Importer.hpp>
+#include <BBMOD/Profiler.hpp>
 #include <terminal.hpp>
 #include <iostream>
 #include <filesystem>
@@ -28,10 +29,31 @@ void PrintHelp()
 		<< "  output_file                          Where to save the converted model. If not specified, " << std::endl
 		<< "                                       then the input file path is used. Extensions .bbmod" << std::endl
 		<< "                                       and .bbanim are added automatically." << std::endl
+		<< "  -ao|--ao-rays=N                      Bake ambient occlusion into vertex colors using N rays per" << std::endl
+		<< "                                       vertex. Ignored for models with bones." << std::endl
+		<< "                                       Default is " << config.AORayCount << " (disabled)." << std::endl
+		<< "  -aod|--ao-distance=N                 Maximum distance of occluders when baking ambient occlusion." << std::endl
+		<< "                                       Default is " << config.AODistance << " (a tenth of the model size)." << std::endl
+		<< "  -bn|--bent-normals=true|false        Replace normals with bent normals when baking ambient occlusion." << std::endl
+		<< "                                       Default is " << PRINT_BOOL(config.BentNormals) << "." << std::endl
+		<< "  -bs|--batch-size=N                   Save N copies of each mesh with vertex ids, so the model can be" << std::endl
+		<< "                                       used in a dynamic batch. Ignored for models with bones." << std::endl
+		<< "                                       Maximum is " << BBMOD_MAX_BATCH_SIZE << ". Default is " << config.BatchSize << " (disabled)." << std::endl
+		<< "  -bvh|--build-bvh=true|false          Save a BVH of triangles of the model, which can be used for" << std::endl
+		<< "                                       raycasts and sphere queries through the DLL." << std::endl
+		<< "                                       Default is " << PRINT_BOOL(config.BuildBVH) << "." << std::endl
+		<< "  -cs|--cell-size=N                    Bake the model into cells of a uniform grid of size N and save" << std::endl
+		<< "                                       their bounds to a _cells.bbcell file. Each cell is a node" << std::endl
+		<< "                                       with one mesh per material. Ignored for models with bones." << std::endl
+		<< "                                       Default is " << config.CellSize << " (disabled)." << std::endl
 		<< "  -db|--disable-bone=true|false        Enable/disable saving bones and animations." << std::endl
 		<< "                                       Default is " << PRINT_BOOL(config.DisableBones) << "." << std::endl
 		<< "  -dc|--disable-color=true|false       Enable/disable saving vertex colors." << std::endl
 		<< "                                       Default is " << PRINT_BOOL(config.DisableVertexColors) << "." << std::endl
+		<< "  -di|--detect-instances=true|false    Store meshes identical up to rotation and translation only once" << std::endl
+		<< "                                       and save their transforms to a _instances.bbinst file." << std::endl
+		<< "                                       Disables --optimize-meshes. Ignored for models with bones." << std::endl
+		<< "                                       Default is " << PRINT_BOOL(config.DetectInstances) << "." << std::endl
 		<< "  -dn|--disable-normal=true|false      Enable/disable saving normal vectors. This also automatically" << std::endl
 		<< "                                       applies --disable-tangent." << std::endl
 		<< "                                       Default is " << PRINT_BOOL(config.DisableNormals) << "." << std::endl
@@ -50,16 +72,61 @@ void PrintHelp()
 		<< "                                         * 1 - Generate flat normal vectors." << std::endl
 		<< "                                         * 2 - Generate smooth normal vectors." << std::endl
 		<< "                                       Default is " << config.GenNormals << "." << std::endl
+		<< "  -hc|--hull-count=N                   Decompose each mesh into at most N convex hulls and save them" << std::endl
+		<< "                                       to a _hulls.bbhull file. If there are nodes named COL_*, only" << std::endl
+		<< "                                       their meshes are decomposed and removed from the model; use" << std::endl
+		<< "                                       with --optimize-nodes and --optimize-meshes disabled." << std::endl
+		<< "                                       Default is " << config.HullCount << " (disabled)." << std::endl
+		<< "  -hv|--hull-vertices=N                Maximum number of vertices of a convex hull." << std::endl
+		<< "                                       Default is " << config.HullVertexCount << "." << std::endl
 		<< "  -iw|--invert-winding=true|false      Invert winding order of vertices." << std::endl
 		<< "                                       Default is " << PRINT_BOOL(config.InvertWinding) << "." << std::endl
 		<< "  -lh|--left-handed=true|false         Convert to left-handed coordinate system." << std::endl
 		<< "                                       Default is " << PRINT_BOOL(config.LeftHanded) << "." << std::endl
+		<< "  -mr|--merge-rigid=true|false         Skin meshes attached to bones to a single bone and merge all" << std::endl
+		<< "                                       skinned meshes with the same material and vertex attributes." << std::endl
+		<< "                                       Default is " << PRINT_BOOL(config.MergeRigid) << "." << std::endl
+		<< "  -na|--normal-angle=N                 Maximum angle between normals of faces smoothed together" << std::endl
+		<< "                                       when generating smooth normals, in degrees." << std::endl
+		<< "                                       Default is " << config.NormalAngle << "." << std::endl
+		<< "  -np|--native-process=true|false      Generate normals and tangents and remove degenerate triangles" << std::endl
+		<< "                                       using multiple threads instead of Assimp. Identical vertices" << std::endl
+		<< "                                       are then joined only with --weld-distance." << std::endl
+		<< "                                       Default is " << PRINT_BOOL(config.NativePostProcess) << "." << std::endl
 		<< "  -on|--optimize-nodes=true|false      Join multiple nodes (without animations, bones, ...) into one." << std::endl
 		<< "                                       Default is " << PRINT_BOOL(config.OptimizeNodes) << "." << std::endl
 		<< "  -ome|--optimize-meshes=true|false    Join multiple meshes with the same material into one." << std::endl
 		<< "                                       Default is " << PRINT_BOOL(config.OptimizeMeshes) << "." << std::endl
 		<< "  -oma|--optimize-materials=true|false Join redundant materials into one and remove unused materials." << std::endl
 		<< "                                       Default is " << PRINT_BOOL(config.OptimizeMaterials) << "." << std::endl
+		<< "  -oo|--optimize-overdraw=true|false   Reorder triangles so that those facing outwards are drawn first." << std::endl
+		<< "                                       Default is " << PRINT_BOOL(config.OptimizeOverdraw) << "." << std::endl
+		<< "  -p|--profile=true|false              Print a table of times spent in individual conversion phases." << std::endl
+		<< "                                       Default is false." << std::endl
+		<< "  -pt|--profile-trace=true|false       Save times spent in individual conversion phases into a" << std::endl
+		<< "                                       _trace.json file, which can be opened in chrome://tracing." << std::endl
+		<< "                                       Default is false." << std::endl
+		<< "  -sg|--shadow-grid=N                  Simplify shadow proxies by clustering their vertices in a grid" << std::endl
+		<< "                                       with N cells along the longest side of a node." << std::endl
+		<< "                                       Default is " << config.ShadowGridSize << " (disabled)." << std::endl
+		<< "  -si|--split-influences=true|false    Split skinned meshes by the number of bones influencing their" << std::endl
+		<< "                                       vertices (1, 2 or 4), so cheaper shader variants can be used." << std::endl
+		<< "                                       Default is " << PRINT_BOOL(config.SplitInfluences) << "." << std::endl
+		<< "  -sp|--shadow-proxies=true|false      Save position-only meshes for depth-only passes, one per node," << std::endl
+		<< "                                       to a _shadow.bbshdw file. Ignored for models with bones." << std::endl
+		<< "                                       Default is " << PRINT_BOOL(config.ShadowProxies) << "." << std::endl
+		<< "  -ts|--triangle-strips=true|false     Save meshes as triangle strips where it reduces their vertex" << std::endl
+		<< "                                       count. Ignored with --batch-size." << std::endl
+		<< "                                       Default is " << PRINT_BOOL(config.TriangleStrips) << "." << std::endl
+		<< "  -wa|--weld-angle=N                   Maximum angle between normals of welded vertices in degrees." << std::endl
+		<< "                                       Default is " << config.WeldAngle << "." << std::endl
+		<< "  -wd|--weld-distance=N                Weld vertices closer than N which also have similar normals" << std::endl
+		<< "                                       and texture coordinates, so they can be shared." << std::endl
+		<< "                                       Default is " << config.WeldDistance << " (disabled)." << std::endl
+		<< "  -wt|--weight-threshold=N             Remove bone weights smaller than N and renormalize the rest." << std::endl
+		<< "                                       Default is " << config.WeightThreshold << " (disabled)." << std::endl
+		<< "  -wuv|--weld-uv=N                     Maximum distance between texture coordinates of welded" << std::endl
+		<< "                                       vertices. Default is " << config.WeldUVDistance << "." << std::endl
 		<< std::endl;
 }
 
@@ -73,9 +140,11 @@ int main(int argc, const char* argv[])
 	const char* fin = NULL;
 	const char* fout = NULL;
 	bool showHelp = false;
+	bool profile = false;
+	bool profileTrace = false;
 	SConfig config;
 
-	std::regex options_regex("(-[a-z]+|--[a-z\\-]+)=(true|false|[0-9])");
+	std::regex options_regex("(-[a-z]+|--[a-z\\-]+)=(true|false|[0-9]+(?:\\.[0-9]+)?)");
 	std::cmatch match;
 
 	for (int i = 1; i < argc; ++i)
@@ -92,6 +161,7 @@ int main(int argc, const char* argv[])
 				auto o = match[1];
 				bool b = (match[2] == "true");
 				size_t i = (size_t)strtol(match[2].str().c_str(), (char**)NULL, 10);
+				float f = strtof(match[2].str().c_str(), (char**)NULL);
 
 				if (o == "-lh" || o == "--left-handed")
 				{
@@ -138,6 +208,18 @@ int main(int argc, const char* argv[])
 				{
 					config.DisableBones = b;
 				}
+				else if (o == "-si" || o == "--split-influences")
+				{
+					config.SplitInfluences = b;
+				}
+				else if (o == "-wt" || o == "--weight-threshold")
+				{
+					config.WeightThreshold = f;
+				}
+				else if (o == "-mr" || o == "--merge-rigid")
+				{
+					config.MergeRigid = b;
+				}
 				else if (o == "-on" || o == "--optimize-nodes")
 				{
 					config.OptimizeNodes = b;
@@ -150,6 +232,86 @@ int main(int argc, const char* argv[])
 				{
 					config.OptimizeMaterials = b;
 				}
+				else if (o == "-oo" || o == "--optimize-overdraw")
+				{
+					config.OptimizeOverdraw = b;
+				}
+				else if (o == "-bs" || o == "--batch-size")
+				{
+					config.BatchSize = i;
+				}
+				else if (o == "-di" || o == "--detect-instances")
+				{
+					config.DetectInstances = b;
+				}
+				else if (o == "-bvh" || o == "--build-bvh")
+				{
+					config.BuildBVH = b;
+				}
+				else if (o == "-hc" || o == "--hull-count")
+				{
+					config.HullCount = i;
+				}
+				else if (o == "-hv" || o == "--hull-vertices")
+				{
+					config.HullVertexCount = i;
+				}
+				else if (o == "-ao" || o == "--ao-rays")
+				{
+					config.AORayCount = i;
+				}
+				else if (o == "-aod" || o == "--ao-distance")
+				{
+					config.AODistance = f;
+				}
+				else if (o == "-bn" || o == "--bent-normals")
+				{
+					config.BentNormals = b;
+				}
+				else if (o == "-sp" || o == "--shadow-proxies")
+				{
+					config.ShadowProxies = b;
+				}
+				else if (o == "-sg" || o == "--shadow-grid")
+				{
+					config.ShadowGridSize = i;
+				}
+				else if (o == "-ts" || o == "--triangle-strips")
+				{
+					config.TriangleStrips = b;
+				}
+				else if (o == "-wd" || o == "--weld-distance")
+				{
+					config.WeldDistance = f;
+				}
+				else if (o == "-wa" || o == "--weld-angle")
+				{
+					config.WeldAngle = f;
+				}
+				else if (o == "-wuv" || o == "--weld-uv")
+				{
+					config.WeldUVDistance = f;
+				}
+				else if (o == "-np" || o == "--native-process")
+				{
+					config.NativePostProcess = b;
+				}
+				else if (o == "-na" || o == "--normal-angle")
+				{
+					config.NormalAngle = f;
+				}
+				else if (o == "-cs" || o == "--cell-size")
+				{
+					config.CellSize = f;
+				}
+				else if (o == "-p" || o == "--profile")
+				{
+					profile = b;
+				}
+				else if (o == "-pt" || o == "--profile-trace")
+				{
+					profileTrace = b;
+				}
 				else
 				{
 					PRINT_ERROR("Unrecognized option %s!", argv[i]);
@@ -192,8 +354,31 @@ int main(int argc, const char* argv[])
 	std::string foutPath = std::filesystem::path(foutArg).replace_extension(".bbmod").string();
 	fout = foutPath.c_str();
 
+	SProfiler& profiler = SProfiler::Get();
+	profiler.SetEnabled(profile || profileTrace);
+
 	int retval = ConvertToBBMOD(fin, fout, config);
 
+	if (profile)
+	{
+		profiler.PrintSummary();
+	}
+
+	if (profileTrace)
+	{
+		std::filesystem::path tracePath(fout);
+		tracePath.replace_filename(tracePath.stem().string() + "_trace.json");
+
+		if (profiler.SaveTrace(tracePath.string()))
+		{
+			PRINT_SUCCESS("Profiler trace saved to \"%s\"!", tracePath.string().c_str());
+		}
+		else
+		{
+			PRINT_ERROR("Could not save profiler trace to \"%s\"!", tracePath.string().c_str());
+		}
+	}
+
 	if (retval != BBMOD_SUCCESS)
 	{
 		return EXIT_FAILURE;
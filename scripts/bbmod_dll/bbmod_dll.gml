@@ -1,5 +1,5 @@
 /// @macro {int} The supported version of BBMOD and BBANIM files.
-#macro BBMOD_VERSION 2
+#macro BBMOD_VERSION 7
 
 /// @macro {real} A code returned from the DLL on fail, when none of `BBMOD_ERR_`
 /// is applicable.
@@ -49,8 +49,21 @@
 /// @see BBMOD_DLL.get_gen_normal
 #macro BBMOD_NORMALS_SMOOTH 2
 
+/// @macro {real} Number of bytes of a ray passed to
+/// {@link BBMOD_DLL.model_raycast}.
+#macro BBMOD_DLL_RAY_SIZE 28
+
+/// @macro {real} Number of bytes of a sphere passed to
+/// {@link BBMOD_DLL.model_overlap_sphere}.
+#macro BBMOD_DLL_SPHERE_SIZE 16
+
+/// @macro {real} Number of bytes of a hit written by
+/// {@link BBMOD_DLL.model_raycast} and {@link BBMOD_DLL.model_overlap_sphere}.
+#macro BBMOD_DLL_HIT_SIZE 36
+
 /// @func BBMOD_DLL([_path])
-/// @desc Loads a DLL which allows you to convert models into BBMOD.
+/// @desc Loads a DLL which allows you to convert models into BBMOD and to
+/// animate them natively.
 /// @param {string} [_path] The path to the DLL file. Defaults to "BBMOD/DLL/BBMOD.dll".
 /// @throws {BBMOD_Error} If the DLL file does not exist.
 /// @example
@@ -124,12 +137,186 @@ function BBMOD_DLL(_path) constructor
 
 	dll_set_optimize_meshes = external_define(Path, "bbmod_dll_set_optimize_meshes", dll_cdecl, ty_real, 1, ty_real);
 
+	dll_get_batch_size = external_define(Path, "bbmod_dll_get_batch_size", dll_cdecl, ty_real, 0);
+
+	dll_set_batch_size = external_define(Path, "bbmod_dll_set_batch_size", dll_cdecl, ty_real, 1, ty_real);
+
+	dll_get_detect_instances = external_define(Path, "bbmod_dll_get_detect_instances", dll_cdecl, ty_real, 0);
+
+	dll_set_detect_instances = external_define(Path, "bbmod_dll_set_detect_instances", dll_cdecl, ty_real, 1, ty_real);
+
+	dll_get_cell_size = external_define(Path, "bbmod_dll_get_cell_size", dll_cdecl, ty_real, 0);
+
+	dll_set_cell_size = external_define(Path, "bbmod_dll_set_cell_size", dll_cdecl, ty_real, 1, ty_real);
+
+	dll_get_build_bvh = external_define(Path, "bbmod_dll_get_build_bvh", dll_cdecl, ty_real, 0);
+
+	dll_set_build_bvh = external_define(Path, "bbmod_dll_set_build_bvh", dll_cdecl, ty_real, 1, ty_real);
+
+	dll_get_hull_count = external_define(Path, "bbmod_dll_get_hull_count", dll_cdecl, ty_real, 0);
+
+	dll_set_hull_count = external_define(Path, "bbmod_dll_set_hull_count", dll_cdecl, ty_real, 1, ty_real);
+
+	dll_get_hull_vertex_count = external_define(Path, "bbmod_dll_get_hull_vertex_count", dll_cdecl, ty_real, 0);
+
+	dll_set_hull_vertex_count = external_define(Path, "bbmod_dll_set_hull_vertex_count", dll_cdecl, ty_real, 1, ty_real);
+
+	dll_get_ao_ray_count = external_define(Path, "bbmod_dll_get_ao_ray_count", dll_cdecl, ty_real, 0);
+
+	dll_set_ao_ray_count = external_define(Path, "bbmod_dll_set_ao_ray_count", dll_cdecl, ty_real, 1, ty_real);
+
+	dll_get_ao_distance = external_define(Path, "bbmod_dll_get_ao_distance", dll_cdecl, ty_real, 0);
+
+	dll_set_ao_distance = external_define(Path, "bbmod_dll_set_ao_distance", dll_cdecl, ty_real, 1, ty_real);
+
+	dll_get_bent_normals = external_define(Path, "bbmod_dll_get_bent_normals", dll_cdecl, ty_real, 0);
+
+	dll_set_bent_normals = external_define(Path, "bbmod_dll_set_bent_normals", dll_cdecl, ty_real, 1, ty_real);
+
+	dll_get_shadow_proxies = external_define(Path, "bbmod_dll_get_shadow_proxies", dll_cdecl, ty_real, 0);
+
+	dll_set_shadow_proxies = external_define(Path, "bbmod_dll_set_shadow_proxies", dll_cdecl, ty_real, 1, ty_real);
+
+	dll_get_shadow_grid_size = external_define(Path, "bbmod_dll_get_shadow_grid_size", dll_cdecl, ty_real, 0);
+
+	dll_set_shadow_grid_size = external_define(Path, "bbmod_dll_set_shadow_grid_size", dll_cdecl, ty_real, 1, ty_real);
+
+	dll_get_triangle_strips = external_define(Path, "bbmod_dll_get_triangle_strips", dll_cdecl, ty_real, 0);
+
+	dll_set_triangle_strips = external_define(Path, "bbmod_dll_set_triangle_strips", dll_cdecl, ty_real, 1, ty_real);
+
+	dll_get_optimize_overdraw = external_define(Path, "bbmod_dll_get_optimize_overdraw", dll_cdecl, ty_real, 0);
+
+	dll_set_optimize_overdraw = external_define(Path, "bbmod_dll_set_optimize_overdraw", dll_cdecl, ty_real, 1, ty_real);
+
+	dll_get_weld_distance = external_define(Path, "bbmod_dll_get_weld_distance", dll_cdecl, ty_real, 0);
+
+	dll_set_weld_distance = external_define(Path, "bbmod_dll_set_weld_distance", dll_cdecl, ty_real, 1, ty_real);
+
+	dll_get_weld_angle = external_define(Path, "bbmod_dll_get_weld_angle", dll_cdecl, ty_real, 0);
+
+	dll_set_weld_angle = external_define(Path, "bbmod_dll_set_weld_angle", dll_cdecl, ty_real, 1, ty_real);
+
+	dll_get_weld_uv_distance = external_define(Path, "bbmod_dll_get_weld_uv_distance", dll_cdecl, ty_real, 0);
+
+	dll_set_weld_uv_distance = external_define(Path, "bbmod_dll_set_weld_uv_distance", dll_cdecl, ty_real, 1, ty_real);
+
+	dll_get_native_post_process = external_define(Path, "bbmod_dll_get_native_post_process", dll_cdecl, ty_real, 0);
+
+	dll_set_native_post_process = external_define(Path, "bbmod_dll_set_native_post_process", dll_cdecl, ty_real, 1, ty_real);
+
+	dll_get_normal_angle = external_define(Path, "bbmod_dll_get_normal_angle", dll_cdecl, ty_real, 0);
+
+	dll_set_normal_angle = external_define(Path, "bbmod_dll_set_normal_angle", dll_cdecl, ty_real, 1, ty_real);
+
+	dll_get_split_influences = external_define(Path, "bbmod_dll_get_split_influences", dll_cdecl, ty_real, 0);
+
+	dll_set_split_influences = external_define(Path, "bbmod_dll_set_split_influences", dll_cdecl, ty_real, 1, ty_real);
+
+	dll_get_weight_threshold = external_define(Path, "bbmod_dll_get_weight_threshold", dll_cdecl, ty_real, 0);
+
+	dll_set_weight_threshold = external_define(Path, "bbmod_dll_set_weight_threshold", dll_cdecl, ty_real, 1, ty_real);
+
+	dll_get_merge_rigid = external_define(Path, "bbmod_dll_get_merge_rigid", dll_cdecl, ty_real, 0);
+
+	dll_set_merge_rigid = external_define(Path, "bbmod_dll_set_merge_rigid", dll_cdecl, ty_real, 1, ty_real);
+
 	dll_get_optimize_materials = external_define(Path, "bbmod_dll_get_optimize_materials", dll_cdecl, ty_real, 0);
 
 	dll_set_optimize_materials = external_define(Path, "bbmod_dll_set_optimize_materials", dll_cdecl, ty_real, 1, ty_real);
 
 	dll_convert = external_define(Path, "bbmod_dll_convert", dll_cdecl, ty_real, 2, ty_string, ty_string);
 
+	dll_model_load = external_define(Path, "bbmod_dll_model_load", dll_cdecl, ty_real, 1, ty_string);
+
+	dll_model_destroy = external_define(Path, "bbmod_dll_model_destroy", dll_cdecl, ty_real, 1, ty_real);
+
+	dll_model_get_skinned_size = external_define(Path, "bbmod_dll_model_get_skinned_size", dll_cdecl, ty_real, 2, ty_real, ty_real);
+
+	dll_model_skin_mesh = external_define(Path, "bbmod_dll_model_skin_mesh", dll_cdecl, ty_real, 4, ty_real, ty_real, ty_string, ty_string);
+
+	dll_model_get_static_batch_size = external_define(Path, "bbmod_dll_model_get_static_batch_size", dll_cdecl, ty_real, 2, ty_real, ty_real);
+
+	dll_model_to_static_batch = external_define(Path, "bbmod_dll_model_to_static_batch", dll_cdecl, ty_real, 4, ty_real, ty_string, ty_real, ty_string);
+
+	dll_model_has_bvh = external_define(Path, "bbmod_dll_model_has_bvh", dll_cdecl, ty_real, 1, ty_real);
+
+	dll_model_raycast = external_define(Path, "bbmod_dll_model_raycast", dll_cdecl, ty_real, 4, ty_real, ty_string, ty_real, ty_string);
+
+	dll_model_overlap_sphere = external_define(Path, "bbmod_dll_model_overlap_sphere", dll_cdecl, ty_real, 4, ty_real, ty_string, ty_real, ty_string);
+
+	dll_blob_load = external_define(Path, "bbmod_dll_blob_load", dll_cdecl, ty_real, 1, ty_string);
+
+	dll_blob_get_size = external_define(Path, "bbmod_dll_blob_get_size", dll_cdecl, ty_real, 1, ty_real);
+
+	dll_blob_write = external_define(Path, "bbmod_dll_blob_write", dll_cdecl, ty_real, 2, ty_real, ty_string);
+
+	dll_blob_destroy = external_define(Path, "bbmod_dll_blob_destroy", dll_cdecl, ty_real, 1, ty_real);
+
+	dll_animation_load = external_define(Path, "bbmod_dll_animation_load", dll_cdecl, ty_real, 1, ty_string);
+
+	dll_animation_get_duration = external_define(Path, "bbmod_dll_animation_get_duration", dll_cdecl, ty_real, 1, ty_real);
+
+	dll_animation_get_tics_per_second = external_define(Path, "bbmod_dll_animation_get_tics_per_second", dll_cdecl, ty_real, 1, ty_real);
+
+	dll_animation_destroy = external_define(Path, "bbmod_dll_animation_destroy", dll_cdecl, ty_real, 1, ty_real);
+
+	dll_pose_create = external_define(Path, "bbmod_dll_pose_create", dll_cdecl, ty_real, 1, ty_real);
+
+	dll_pose_sample = external_define(Path, "bbmod_dll_pose_sample", dll_cdecl, ty_real, 4, ty_real, ty_real, ty_real, ty_real);
+
+	dll_pose_transform = external_define(Path, "bbmod_dll_pose_transform", dll_cdecl, ty_real, 2, ty_real, ty_string);
+
+	dll_pose_get_node_transform = external_define(Path, "bbmod_dll_pose_get_node_transform", dll_cdecl, ty_real, 3, ty_real, ty_real, ty_string);
+
+	dll_pose_copy = external_define(Path, "bbmod_dll_pose_copy", dll_cdecl, ty_real, 2, ty_real, ty_real);
+
+	dll_pose_blend = external_define(Path, "bbmod_dll_pose_blend", dll_cdecl, ty_real, 4, ty_real, ty_real, ty_real, ty_real);
+
+	dll_pose_destroy = external_define(Path, "bbmod_dll_pose_destroy", dll_cdecl, ty_real, 1, ty_real);
+
+	dll_mask_create = external_define(Path, "bbmod_dll_mask_create", dll_cdecl, ty_real, 1, ty_real);
+
+	dll_mask_set_weight = external_define(Path, "bbmod_dll_mask_set_weight", dll_cdecl, ty_real, 4, ty_real, ty_real, ty_real, ty_real);
+
+	dll_mask_destroy = external_define(Path, "bbmod_dll_mask_destroy", dll_cdecl, ty_real, 1, ty_real);
+
+	dll_instance_create = external_define(Path, "bbmod_dll_instance_create", dll_cdecl, ty_real, 4, ty_real, ty_real, ty_real, ty_real);
+
+	dll_instance_set_buffer = external_define(Path, "bbmod_dll_instance_set_buffer", dll_cdecl, ty_real, 2, ty_real, ty_string);
+
+	dll_instance_play = external_define(Path, "bbmod_dll_instance_play", dll_cdecl, ty_real, 4, ty_real, ty_real, ty_real, ty_real);
+
+	dll_instance_set_speed = external_define(Path, "bbmod_dll_instance_set_speed", dll_cdecl, ty_real, 2, ty_real, ty_real);
+
+	dll_instance_destroy = external_define(Path, "bbmod_dll_instance_destroy", dll_cdecl, ty_real, 1, ty_real);
+
+	dll_get_thread_count = external_define(Path, "bbmod_dll_get_thread_count", dll_cdecl, ty_real, 0);
+
+	dll_set_thread_count = external_define(Path, "bbmod_dll_set_thread_count", dll_cdecl, ty_real, 1, ty_real);
+
+	dll_update_all = external_define(Path, "bbmod_dll_update_all", dll_cdecl, ty_real, 1, ty_real);
+
+	dll_wait = external_define(Path, "bbmod_dll_wait", dll_cdecl, ty_real, 0);
+
+	dll_stream_load = external_define(Path, "bbmod_dll_stream_load", dll_cdecl, ty_real, 3, ty_string, ty_real, ty_real);
+
+	dll_stream_remove = external_define(Path, "bbmod_dll_stream_remove", dll_cdecl, ty_real, 1, ty_real);
+
+	dll_stream_poll = external_define(Path, "bbmod_dll_stream_poll", dll_cdecl, ty_real, 0);
+
+	dll_stream_get_state = external_define(Path, "bbmod_dll_stream_get_state", dll_cdecl, ty_real, 1, ty_real);
+
+	dll_stream_get_size = external_define(Path, "bbmod_dll_stream_get_size", dll_cdecl, ty_real, 1, ty_real);
+
+	dll_stream_write = external_define(Path, "bbmod_dll_stream_write", dll_cdecl, ty_real, 2, ty_real, ty_string);
+
+	dll_stream_get_budget = external_define(Path, "bbmod_dll_stream_get_budget", dll_cdecl, ty_real, 0);
+
+	dll_stream_set_budget = external_define(Path, "bbmod_dll_stream_set_budget", dll_cdecl, ty_real, 1, ty_real);
+
+	dll_stream_get_staged_size = external_define(Path, "bbmod_dll_stream_get_staged_size", dll_cdecl, ty_real, 0);
+
 	/// @func convert(_fin, _fout)
 	/// @desc Converts a model into a BBMOD.
 	/// @param {string} _fin Path to the original model.
@@ -500,26 +687,89 @@ function BBMOD_DLL(_path) constructor
 		return self;
 	};
 
-	/// @func get_optimize_materials()
-	/// @desc Checks whether material optimization is enabled.
-	/// @return {bool} `true` if material optimization is enabled.
-	/// @see BBMOD_DLL.set_optimize_materials
-	static get_optimize_materials = function () {
+	/// @func get_batch_size()
+	/// @desc Retrieves the number of mesh copies saved for dynamic batching.
+	/// @return {real} The batch size or 0 if disabled.
+	/// @see BBMOD_DLL.set_batch_size
+	static get_batch_size = function () {
 		gml_pragma("forceinline");
-		return external_call(dll_get_optimize_materials);
+		return external_call(dll_get_batch_size);
 	};
 
-	/// @func set_optimize_materials(_optimize)
-	/// @desc Enables/disables material optimization. When enabled, redundant
-	/// materials are joined into one and unused materials are removed.
-	/// This is by default **enabled**.
-	/// @param {bool} _optimize `true` to enable material optimization.
+	/// @func set_batch_size(_size)
+	/// @desc Configures saving of models ready for dynamic batching. When
+	/// enabled, each mesh is saved `_size` times with vertex ids, so
+	/// {@link BBMOD_DynamicBatch} does not need to build the batch at runtime.
+	/// The size is limited to 64 instances by shader `BBMOD_ShDefaultBatched`.
+	/// Models with bones are not affected. This is by default **disabled**.
+	/// @param {real} _size Number of copies or 0 to disable.
+	/// @return {BBMOD_DLL} Returns `self` to allow method chaining.
+	/// @throws {BBMOD_Error} If the size is negative.
+	/// @see BBMOD_DLL.get_batch_size
+	static set_batch_size = function (_size) {
+		gml_pragma("forceinline");
+		var _retval = external_call(dll_set_batch_size, _size);
+		if (_retval != BBMOD_DLL_SUCCESS)
+		{
+			throw new BBMOD_Error();
+		}
+		return self;
+	};
+
+	/// @func get_detect_instances()
+	/// @desc Checks whether detection of instanced meshes is enabled.
+	/// @return {bool} `true` if detection of instanced meshes is enabled.
+	/// @see BBMOD_DLL.set_detect_instances
+	static get_detect_instances = function () {
+		gml_pragma("forceinline");
+		return external_call(dll_get_detect_instances);
+	};
+
+	/// @func set_detect_instances(_detect)
+	/// @desc Enables/disables detection of instanced meshes. When enabled,
+	/// meshes which are identical up to a rotation and a translation are saved
+	/// only once and their transforms are saved into a `_instances.bbinst`
+	/// file, which can be loaded with {@link BBMOD_Model.load_instances}. Mesh
+	/// optimization is not used when this is enabled. Models with bones are
+	/// not affected. This is by default **disabled**.
+	/// @param {bool} _detect `true` to enable detection of instanced meshes.
 	/// @return {BBMOD_DLL} Returns `self` to allow method chaining.
 	/// @throws {BBMOD_Error} If the operation fails.
-	/// @see BBMOD_DLL.get_optimize_materials
-	static set_optimize_materials = function (_optimize) {
+	/// @see BBMOD_DLL.get_detect_instances
+	static set_detect_instances = function (_detect) {
 		gml_pragma("forceinline");
-		var _retval = external_call(dll_set_optimize_materials, _optimize);
+		var _retval = external_call(dll_set_detect_instances, _detect);
+		if (_retval != BBMOD_DLL_SUCCESS)
+		{
+			throw new BBMOD_Error();
+		}
+		return self;
+	};
+
+	/// @func get_cell_size()
+	/// @desc Retrieves the size of cells into which models are baked.
+	/// @return {real} The cell size or 0 if disabled.
+	/// @see BBMOD_DLL.set_cell_size
+	static get_cell_size = function () {
+		gml_pragma("forceinline");
+		return external_call(dll_get_cell_size);
+	};
+
+	/// @func set_cell_size(_size)
+	/// @desc Configures baking of models into cells of a uniform grid. When
+	/// enabled, triangles are distributed into the cells, joined by material
+	/// within each cell and bounds of the cells are saved into a
+	/// `_cells.bbcell` file, which can be loaded with
+	/// {@link BBMOD_Model.load_cells}. This is ignored when detection of
+	/// instanced meshes is enabled. Models with bones are not affected. This
+	/// is by default **disabled**.
+	/// @param {real} _size The size of a cell or 0 to disable.
+	/// @return {BBMOD_DLL} Returns `self` to allow method chaining.
+	/// @throws {BBMOD_Error} If the size is negative.
+	/// @see BBMOD_DLL.get_cell_size
+	static set_cell_size = function (_size) {
+		gml_pragma("forceinline");
+		var _retval = external_call(dll_set_cell_size, _size);
 		if (_retval != BBMOD_DLL_SUCCESS)
 		{
 			throw new BBMOD_Error();
@@ -527,6 +777,1383 @@ function BBMOD_DLL(_path) constructor
 		return self;
 	};
 
+	/// @func get_build_bvh()
+	/// @desc Checks whether building of BVHs is enabled.
+	/// @return {bool} `true` if building of BVHs is enabled.
+	/// @see BBMOD_DLL.set_build_bvh
+	static get_build_bvh = function () {
+		gml_pragma("forceinline");
+		return external_call(dll_get_build_bvh);
+	};
+
+	/// @func set_build_bvh(_build)
+	/// @desc Enables/disables building of a BVH of triangles of converted
+	/// models. The BVH is saved into the model file and it is used by
+	/// {@link BBMOD_DLL.model_raycast} and {@link BBMOD_DLL.model_overlap_sphere}.
+	/// This is by default **disabled**.
+	/// @param {bool} _build `true` to enable building of BVHs.
+	/// @return {BBMOD_DLL} Returns `self` to allow method chaining.
+	/// @throws {BBMOD_Error} If the operation fails.
+	/// @see BBMOD_DLL.get_build_bvh
+	static set_build_bvh = function (_build) {
+		gml_pragma("forceinline");
+		var _retval = external_call(dll_set_build_bvh, _build);
+		if (_retval != BBMOD_DLL_SUCCESS)
+		{
+			throw new BBMOD_Error();
+		}
+		return self;
+	};
+
+	/// @func get_hull_count()
+	/// @desc Retrieves the maximum number of convex hulls into which each mesh
+	/// is decomposed.
+	/// @return {real} The maximum number of hulls or 0 if disabled.
+	/// @see BBMOD_DLL.set_hull_count
+	static get_hull_count = function () {
+		gml_pragma("forceinline");
+		return external_call(dll_get_hull_count);
+	};
+
+	/// @func set_hull_count(_count)
+	/// @desc Configures decomposition of meshes into convex hulls, which can
+	/// be used as cheap collision shapes. The hulls are saved into a
+	/// `_hulls.bbhull` file, which can be loaded with
+	/// {@link BBMOD_Model.load_hulls}. If the model has nodes with names
+	/// starting with "COL_", only their meshes are decomposed and they are
+	/// removed from the model. Such nodes are kept only when optimization of
+	/// nodes and meshes is disabled. This is by default **disabled**.
+	/// @param {real} _count The maximum number of hulls per mesh or 0 to
+	/// disable.
+	/// @return {BBMOD_DLL} Returns `self` to allow method chaining.
+	/// @throws {BBMOD_Error} If the count is negative.
+	/// @see BBMOD_DLL.get_hull_count
+	/// @see BBMOD_DLL.set_hull_vertex_count
+	static set_hull_count = function (_count) {
+		gml_pragma("forceinline");
+		var _retval = external_call(dll_set_hull_count, _count);
+		if (_retval != BBMOD_DLL_SUCCESS)
+		{
+			throw new BBMOD_Error();
+		}
+		return self;
+	};
+
+	/// @func get_hull_vertex_count()
+	/// @desc Retrieves the maximum number of vertices of a convex hull.
+	/// @return {real} The maximum number of vertices.
+	/// @see BBMOD_DLL.set_hull_vertex_count
+	static get_hull_vertex_count = function () {
+		gml_pragma("forceinline");
+		return external_call(dll_get_hull_vertex_count);
+	};
+
+	/// @func set_hull_vertex_count(_count)
+	/// @desc Changes the maximum number of vertices of a convex hull. Default
+	/// value is 32.
+	/// @param {real} _count The maximum number of vertices. Must be at least 4.
+	/// @return {BBMOD_DLL} Returns `self` to allow method chaining.
+	/// @throws {BBMOD_Error} If the count is less than 4.
+	/// @see BBMOD_DLL.get_hull_vertex_count
+	/// @see BBMOD_DLL.set_hull_count
+	static set_hull_vertex_count = function (_count) {
+		gml_pragma("forceinline");
+		var _retval = external_call(dll_set_hull_vertex_count, _count);
+		if (_retval != BBMOD_DLL_SUCCESS)
+		{
+			throw new BBMOD_Error();
+		}
+		return self;
+	};
+
+	/// @func get_ao_ray_count()
+	/// @desc Retrieves the number of rays per vertex used to bake ambient
+	/// occlusion.
+	/// @return {real} The number of rays or 0 if disabled.
+	/// @see BBMOD_DLL.set_ao_ray_count
+	static get_ao_ray_count = function () {
+		gml_pragma("forceinline");
+		return external_call(dll_get_ao_ray_count);
+	};
+
+	/// @func set_ao_ray_count(_count)
+	/// @desc Configures baking of ambient occlusion into vertex colors. When
+	/// enabled, rays are cast from each vertex and its color is multiplied by
+	/// the fraction of rays which did not hit anything. Models without vertex
+	/// colors get them enabled. A shader which reads vertex colors is needed
+	/// to display the occlusion. Models with bones are not affected. This is
+	/// by default **disabled**.
+	/// @param {real} _count The number of rays per vertex or 0 to disable.
+	/// @return {BBMOD_DLL} Returns `self` to allow method chaining.
+	/// @throws {BBMOD_Error} If the count is negative.
+	/// @see BBMOD_DLL.get_ao_ray_count
+	/// @see BBMOD_DLL.set_ao_distance
+	/// @see BBMOD_DLL.set_bent_normals
+	static set_ao_ray_count = function (_count) {
+		gml_pragma("forceinline");
+		var _retval = external_call(dll_set_ao_ray_count, _count);
+		if (_retval != BBMOD_DLL_SUCCESS)
+		{
+			throw new BBMOD_Error();
+		}
+		return self;
+	};
+
+	/// @func get_ao_distance()
+	/// @desc Retrieves the maximum distance of occluders when baking ambient
+	/// occlusion.
+	/// @return {real} The maximum distance or 0 if a tenth of the size of the
+	/// model is used.
+	/// @see BBMOD_DLL.set_ao_distance
+	static get_ao_distance = function () {
+		gml_pragma("forceinline");
+		return external_call(dll_get_ao_distance);
+	};
+
+	/// @func set_ao_distance(_distance)
+	/// @desc Changes the maximum distance of occluders when baking ambient
+	/// occlusion. Default value is 0, which uses a tenth of the size of the
+	/// model.
+	/// @param {real} _distance The maximum distance.
+	/// @return {BBMOD_DLL} Returns `self` to allow method chaining.
+	/// @throws {BBMOD_Error} If the distance is negative.
+	/// @see BBMOD_DLL.get_ao_distance
+	static set_ao_distance = function (_distance) {
+		gml_pragma("forceinline");
+		var _retval = external_call(dll_set_ao_distance, _distance);
+		if (_retval != BBMOD_DLL_SUCCESS)
+		{
+			throw new BBMOD_Error();
+		}
+		return self;
+	};
+
+	/// @func get_bent_normals()
+	/// @desc Checks whether normals are replaced with bent normals when
+	/// baking ambient occlusion.
+	/// @return {bool} `true` if bent normals are enabled.
+	/// @see BBMOD_DLL.set_bent_normals
+	static get_bent_normals = function () {
+		gml_pragma("forceinline");
+		return external_call(dll_get_bent_normals);
+	};
+
+	/// @func set_bent_normals(_bent)
+	/// @desc Enables/disables replacing of vertex normals with bent normals,
+	/// the average directions in which vertices are not occluded, when baking
+	/// ambient occlusion. This is by default **disabled**.
+	/// @param {bool} _bent `true` to enable bent normals.
+	/// @return {BBMOD_DLL} Returns `self` to allow method chaining.
+	/// @throws {BBMOD_Error} If the operation fails.
+	/// @see BBMOD_DLL.get_bent_normals
+	static set_bent_normals = function (_bent) {
+		gml_pragma("forceinline");
+		var _retval = external_call(dll_set_bent_normals, _bent);
+		if (_retval != BBMOD_DLL_SUCCESS)
+		{
+			throw new BBMOD_Error();
+		}
+		return self;
+	};
+
+	/// @func get_shadow_proxies()
+	/// @desc Checks whether shadow proxies are saved.
+	/// @return {bool} `true` if shadow proxies are saved.
+	/// @see BBMOD_DLL.set_shadow_proxies
+	static get_shadow_proxies = function () {
+		gml_pragma("forceinline");
+		return external_call(dll_get_shadow_proxies);
+	};
+
+	/// @func set_shadow_proxies(_enable)
+	/// @desc Enables/disables saving of shadow proxies, meshes with only
+	/// vertex positions, one for each node, which are cheaper to render in
+	/// depth-only passes like shadow maps. They are saved into a
+	/// `_shadow.bbshdw` file, which can be loaded with
+	/// {@link BBMOD_Model.load_shadow_proxies}. Models with bones are not
+	/// affected. This is by default **disabled**.
+	/// @param {bool} _enable `true` to enable shadow proxies.
+	/// @return {BBMOD_DLL} Returns `self` to allow method chaining.
+	/// @throws {BBMOD_Error} If the operation fails.
+	/// @see BBMOD_DLL.get_shadow_proxies
+	/// @see BBMOD_DLL.set_shadow_grid_size
+	static set_shadow_proxies = function (_enable) {
+		gml_pragma("forceinline");
+		var _retval = external_call(dll_set_shadow_proxies, _enable);
+		if (_retval != BBMOD_DLL_SUCCESS)
+		{
+			throw new BBMOD_Error();
+		}
+		return self;
+	};
+
+	/// @func get_shadow_grid_size()
+	/// @desc Retrieves the size of a grid used to simplify shadow proxies.
+	/// @return {real} The number of cells along the longest side of a node or
+	/// 0 if disabled.
+	/// @see BBMOD_DLL.set_shadow_grid_size
+	static get_shadow_grid_size = function () {
+		gml_pragma("forceinline");
+		return external_call(dll_get_shadow_grid_size);
+	};
+
+	/// @func set_shadow_grid_size(_size)
+	/// @desc Configures simplification of shadow proxies. When enabled, all
+	/// vertices in a cell of a grid are merged into one and triangles smaller
+	/// than a cell are removed. This is by default **disabled**.
+	/// @param {real} _size The number of cells along the longest side of a
+	/// node or 0 to disable.
+	/// @return {BBMOD_DLL} Returns `self` to allow method chaining.
+	/// @throws {BBMOD_Error} If the size is negative.
+	/// @see BBMOD_DLL.get_shadow_grid_size
+	static set_shadow_grid_size = function (_size) {
+		gml_pragma("forceinline");
+		var _retval = external_call(dll_set_shadow_grid_size, _size);
+		if (_retval != BBMOD_DLL_SUCCESS)
+		{
+			throw new BBMOD_Error();
+		}
+		return self;
+	};
+
+	/// @func get_triangle_strips()
+	/// @desc Checks whether meshes are saved as triangle strips.
+	/// @return {bool} `true` if meshes are saved as triangle strips.
+	/// @see BBMOD_DLL.set_triangle_strips
+	static get_triangle_strips = function () {
+		gml_pragma("forceinline");
+		return external_call(dll_get_triangle_strips);
+	};
+
+	/// @func set_triangle_strips(_enable)
+	/// @desc Enables/disables saving meshes as triangle strips. Neighbouring
+	/// triangles of a strip share two vertices, so the meshes have fewer
+	/// vertices to store and transform. Meshes are kept as triangle lists if
+	/// strips would not make them smaller. Batched models are not affected.
+	/// This is by default **disabled**.
+	/// @param {bool} _enable `true` to enable triangle strips.
+	/// @return {BBMOD_DLL} Returns `self` to allow method chaining.
+	/// @throws {BBMOD_Error} If the operation fails.
+	/// @see BBMOD_DLL.get_triangle_strips
+	static set_triangle_strips = function (_enable) {
+		gml_pragma("forceinline");
+		var _retval = external_call(dll_set_triangle_strips, _enable);
+		if (_retval != BBMOD_DLL_SUCCESS)
+		{
+			throw new BBMOD_Error();
+		}
+		return self;
+	};
+
+	/// @func get_optimize_overdraw()
+	/// @desc Checks whether overdraw optimization is enabled.
+	/// @return {bool} `true` if overdraw optimization is enabled.
+	/// @see BBMOD_DLL.set_optimize_overdraw
+	static get_optimize_overdraw = function () {
+		gml_pragma("forceinline");
+		return external_call(dll_get_optimize_overdraw);
+	};
+
+	/// @func set_optimize_overdraw(_optimize)
+	/// @desc Enables/disables overdraw optimization. When enabled, triangles
+	/// of each mesh are reordered so that those facing away from its center
+	/// are drawn first and hide the rest from the depth test. This helps
+	/// mostly fill-rate bound platforms. This is by default **disabled**.
+	/// @param {bool} _optimize `true` to enable overdraw optimization.
+	/// @return {BBMOD_DLL} Returns `self` to allow method chaining.
+	/// @throws {BBMOD_Error} If the operation fails.
+	/// @see BBMOD_DLL.get_optimize_overdraw
+	static set_optimize_overdraw = function (_optimize) {
+		gml_pragma("forceinline");
+		var _retval = external_call(dll_set_optimize_overdraw, _optimize);
+		if (_retval != BBMOD_DLL_SUCCESS)
+		{
+			throw new BBMOD_Error();
+		}
+		return self;
+	};
+
+	/// @func get_weld_distance()
+	/// @desc Retrieves the maximum distance between welded vertices.
+	/// @return {real} The maximum distance or 0 if welding is disabled.
+	/// @see BBMOD_DLL.set_weld_distance
+	static get_weld_distance = function () {
+		gml_pragma("forceinline");
+		return external_call(dll_get_weld_distance);
+	};
+
+	/// @func set_weld_distance(_distance)
+	/// @desc Configures welding of vertices. Vertices of a mesh closer than
+	/// the distance are snapped together and if their normals and texture
+	/// coordinates are also similar, they become one vertex. This removes
+	/// float noise of scanned and CAD models, so their vertices can be shared
+	/// by triangle strips. This is by default **disabled**.
+	/// @param {real} _distance The maximum distance or 0 to disable welding.
+	/// @return {BBMOD_DLL} Returns `self` to allow method chaining.
+	/// @throws {BBMOD_Error} If the distance is negative.
+	/// @see BBMOD_DLL.get_weld_distance
+	/// @see BBMOD_DLL.set_weld_angle
+	/// @see BBMOD_DLL.set_weld_uv_distance
+	static set_weld_distance = function (_distance) {
+		gml_pragma("forceinline");
+		var _retval = external_call(dll_set_weld_distance, _distance);
+		if (_retval != BBMOD_DLL_SUCCESS)
+		{
+			throw new BBMOD_Error();
+		}
+		return self;
+	};
+
+	/// @func get_weld_angle()
+	/// @desc Retrieves the maximum angle between normals of welded vertices.
+	/// @return {real} The maximum angle in degrees.
+	/// @see BBMOD_DLL.set_weld_angle
+	static get_weld_angle = function () {
+		gml_pragma("forceinline");
+		return external_call(dll_get_weld_angle);
+	};
+
+	/// @func set_weld_angle(_angle)
+	/// @desc Changes the maximum angle between normals and tangents of welded
+	/// vertices, which keeps hard edges. Default value is 1.
+	/// @param {real} _angle The maximum angle in degrees.
+	/// @return {BBMOD_DLL} Returns `self` to allow method chaining.
+	/// @throws {BBMOD_Error} If the angle is negative.
+	/// @see BBMOD_DLL.get_weld_angle
+	static set_weld_angle = function (_angle) {
+		gml_pragma("forceinline");
+		var _retval = external_call(dll_set_weld_angle, _angle);
+		if (_retval != BBMOD_DLL_SUCCESS)
+		{
+			throw new BBMOD_Error();
+		}
+		return self;
+	};
+
+	/// @func get_weld_uv_distance()
+	/// @desc Retrieves the maximum distance between texture coordinates of
+	/// welded vertices.
+	/// @return {real} The maximum distance.
+	/// @see BBMOD_DLL.set_weld_uv_distance
+	static get_weld_uv_distance = function () {
+		gml_pragma("forceinline");
+		return external_call(dll_get_weld_uv_distance);
+	};
+
+	/// @func set_weld_uv_distance(_distance)
+	/// @desc Changes the maximum distance between texture coordinates of
+	/// welded vertices, which keeps UV seams. Default value is 0.0001.
+	/// @param {real} _distance The maximum distance.
+	/// @return {BBMOD_DLL} Returns `self` to allow method chaining.
+	/// @throws {BBMOD_Error} If the distance is negative.
+	/// @see BBMOD_DLL.get_weld_uv_distance
+	static set_weld_uv_distance = function (_distance) {
+		gml_pragma("forceinline");
+		var _retval = external_call(dll_set_weld_uv_distance, _distance);
+		if (_retval != BBMOD_DLL_SUCCESS)
+		{
+			throw new BBMOD_Error();
+		}
+		return self;
+	};
+
+	/// @func get_native_post_process()
+	/// @desc Checks whether normals, tangents and degenerate triangles are
+	/// processed by the DLL itself instead of Assimp.
+	/// @return {bool} `true` if native post-processing is enabled.
+	/// @see BBMOD_DLL.set_native_post_process
+	static get_native_post_process = function () {
+		gml_pragma("forceinline");
+		return external_call(dll_get_native_post_process);
+	};
+
+	/// @func set_native_post_process(_native)
+	/// @desc Enables/disables generating normals and tangents and removing
+	/// degenerate triangles using multiple threads instead of Assimp's
+	/// post-processing steps. Identical vertices are then joined only when
+	/// welding is enabled. This is by default **disabled**.
+	/// @param {bool} _native `true` to enable native post-processing.
+	/// @return {BBMOD_DLL} Returns `self` to allow method chaining.
+	/// @throws {BBMOD_Error} If the operation fails.
+	/// @see BBMOD_DLL.get_native_post_process
+	/// @see BBMOD_DLL.set_weld_distance
+	static set_native_post_process = function (_native) {
+		gml_pragma("forceinline");
+		var _retval = external_call(dll_set_native_post_process, _native);
+		if (_retval != BBMOD_DLL_SUCCESS)
+		{
+			throw new BBMOD_Error();
+		}
+		return self;
+	};
+
+	/// @func get_normal_angle()
+	/// @desc Retrieves the maximum angle between normals of faces smoothed
+	/// together when generating smooth normals.
+	/// @return {real} The maximum angle in degrees.
+	/// @see BBMOD_DLL.set_normal_angle
+	static get_normal_angle = function () {
+		gml_pragma("forceinline");
+		return external_call(dll_get_normal_angle);
+	};
+
+	/// @func set_normal_angle(_angle)
+	/// @desc Changes the maximum angle between normals of faces smoothed
+	/// together when generating smooth normals. Default value is 175.
+	/// @param {real} _angle The maximum angle in degrees.
+	/// @return {BBMOD_DLL} Returns `self` to allow method chaining.
+	/// @throws {BBMOD_Error} If the angle is negative.
+	/// @see BBMOD_DLL.get_normal_angle
+	/// @see BBMOD_DLL.set_gen_normal
+	static set_normal_angle = function (_angle) {
+		gml_pragma("forceinline");
+		var _retval = external_call(dll_set_normal_angle, _angle);
+		if (_retval != BBMOD_DLL_SUCCESS)
+		{
+			throw new BBMOD_Error();
+		}
+		return self;
+	};
+
+	/// @func get_split_influences()
+	/// @desc Checks whether skinned meshes are split by the number of bones
+	/// influencing their vertices.
+	/// @return {bool} `true` if splitting by bone influences is enabled.
+	/// @see BBMOD_DLL.set_split_influences
+	static get_split_influences = function () {
+		gml_pragma("forceinline");
+		return external_call(dll_get_split_influences);
+	};
+
+	/// @func set_split_influences(_split)
+	/// @desc Enables/disables splitting skinned meshes into meshes whose
+	/// vertices are influenced by 1, 2 or 4 bones, which take less memory and
+	/// are rendered with cheaper shader variants. This is by default
+	/// **disabled**.
+	/// @param {bool} _split `true` to enable splitting by bone influences.
+	/// @return {BBMOD_DLL} Returns `self` to allow method chaining.
+	/// @throws {BBMOD_Error} If the operation fails.
+	/// @see BBMOD_DLL.get_split_influences
+	/// @see bbmod_shader_set_skinning_variant
+	static set_split_influences = function (_split) {
+		gml_pragma("forceinline");
+		var _retval = external_call(dll_set_split_influences, _split);
+		if (_retval != BBMOD_DLL_SUCCESS)
+		{
+			throw new BBMOD_Error();
+		}
+		return self;
+	};
+
+	/// @func get_weight_threshold()
+	/// @desc Retrieves the smallest bone weight which is kept.
+	/// @return {real} The smallest kept bone weight.
+	/// @see BBMOD_DLL.set_weight_threshold
+	static get_weight_threshold = function () {
+		gml_pragma("forceinline");
+		return external_call(dll_get_weight_threshold);
+	};
+
+	/// @func set_weight_threshold(_threshold)
+	/// @desc Changes the smallest bone weight which is kept. Smaller weights
+	/// are removed and the remaining weights of the vertex renormalized, so
+	/// more vertices fit into meshes with fewer bone influences. Default value
+	/// is 0, which keeps all weights.
+	/// @param {real} _threshold The smallest kept bone weight.
+	/// @return {BBMOD_DLL} Returns `self` to allow method chaining.
+	/// @throws {BBMOD_Error} If the threshold is negative.
+	/// @see BBMOD_DLL.get_weight_threshold
+	/// @see BBMOD_DLL.set_split_influences
+	static set_weight_threshold = function (_threshold) {
+		gml_pragma("forceinline");
+		var _retval = external_call(dll_set_weight_threshold, _threshold);
+		if (_retval != BBMOD_DLL_SUCCESS)
+		{
+			throw new BBMOD_Error();
+		}
+		return self;
+	};
+
+	/// @func get_merge_rigid()
+	/// @desc Checks whether meshes attached to bones are skinned and merged
+	/// with the rest of the model.
+	/// @return {bool} `true` if merging rigidly attached meshes is enabled.
+	/// @see BBMOD_DLL.set_merge_rigid
+	static get_merge_rigid = function () {
+		gml_pragma("forceinline");
+		return external_call(dll_get_merge_rigid);
+	};
+
+	/// @func set_merge_rigid(_merge)
+	/// @desc Enables/disables skinning meshes attached to bones, e.g. armor or
+	/// weapons, to a single bone and merging all skinned meshes which use the
+	/// same material and have the same vertex attributes into one, so that the
+	/// whole model is rendered with as few draw calls as possible. This is by default **disabled**.
+	/// @param {bool} _merge `true` to enable merging rigidly attached meshes.
+	/// @return {BBMOD_DLL} Returns `self` to allow method chaining.
+	/// @throws {BBMOD_Error} If the operation fails.
+	/// @see BBMOD_DLL.get_merge_rigid
+	static set_merge_rigid = function (_merge) {
+		gml_pragma("forceinline");
+		var _retval = external_call(dll_set_merge_rigid, _merge);
+		if (_retval != BBMOD_DLL_SUCCESS)
+		{
+			throw new BBMOD_Error();
+		}
+		return self;
+	};
+
+	/// @func get_optimize_materials()
+	/// @desc Checks whether material optimization is enabled.
+	/// @return {bool} `true` if material optimization is enabled.
+	/// @see BBMOD_DLL.set_optimize_materials
+	static get_optimize_materials = function () {
+		gml_pragma("forceinline");
+		return external_call(dll_get_optimize_materials);
+	};
+
+	/// @func set_optimize_materials(_optimize)
+	/// @desc Enables/disables material optimization. When enabled, redundant
+	/// materials are joined into one and unused materials are removed.
+	/// This is by default **enabled**.
+	/// @param {bool} _optimize `true` to enable material optimization.
+	/// @return {BBMOD_DLL} Returns `self` to allow method chaining.
+	/// @throws {BBMOD_Error} If the operation fails.
+	/// @see BBMOD_DLL.get_optimize_materials
+	static set_optimize_materials = function (_optimize) {
+		gml_pragma("forceinline");
+		var _retval = external_call(dll_set_optimize_materials, _optimize);
+		if (_retval != BBMOD_DLL_SUCCESS)
+		{
+			throw new BBMOD_Error();
+		}
+		return self;
+	};
+
+	/// @func model_load(_file)
+	/// @desc Loads a model into the DLL, so it can be animated natively.
+	/// @param {string} _file Path to a "*.bbmod" file.
+	/// @return {real} A handle of the loaded model.
+	/// @throws {BBMOD_Error} If the model fails to load.
+	/// @see BBMOD_DLL.model_destroy
+	/// @see BBMOD_NativeAnimationPlayer
+	static model_load = function (_file) {
+		gml_pragma("forceinline");
+		var _model = external_call(dll_model_load, _file);
+		if (_model == BBMOD_DLL_FAILURE)
+		{
+			throw new BBMOD_Error("Could not load model " + _file + "!");
+		}
+		return _model;
+	};
+
+	/// @func model_destroy(_model)
+	/// @desc Frees memory used by a model loaded into the DLL. Poses, masks and
+	/// animation instances created for the model must be destroyed first.
+	/// @param {real} _model A handle of the model.
+	/// @return {BBMOD_DLL} Returns `self` to allow method chaining.
+	/// @throws {BBMOD_Error} If the handle is not valid or the model is still
+	/// used by a pose, a mask or an animation instance.
+	/// @see BBMOD_DLL.model_load
+	static model_destroy = function (_model) {
+		gml_pragma("forceinline");
+		var _retval = external_call(dll_model_destroy, _model);
+		if (_retval != BBMOD_DLL_SUCCESS)
+		{
+			throw new BBMOD_Error();
+		}
+		return self;
+	};
+
+	/// @func model_get_skinned_size(_model, _mesh_index)
+	/// @desc Retrieves size of a buffer required by
+	/// {@link BBMOD_DLL.model_skin_mesh}.
+	/// @param {real} _model A handle of the model.
+	/// @param {real} _mesh_index An index of a mesh of the model.
+	/// @return {real} The size of the buffer in bytes.
+	/// @throws {BBMOD_Error} If the handle or the mesh index is not valid.
+	static model_get_skinned_size = function (_model, _mesh_index) {
+		gml_pragma("forceinline");
+		var _size = external_call(dll_model_get_skinned_size, _model, _mesh_index);
+		if (_size == BBMOD_DLL_FAILURE)
+		{
+			throw new BBMOD_Error();
+		}
+		return _size;
+	};
+
+	/// @func model_skin_mesh(_model, _mesh_index, _transform, _buffer)
+	/// @desc Transforms vertices of a mesh by bone transforms on the CPU and
+	/// writes them into a buffer in the mesh's vertex format without bones.
+	/// The result can be rendered with the static shader, so the number of
+	/// bones is not limited by the animated shader. Vertices keep their order,
+	/// so meshes saved as triangle strips must be submitted as
+	/// `pr_trianglestrip`.
+	/// @param {real} _model A handle of the model.
+	/// @param {real} _mesh_index An index of a mesh of the model.
+	/// @param {buffer} _transform A buffer with bone transforms, e.g. from
+	/// {@link BBMOD_DLL.pose_transform}.
+	/// @param {buffer} _buffer A buffer of at least
+	/// {@link BBMOD_DLL.model_get_skinned_size} bytes.
+	/// @return {BBMOD_DLL} Returns `self` to allow method chaining.
+	/// @throws {BBMOD_Error} If the handle or the mesh index is not valid.
+	/// @example
+	/// ```gml
+	/// var _size = dll.model_get_skinned_size(native_character, 0);
+	/// var _buffer = buffer_create(_size, buffer_fixed, 1);
+	/// dll.model_skin_mesh(native_character, 0, animation_player.get_transform(), _buffer);
+	/// var _mesh_format = mod_character.Meshes[0][BBMOD_EMesh.VertexFormat];
+	/// var _format = new BBMOD_VertexFormat(_mesh_format.Vertices, _mesh_format.Normals,
+	///     _mesh_format.TextureCoords, _mesh_format.Colors, _mesh_format.TangentW, false, false);
+	/// vbuffer = vertex_create_buffer_from_buffer(_buffer, _format.Raw);
+	/// buffer_delete(_buffer);
+	/// ```
+	static model_skin_mesh = function (_model, _mesh_index, _transform, _buffer) {
+		gml_pragma("forceinline");
+		var _retval = external_call(dll_model_skin_mesh, _model, _mesh_index,
+			buffer_get_address(_transform), buffer_get_address(_buffer));
+		if (_retval != BBMOD_DLL_SUCCESS)
+		{
+			throw new BBMOD_Error();
+		}
+		return self;
+	};
+
+	/// @func model_get_static_batch_size(_model, _count)
+	/// @desc Retrieves the size of a buffer required by
+	/// {@link BBMOD_DLL.model_to_static_batch}.
+	/// @param {real} _model A handle of the model.
+	/// @param {real} _count Number of instances of the model.
+	/// @return {real} The size of the buffer in bytes.
+	/// @throws {BBMOD_Error} If the handle is not valid.
+	static model_get_static_batch_size = function (_model, _count) {
+		gml_pragma("forceinline");
+		var _size = external_call(dll_model_get_static_batch_size, _model, _count);
+		if (_size == BBMOD_DLL_FAILURE)
+		{
+			throw new BBMOD_Error();
+		}
+		return _size;
+	};
+
+	/// @func model_to_static_batch(_model, _transforms, _count, _buffer)
+	/// @desc Transforms all meshes of a model by transforms of its instances
+	/// on multiple threads and writes them into a buffer one after another
+	/// in the model's vertex format without bones and ids.
+	/// @param {real} _model A handle of the model.
+	/// @param {buffer} _transforms A buffer with a matrix for each instance,
+	/// stored as 16 `buffer_f32` values.
+	/// @param {real} _count Number of instances.
+	/// @param {buffer} _buffer A buffer of at least
+	/// {@link BBMOD_DLL.model_get_static_batch_size} bytes.
+	/// @return {BBMOD_DLL} Returns `self` to allow method chaining.
+	/// @throws {BBMOD_Error} If the handle is not valid.
+	/// @see BBMOD_StaticBatch.from_dll
+	static model_to_static_batch = function (_model, _transforms, _count, _buffer) {
+		gml_pragma("forceinline");
+		var _retval = external_call(dll_model_to_static_batch, _model,
+			buffer_get_address(_transforms), _count, buffer_get_address(_buffer));
+		if (_retval != BBMOD_DLL_SUCCESS)
+		{
+			throw new BBMOD_Error();
+		}
+		return self;
+	};
+
+	/// @func model_has_bvh(_model)
+	/// @desc Checks whether a model was converted with a BVH, which is
+	/// required by {@link BBMOD_DLL.model_raycast} and
+	/// {@link BBMOD_DLL.model_overlap_sphere}.
+	/// @param {real} _model A handle of the model.
+	/// @return {bool} `true` if the model has a BVH.
+	/// @throws {BBMOD_Error} If the handle is not valid.
+	/// @see BBMOD_DLL.set_build_bvh
+	static model_has_bvh = function (_model) {
+		gml_pragma("forceinline");
+		var _retval = external_call(dll_model_has_bvh, _model);
+		if (_retval == BBMOD_DLL_FAILURE)
+		{
+			throw new BBMOD_Error();
+		}
+		return _retval;
+	};
+
+	/// @func model_raycast(_model, _rays, _count, _hits)
+	/// @desc Casts rays against triangles of a model on multiple threads. The
+	/// model must have a BVH. Triangles are hit from both sides.
+	/// @param {real} _model A handle of the model.
+	/// @param {buffer} _rays A buffer with {@link BBMOD_DLL_RAY_SIZE} bytes
+	/// for each ray: its origin, direction and maximum distance as 7
+	/// `buffer_f32` values. The direction does not need to be normalized. For
+	/// a segment, use the vector from its start to its end as the direction
+	/// and its length as the maximum distance.
+	/// @param {real} _count Number of rays.
+	/// @param {buffer} _hits A buffer of at least `_count *`
+	/// {@link BBMOD_DLL_HIT_SIZE} bytes. For each ray, it receives 9
+	/// `buffer_f32` values: distance to the closest hit (or -1 if nothing was
+	/// hit), the hit point, the normal of the hit triangle facing the ray, the
+	/// index of the mesh and the index of the triangle in the mesh.
+	/// @return {real} Number of rays which hit a triangle.
+	/// @throws {BBMOD_Error} If the handle is not valid or the model does not
+	/// have a BVH.
+	/// @example
+	/// ```gml
+	/// buffer_seek(rays, buffer_seek_start, 0);
+	/// buffer_write(rays, buffer_f32, x);
+	/// buffer_write(rays, buffer_f32, y);
+	/// buffer_write(rays, buffer_f32, z + 10);
+	/// buffer_write(rays, buffer_f32, 0);
+	/// buffer_write(rays, buffer_f32, 0);
+	/// buffer_write(rays, buffer_f32, -1);
+	/// buffer_write(rays, buffer_f32, 1000);
+	/// if (dll.model_raycast(native_level, rays, 1, hits) > 0)
+	/// {
+	///     z = buffer_peek(hits, 12, buffer_f32);
+	/// }
+	/// ```
+	/// @see BBMOD_DLL.model_overlap_sphere
+	static model_raycast = function (_model, _rays, _count, _hits) {
+		gml_pragma("forceinline");
+		var _retval = external_call(dll_model_raycast, _model,
+			buffer_get_address(_rays), _count, buffer_get_address(_hits));
+		if (_retval == BBMOD_DLL_FAILURE)
+		{
+			throw new BBMOD_Error();
+		}
+		return _retval;
+	};
+
+	/// @func model_overlap_sphere(_model, _spheres, _count, _hits)
+	/// @desc Finds the closest triangle of a model which intersects a sphere,
+	/// for multiple spheres on multiple threads. The model must have a BVH.
+	/// @param {real} _model A handle of the model.
+	/// @param {buffer} _spheres A buffer with {@link BBMOD_DLL_SPHERE_SIZE}
+	/// bytes for each sphere: its center and radius as 4 `buffer_f32` values.
+	/// @param {real} _count Number of spheres.
+	/// @param {buffer} _hits A buffer of at least `_count *`
+	/// {@link BBMOD_DLL_HIT_SIZE} bytes. For each sphere, it receives the same
+	/// values as in {@link BBMOD_DLL.model_raycast}, except that the distance
+	/// is from the center of the sphere to the closest point on the triangle
+	/// and the normal points from that point to the center.
+	/// @return {real} Number of spheres which intersect a triangle.
+	/// @throws {BBMOD_Error} If the handle is not valid or the model does not
+	/// have a BVH.
+	/// @see BBMOD_DLL.model_raycast
+	static model_overlap_sphere = function (_model, _spheres, _count, _hits) {
+		gml_pragma("forceinline");
+		var _retval = external_call(dll_model_overlap_sphere, _model,
+			buffer_get_address(_spheres), _count, buffer_get_address(_hits));
+		if (_retval == BBMOD_DLL_FAILURE)
+		{
+			throw new BBMOD_Error();
+		}
+		return _retval;
+	};
+
+	/// @func blob_load(_file)
+	/// @desc Loads a model file and repacks it natively into a blob, which
+	/// {@link BBMOD_Model.from_blob} loads without parsing vertices in GML.
+	/// @param {string} _file Path to a "*.bbmod" file.
+	/// @return {real} A handle of the blob.
+	/// @throws {BBMOD_Error} If the file could not be read or it is not
+	/// a valid model.
+	/// @see BBMOD_DLL.blob_get_size
+	/// @see BBMOD_DLL.blob_write
+	/// @see BBMOD_DLL.blob_destroy
+	/// @see BBMOD_Model.from_dll
+	static blob_load = function (_file) {
+		gml_pragma("forceinline");
+		var _blob = external_call(dll_blob_load, _file);
+		if (_blob == BBMOD_DLL_FAILURE)
+		{
+			throw new BBMOD_Error("Could not load model " + _file + "!");
+		}
+		return _blob;
+	};
+
+	/// @func blob_get_size(_blob)
+	/// @desc Retrieves the size of a blob in bytes.
+	/// @param {real} _blob A handle of the blob.
+	/// @return {real} The size of the blob.
+	/// @throws {BBMOD_Error} If the handle is not valid.
+	static blob_get_size = function (_blob) {
+		gml_pragma("forceinline");
+		var _size = external_call(dll_blob_get_size, _blob);
+		if (_size == BBMOD_DLL_FAILURE)
+		{
+			throw new BBMOD_Error();
+		}
+		return _size;
+	};
+
+	/// @func blob_write(_blob, _buffer)
+	/// @desc Copies a blob into a buffer.
+	/// @param {real} _blob A handle of the blob.
+	/// @param {buffer} _buffer A buffer of at least
+	/// {@link BBMOD_DLL.blob_get_size} bytes.
+	/// @return {BBMOD_DLL} Returns `self` to allow method chaining.
+	/// @throws {BBMOD_Error} If the handle is not valid.
+	static blob_write = function (_blob, _buffer) {
+		gml_pragma("forceinline");
+		var _retval = external_call(dll_blob_write, _blob, buffer_get_address(_buffer));
+		if (_retval != BBMOD_DLL_SUCCESS)
+		{
+			throw new BBMOD_Error();
+		}
+		return self;
+	};
+
+	/// @func blob_destroy(_blob)
+	/// @desc Frees memory used by a blob.
+	/// @param {real} _blob A handle of the blob.
+	/// @return {BBMOD_DLL} Returns `self` to allow method chaining.
+	/// @throws {BBMOD_Error} If the handle is not valid.
+	static blob_destroy = function (_blob) {
+		gml_pragma("forceinline");
+		var _retval = external_call(dll_blob_destroy, _blob);
+		if (_retval != BBMOD_DLL_SUCCESS)
+		{
+			throw new BBMOD_Error();
+		}
+		return self;
+	};
+
+	/// @func animation_load(_file)
+	/// @desc Loads an animation into the DLL, so it can be sampled natively.
+	/// @param {string} _file Path to a "*.bbanim" file.
+	/// @return {real} A handle of the loaded animation.
+	/// @throws {BBMOD_Error} If the animation fails to load.
+	/// @see BBMOD_DLL.animation_destroy
+	static animation_load = function (_file) {
+		gml_pragma("forceinline");
+		var _animation = external_call(dll_animation_load, _file);
+		if (_animation == BBMOD_DLL_FAILURE)
+		{
+			throw new BBMOD_Error("Could not load animation " + _file + "!");
+		}
+		return _animation;
+	};
+
+	/// @func animation_get_duration(_animation)
+	/// @desc Retrieves duration of an animation loaded into the DLL.
+	/// @param {real} _animation A handle of the animation.
+	/// @return {real} The duration of the animation (in tics).
+	static animation_get_duration = function (_animation) {
+		gml_pragma("forceinline");
+		return external_call(dll_animation_get_duration, _animation);
+	};
+
+	/// @func animation_get_tics_per_second(_animation)
+	/// @desc Retrieves number of tics per second of an animation loaded into
+	/// the DLL.
+	/// @param {real} _animation A handle of the animation.
+	/// @return {real} The number of animation tics per second.
+	static animation_get_tics_per_second = function (_animation) {
+		gml_pragma("forceinline");
+		return external_call(dll_animation_get_tics_per_second, _animation);
+	};
+
+	/// @func animation_destroy(_animation)
+	/// @desc Frees memory used by an animation loaded into the DLL. Animation
+	/// instances which play the animation must be destroyed or play another
+	/// animation first.
+	/// @param {real} _animation A handle of the animation.
+	/// @return {BBMOD_DLL} Returns `self` to allow method chaining.
+	/// @throws {BBMOD_Error} If the handle is not valid or the animation is
+	/// still played by an animation instance.
+	/// @see BBMOD_DLL.animation_load
+	static animation_destroy = function (_animation) {
+		gml_pragma("forceinline");
+		var _retval = external_call(dll_animation_destroy, _animation);
+		if (_retval != BBMOD_DLL_SUCCESS)
+		{
+			throw new BBMOD_Error();
+		}
+		return self;
+	};
+
+	/// @func pose_create(_model)
+	/// @desc Creates a pose of a model loaded into the DLL.
+	/// @param {real} _model A handle of the model.
+	/// @return {real} A handle of the created pose.
+	/// @throws {BBMOD_Error} If the model handle is not valid.
+	/// @see BBMOD_DLL.pose_destroy
+	static pose_create = function (_model) {
+		gml_pragma("forceinline");
+		var _pose = external_call(dll_pose_create, _model);
+		if (_pose == BBMOD_DLL_FAILURE)
+		{
+			throw new BBMOD_Error();
+		}
+		return _pose;
+	};
+
+	/// @func pose_sample(_pose, _animation, _animation_time[, _interpolate])
+	/// @desc Samples an animation into a pose.
+	/// @param {real} _pose A handle of the pose.
+	/// @param {real} _animation A handle of the animation.
+	/// @param {real} _animation_time The animation time (in tics).
+	/// @param {bool} [_interpolate] `false` to disable interpolation between
+	/// animation frames. Defaults to `true`.
+	/// @return {BBMOD_DLL} Returns `self` to allow method chaining.
+	/// @throws {BBMOD_Error} If a handle is not valid.
+	static pose_sample = function (_pose, _animation, _animation_time, _interpolate) {
+		gml_pragma("forceinline");
+		_interpolate = !is_undefined(_interpolate) ? _interpolate : true;
+		var _retval = external_call(dll_pose_sample, _pose, _animation, _animation_time, _interpolate);
+		if (_retval != BBMOD_DLL_SUCCESS)
+		{
+			throw new BBMOD_Error();
+		}
+		return self;
+	};
+
+	/// @func pose_transform(_pose, _buffer)
+	/// @desc Computes transformation matrices of all bones of a pose and
+	/// writes them into a buffer.
+	/// @param {real} _pose A handle of the pose.
+	/// @param {buffer} _buffer A buffer of at least `BoneCount * 64` bytes.
+	/// It can be passed to {@link BBMOD_Model.render} as the transform.
+	/// @return {BBMOD_DLL} Returns `self` to allow method chaining.
+	/// @throws {BBMOD_Error} If the handle is not valid.
+	static pose_transform = function (_pose, _buffer) {
+		gml_pragma("forceinline");
+		var _retval = external_call(dll_pose_transform, _pose, buffer_get_address(_buffer));
+		if (_retval != BBMOD_DLL_SUCCESS)
+		{
+			throw new BBMOD_Error();
+		}
+		return self;
+	};
+
+	/// @func pose_get_node_transform(_pose, _node_index, _buffer)
+	/// @desc Writes a transformation matrix of a node computed in the last
+	/// {@link BBMOD_DLL.pose_transform} into a buffer.
+	/// @param {real} _pose A handle of the pose.
+	/// @param {real} _node_index An index of the node.
+	/// @param {buffer} _buffer A buffer of at least 64 bytes.
+	/// @return {BBMOD_DLL} Returns `self` to allow method chaining.
+	/// @throws {BBMOD_Error} If the handle or the node index is not valid.
+	static pose_get_node_transform = function (_pose, _node_index, _buffer) {
+		gml_pragma("forceinline");
+		var _retval = external_call(dll_pose_get_node_transform, _pose, _node_index, buffer_get_address(_buffer));
+		if (_retval != BBMOD_DLL_SUCCESS)
+		{
+			throw new BBMOD_Error();
+		}
+		return self;
+	};
+
+	/// @func pose_copy(_pose, _other)
+	/// @desc Copies a pose into another pose of the same model.
+	/// @param {real} _pose A handle of the pose to copy into.
+	/// @param {real} _other A handle of the pose to copy.
+	/// @return {BBMOD_DLL} Returns `self` to allow method chaining.
+	/// @throws {BBMOD_Error} If a handle is not valid or the poses belong to
+	/// different models.
+	static pose_copy = function (_pose, _other) {
+		gml_pragma("forceinline");
+		var _retval = external_call(dll_pose_copy, _pose, _other);
+		if (_retval != BBMOD_DLL_SUCCESS)
+		{
+			throw new BBMOD_Error();
+		}
+		return self;
+	};
+
+	/// @func pose_blend(_pose, _other, _factor[, _mask])
+	/// @desc Blends a pose towards another pose of the same model. Use this
+	/// after {@link BBMOD_DLL.pose_sample} and before
+	/// {@link BBMOD_DLL.pose_transform}.
+	/// @param {real} _pose A handle of the pose to blend.
+	/// @param {real} _other A handle of the pose to blend towards.
+	/// @param {real} _factor The blend factor, 0 keeps `_pose` unchanged, 1
+	/// results in `_other`.
+	/// @param {real} [_mask] A handle of a mask with weights of individual
+	/// nodes. By default all nodes are blended.
+	/// @return {BBMOD_DLL} Returns `self` to allow method chaining.
+	/// @throws {BBMOD_Error} If a handle is not valid or the poses belong to
+	/// different models.
+	/// @see BBMOD_DLL.mask_create
+	static pose_blend = function (_pose, _other, _factor, _mask) {
+		gml_pragma("forceinline");
+		_mask = !is_undefined(_mask) ? _mask : BBMOD_DLL_FAILURE;
+		var _retval = external_call(dll_pose_blend, _pose, _other, _factor, _mask);
+		if (_retval != BBMOD_DLL_SUCCESS)
+		{
+			throw new BBMOD_Error();
+		}
+		return self;
+	};
+
+	/// @func pose_destroy(_pose)
+	/// @desc Frees memory used by a pose.
+	/// @param {real} _pose A handle of the pose.
+	/// @return {BBMOD_DLL} Returns `self` to allow method chaining.
+	/// @throws {BBMOD_Error} If the handle is not valid.
+	/// @see BBMOD_DLL.pose_create
+	static pose_destroy = function (_pose) {
+		gml_pragma("forceinline");
+		var _retval = external_call(dll_pose_destroy, _pose);
+		if (_retval != BBMOD_DLL_SUCCESS)
+		{
+			throw new BBMOD_Error();
+		}
+		return self;
+	};
+
+	/// @func mask_create(_model)
+	/// @desc Creates a mask with weights of nodes of a model, used to blend
+	/// only a part of a pose. All weights are 0 by default.
+	/// @param {real} _model A handle of the model.
+	/// @return {real} A handle of the created mask.
+	/// @throws {BBMOD_Error} If the model handle is not valid.
+	/// @example
+	/// ```gml
+	/// mask_upper_body = dll.mask_create(native_character);
+	/// dll.mask_set_weight(mask_upper_body, spine_index, 1, true);
+	/// ```
+	/// @see BBMOD_DLL.pose_blend
+	/// @see BBMOD_DLL.mask_destroy
+	static mask_create = function (_model) {
+		gml_pragma("forceinline");
+		var _mask = external_call(dll_mask_create, _model);
+		if (_mask == BBMOD_DLL_FAILURE)
+		{
+			throw new BBMOD_Error();
+		}
+		return _mask;
+	};
+
+	/// @func mask_set_weight(_mask, _node_index, _weight[, _children])
+	/// @desc Changes a weight of a node in a mask.
+	/// @param {real} _mask A handle of the mask.
+	/// @param {real} _node_index An index of the node.
+	/// @param {real} _weight The new weight, from 0 to 1.
+	/// @param {bool} [_children] `true` to set the weight to all descendants
+	/// of the node too. Defaults to `true`.
+	/// @return {BBMOD_DLL} Returns `self` to allow method chaining.
+	/// @throws {BBMOD_Error} If the handle or the node index is not valid.
+	static mask_set_weight = function (_mask, _node_index, _weight, _children) {
+		gml_pragma("forceinline");
+		_children = !is_undefined(_children) ? _children : true;
+		var _retval = external_call(dll_mask_set_weight, _mask, _node_index, _weight, _children);
+		if (_retval != BBMOD_DLL_SUCCESS)
+		{
+			throw new BBMOD_Error();
+		}
+		return self;
+	};
+
+	/// @func mask_destroy(_mask)
+	/// @desc Frees memory used by a mask.
+	/// @param {real} _mask A handle of the mask.
+	/// @return {BBMOD_DLL} Returns `self` to allow method chaining.
+	/// @throws {BBMOD_Error} If the handle is not valid.
+	/// @see BBMOD_DLL.mask_create
+	static mask_destroy = function (_mask) {
+		gml_pragma("forceinline");
+		var _retval = external_call(dll_mask_destroy, _mask);
+		if (_retval != BBMOD_DLL_SUCCESS)
+		{
+			throw new BBMOD_Error();
+		}
+		return self;
+	};
+
+	/// @func instance_create(_model, _animation[, _time[, _speed]])
+	/// @desc Creates an instance of a model loaded into the DLL, which plays
+	/// a looping animation. All instances are animated at once in parallel
+	/// with {@link BBMOD_DLL.update_all}.
+	/// @param {real} _model A handle of the model.
+	/// @param {real/undefined} _animation A handle of the animation to play or
+	/// `undefined`.
+	/// @param {real} [_time] The starting time (in seconds). Defaults to 0.
+	/// @param {real} [_speed] The playback speed. Defaults to 1.
+	/// @return {real} A handle of the created instance.
+	/// @throws {BBMOD_Error} If the model handle is not valid.
+	/// @example
+	/// ```gml
+	/// /// @desc Create event of OCharacter
+	/// var _res = OResourceManager;
+	/// transform = buffer_create(_res.mod_character.BoneCount * 64, buffer_fixed, 4);
+	/// instance = _res.dll.instance_create(_res.native_character, _res.anim_walk);
+	/// _res.dll.instance_set_buffer(instance, transform);
+	///
+	/// /// @desc Step event of OResourceManager
+	/// dll.update_all(delta_time);
+	///
+	/// /// @desc Draw Begin event of OResourceManager
+	/// dll.wait();
+	///
+	/// /// @desc Draw event of OCharacter
+	/// OResourceManager.mod_character.render(undefined, transform);
+	/// ```
+	/// @see BBMOD_DLL.instance_destroy
+	static instance_create = function (_model, _animation, _time, _speed) {
+		_animation = !is_undefined(_animation) ? _animation : BBMOD_DLL_FAILURE;
+		_time = !is_undefined(_time) ? _time : 0;
+		_speed = !is_undefined(_speed) ? _speed : 1;
+		var _instance = external_call(dll_instance_create, _model, _animation, _time, _speed);
+		if (_instance == BBMOD_DLL_FAILURE)
+		{
+			throw new BBMOD_Error();
+		}
+		return _instance;
+	};
+
+	/// @func instance_set_buffer(_instance, _buffer)
+	/// @desc Changes a buffer into which are written transformation matrices
+	/// of bones of an instance. The buffer must not be deleted or resized
+	/// while the instance uses it.
+	/// @param {real} _instance A handle of the instance.
+	/// @param {buffer} _buffer A buffer of at least `BoneCount * 64` bytes.
+	/// @return {BBMOD_DLL} Returns `self` to allow method chaining.
+	/// @throws {BBMOD_Error} If the handle is not valid.
+	static instance_set_buffer = function (_instance, _buffer) {
+		gml_pragma("forceinline");
+		var _retval = external_call(dll_instance_set_buffer, _instance, buffer_get_address(_buffer));
+		if (_retval != BBMOD_DLL_SUCCESS)
+		{
+			throw new BBMOD_Error();
+		}
+		return self;
+	};
+
+	/// @func instance_play(_instance, _animation[, _time[, _transition]])
+	/// @desc Changes an animation played by an instance.
+	/// @param {real} _instance A handle of the instance.
+	/// @param {real} _animation A handle of the animation.
+	/// @param {real} [_time] The starting time (in seconds). Defaults to 0.
+	/// @param {real} [_transition] Duration of a crossfade from the current
+	/// pose (in seconds). Defaults to 0.1.
+	/// @return {BBMOD_DLL} Returns `self` to allow method chaining.
+	/// @throws {BBMOD_Error} If the handle is not valid.
+	static instance_play = function (_instance, _animation, _time, _transition) {
+		gml_pragma("forceinline");
+		_time = !is_undefined(_time) ? _time : 0;
+		_transition = !is_undefined(_transition) ? _transition : 0.1;
+		var _retval = external_call(dll_instance_play, _instance, _animation, _time, _transition);
+		if (_retval != BBMOD_DLL_SUCCESS)
+		{
+			throw new BBMOD_Error();
+		}
+		return self;
+	};
+
+	/// @func instance_set_speed(_instance, _speed)
+	/// @desc Changes playback speed of an instance.
+	/// @param {real} _instance A handle of the instance.
+	/// @param {real} _speed The new playback speed.
+	/// @return {BBMOD_DLL} Returns `self` to allow method chaining.
+	/// @throws {BBMOD_Error} If the handle is not valid.
+	static instance_set_speed = function (_instance, _speed) {
+		gml_pragma("forceinline");
+		var _retval = external_call(dll_instance_set_speed, _instance, _speed);
+		if (_retval != BBMOD_DLL_SUCCESS)
+		{
+			throw new BBMOD_Error();
+		}
+		return self;
+	};
+
+	/// @func instance_destroy(_instance)
+	/// @desc Frees memory used by an instance.
+	/// @param {real} _instance A handle of the instance.
+	/// @return {BBMOD_DLL} Returns `self` to allow method chaining.
+	/// @throws {BBMOD_Error} If the handle is not valid.
+	/// @see BBMOD_DLL.instance_create
+	static instance_destroy = function (_instance) {
+		gml_pragma("forceinline");
+		var _retval = external_call(dll_instance_destroy, _instance);
+		if (_retval != BBMOD_DLL_SUCCESS)
+		{
+			throw new BBMOD_Error();
+		}
+		return self;
+	};
+
+	/// @func get_thread_count()
+	/// @desc Retrieves number of worker threads used to update instances.
+	/// @return {real} The number of worker threads or 0 for default.
+	/// @see BBMOD_DLL.set_thread_count
+	static get_thread_count = function () {
+		gml_pragma("forceinline");
+		return external_call(dll_get_thread_count);
+	};
+
+	/// @func set_thread_count(_count)
+	/// @desc Changes number of worker threads used to update instances. This
+	/// is by default one less than the number of hardware threads, since the
+	/// thread which waits for the update works too.
+	/// @param {real} _count The number of worker threads or 0 for default.
+	/// @return {BBMOD_DLL} Returns `self` to allow method chaining.
+	/// @throws {BBMOD_Error} If the operation fails.
+	/// @see BBMOD_DLL.get_thread_count
+	static set_thread_count = function (_count) {
+		gml_pragma("forceinline");
+		var _retval = external_call(dll_set_thread_count, _count);
+		if (_retval != BBMOD_DLL_SUCCESS)
+		{
+			throw new BBMOD_Error();
+		}
+		return self;
+	};
+
+	/// @func update_all(_delta_time)
+	/// @desc Starts updating all instances in worker threads and returns
+	/// immediately. Use {@link BBMOD_DLL.wait} before the instances are
+	/// rendered.
+	/// @param {real} _delta_time The `delta_time`.
+	/// @return {BBMOD_DLL} Returns `self` to allow method chaining.
+	/// @see BBMOD_DLL.wait
+	static update_all = function (_delta_time) {
+		gml_pragma("forceinline");
+		external_call(dll_update_all, _delta_time * 0.000001);
+		return self;
+	};
+
+	/// @func wait()
+	/// @desc Waits until all instances are updated. Functions which change
+	/// instances wait automatically.
+	/// @return {BBMOD_DLL} Returns `self` to allow method chaining.
+	/// @see BBMOD_DLL.update_all
+	static wait = function () {
+		gml_pragma("forceinline");
+		external_call(dll_wait);
+		return self;
+	};
+
+	/// @func stream_load(_file, _type, _priority)
+	/// @desc Enqueues a file to be loaded on a background thread.
+	/// @param {string} _file Path to the file.
+	/// @param {real} _type {@link BBMOD_STREAM_MODEL} or
+	/// {@link BBMOD_STREAM_ANIMATION}.
+	/// @param {real} _priority Files with higher priority are loaded first.
+	/// @return {real} An id of the streamed item.
+	/// @throws {BBMOD_Error} If the type is not valid.
+	/// @see BBMOD_Streamer
+	static stream_load = function (_file, _type, _priority) {
+		gml_pragma("forceinline");
+		var _id = external_call(dll_stream_load, _file, _type, _priority);
+		if (_id == BBMOD_DLL_FAILURE)
+		{
+			throw new BBMOD_Error();
+		}
+		return _id;
+	};
+
+	/// @func stream_remove(_id)
+	/// @desc Removes a streamed item. Loading of the item is cancelled if it
+	/// has not finished yet, otherwise its staged data are freed.
+	/// @param {real} _id The id of the item.
+	/// @return {BBMOD_DLL} Returns `self` to allow method chaining.
+	/// @throws {BBMOD_Error} If there is no item with given id.
+	static stream_remove = function (_id) {
+		gml_pragma("forceinline");
+		var _retval = external_call(dll_stream_remove, _id);
+		if (_retval != BBMOD_DLL_SUCCESS)
+		{
+			throw new BBMOD_Error();
+		}
+		return self;
+	};
+
+	/// @func stream_poll()
+	/// @desc Retrieves an id of a streamed item which has finished loading
+	/// since the last call.
+	/// @return {real/undefined} The id of the item or `undefined` if no item
+	/// has finished.
+	static stream_poll = function () {
+		gml_pragma("forceinline");
+		var _id = external_call(dll_stream_poll);
+		return (_id == BBMOD_DLL_FAILURE) ? undefined : _id;
+	};
+
+	/// @func stream_get_state(_id)
+	/// @desc Retrieves the state of a streamed item.
+	/// @param {real} _id The id of the item.
+	/// @return {real} One of `BBMOD_STREAM_QUEUED`, `BBMOD_STREAM_LOADING`,
+	/// `BBMOD_STREAM_DONE` or `BBMOD_STREAM_FAILED`.
+	/// @throws {BBMOD_Error} If there is no item with given id.
+	static stream_get_state = function (_id) {
+		gml_pragma("forceinline");
+		var _state = external_call(dll_stream_get_state, _id);
+		if (_state == BBMOD_DLL_FAILURE)
+		{
+			throw new BBMOD_Error();
+		}
+		return _state;
+	};
+
+	/// @func stream_get_size(_id)
+	/// @desc Retrieves the size of staged data of a loaded item.
+	/// @param {real} _id The id of the item.
+	/// @return {real} The size of the data in bytes.
+	/// @throws {BBMOD_Error} If the item does not exist or it is not loaded.
+	static stream_get_size = function (_id) {
+		gml_pragma("forceinline");
+		var _size = external_call(dll_stream_get_size, _id);
+		if (_size == BBMOD_DLL_FAILURE)
+		{
+			throw new BBMOD_Error();
+		}
+		return _size;
+	};
+
+	/// @func stream_write(_id, _buffer)
+	/// @desc Copies staged data of a loaded item into a buffer.
+	/// @param {real} _id The id of the item.
+	/// @param {buffer} _buffer A buffer of at least
+	/// {@link BBMOD_DLL.stream_get_size} bytes.
+	/// @return {BBMOD_DLL} Returns `self` to allow method chaining.
+	/// @throws {BBMOD_Error} If the item does not exist or it is not loaded.
+	static stream_write = function (_id, _buffer) {
+		gml_pragma("forceinline");
+		var _retval = external_call(dll_stream_write, _id, buffer_get_address(_buffer));
+		if (_retval != BBMOD_DLL_SUCCESS)
+		{
+			throw new BBMOD_Error();
+		}
+		return self;
+	};
+
+	/// @func stream_get_budget()
+	/// @desc Retrieves the maximum size of staged data. Loading of files
+	/// pauses when it is exceeded, until staged data are removed.
+	/// @return {real} The budget in bytes.
+	/// @see BBMOD_DLL.stream_set_budget
+	static stream_get_budget = function () {
+		gml_pragma("forceinline");
+		return external_call(dll_stream_get_budget);
+	};
+
+	/// @func stream_set_budget(_budget)
+	/// @desc Changes the maximum size of staged data. This is by default
+	/// 64 MiB. A single file is always loaded, even if it is over budget.
+	/// @param {real} _budget The budget in bytes.
+	/// @return {BBMOD_DLL} Returns `self` to allow method chaining.
+	/// @throws {BBMOD_Error} If the budget is negative.
+	/// @see BBMOD_DLL.stream_get_budget
+	static stream_set_budget = function (_budget) {
+		gml_pragma("forceinline");
+		var _retval = external_call(dll_stream_set_budget, _budget);
+		if (_retval != BBMOD_DLL_SUCCESS)
+		{
+			throw new BBMOD_Error();
+		}
+		return self;
+	};
+
+	/// @func stream_get_staged_size()
+	/// @desc Retrieves the size of staged data of all loaded items which were
+	/// not removed yet.
+	/// @return {real} The size in bytes.
+	static stream_get_staged_size = function () {
+		gml_pragma("forceinline");
+		return external_call(dll_stream_get_staged_size);
+	};
+
 	/// @func destroy()
 	/// @desc Frees memory used by the DLL. Use this in combination with
 	/// `delete` to destroy the struct.
@@ -13,6 +13,9 @@
 /// use a single material and must not have bones.
 /// @param {real} _size Number of model instances in the batch.
 ///
+/// @throws {BBMOD_Error} If the model was converted for dynamic batching with
+/// a smaller batch size.
+///
 /// @example
 /// Following code renders all instances of a car object in batches of 64.
 /// ```gml
@@ -44,9 +47,24 @@ function BBMOD_DynamicBatch(_model, _size) constructor
 	/// @private
 	VertexFormat = Model.get_vertex_format(false, true);
 
-	vertex_begin(VertexBuffer, VertexFormat.Raw);
-	Model.to_dynamic_batch(self);
-	vertex_end(VertexBuffer);
+	if (Model.BatchSize > 0)
+	{
+		// The model was converted for dynamic batching, so its meshes already
+		// contain enough copies with ids
+		if (Size > Model.BatchSize)
+		{
+			throw new BBMOD_Error("The model is converted for batches of at most "
+				+ string(Model.BatchSize) + " instances!");
+		}
+		vertex_delete_buffer(VertexBuffer);
+		VertexBuffer = _bbmod_dynamic_batch_from_batched_model(Model, Size);
+	}
+	else
+	{
+		vertex_begin(VertexBuffer, VertexFormat.Raw);
+		Model.to_dynamic_batch(self);
+		vertex_end(VertexBuffer);
+	}
 
 	/// @func freeze()
 	/// @desc Freezes the dynamic batch. This makes it render faster.
@@ -173,4 +191,48 @@ function BBMOD_DynamicBatch(_model, _size) constructor
 		gml_pragma("forceinline");
 		vertex_delete_buffer(VertexBuffer);
 	};
+}
+
+/// @func _bbmod_dynamic_batch_from_batched_model(_model, _size)
+/// @desc Creates a vertex buffer for a dynamic batch from meshes of a model
+/// converted for dynamic batching.
+/// @param {BBMOD_Model} _model The model. Its batch size must be at least
+/// `_size`.
+/// @param {real} _size Number of model instances in the batch.
+/// @return {vertex_buffer} The created vertex buffer.
+/// @private
+function _bbmod_dynamic_batch_from_batched_model(_model, _size)
+{
+	var _format = _model.VertexFormat;
+	var _vertex_size = _format.get_byte_size();
+	var _meshes = _model.Meshes;
+	var _mesh_count = array_length(_meshes);
+	var _buffers = array_create(_mesh_count, undefined);
+	var _total = 0;
+	var i = 0;
+
+	// Only the first _size copies of each mesh are used
+	repeat (_mesh_count)
+	{
+		var _vbuffer = _meshes[i][BBMOD_EMesh.VertexBuffer];
+		var _count = (vertex_get_number(_vbuffer) div _model.BatchSize) * _size;
+		_buffers[@ i++] = [buffer_create_from_vertex_buffer(_vbuffer, buffer_fixed, 1), _count];
+		_total += _count;
+	}
+
+	var _buffer = buffer_create(max(_total * _vertex_size, 1), buffer_fixed, 1);
+	var _offset = 0;
+	i = 0;
+	repeat (_mesh_count)
+	{
+		var _mesh_buffer = _buffers[i][0];
+		var _size_bytes = _buffers[i++][1] * _vertex_size;
+		buffer_copy(_mesh_buffer, 0, _size_bytes, _buffer, _offset);
+		buffer_delete(_mesh_buffer);
+		_offset += _size_bytes;
+	}
+
+	var _vertex_buffer = vertex_create_buffer_from_buffer_ext(_buffer, _format.Raw, 0, _total);
+	buffer_delete(_buffer);
+	return _vertex_buffer;
 }
\ No newline at end of file
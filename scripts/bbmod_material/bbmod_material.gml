@@ -77,7 +77,8 @@ global.bbmod_render_pass = BBMOD_RENDER_FORWARD;
 /// @param {BBMOD_Material} _material The material.
 function bbmod_material_on_apply_default(_material)
 {
-	var _shader = _material.Shader;
+	// Can be a skinning variant of the material's shader
+	var _shader = shader_current();
 
 	if (!_material.Mipmapping)
 	{
@@ -131,6 +132,9 @@ function BBMOD_Material(_shader) constructor
 	/// Must take the material as the first argument. Use `undefined`
 	/// if you don't want to execute any function. Defaults
 	/// to {@link bbmod_material_on_apply_default}.
+	/// @note The applied shader can be a skinning variant of
+	/// {@link BBMOD_Material.Shader}, so uniforms should be set using
+	/// `shader_current()`.
 	OnApply = bbmod_material_on_apply_default;
 
 	/// @var {real} A blend mode. Use one of the `bm_` constants. Default value is
@@ -205,12 +209,19 @@ function BBMOD_Material(_shader) constructor
 		return _clone;
 	};
 
-	/// @func apply()
+	/// @func apply([_shader])
 	/// @desc Makes this material the current one.
-	/// @return {bool} Returns `true` if the material has changed or `false`
-	/// if this material already was the current one.
-	static apply = function () {
-		if (global.__bbmod_material_current == self)
+	/// @param {shader} [_shader] A shader to use instead of
+	/// {@link BBMOD_Material.Shader}, e.g. its skinning variant. Defaults to
+	/// `undefined`.
+	/// @return {bool} Returns `true` if the material or its shader has changed
+	/// or `false` if this material already was the current one.
+	/// @see bbmod_shader_get_skinning_variant
+	static apply = function (_shader) {
+		_shader = !is_undefined(_shader) ? _shader : Shader;
+
+		if (global.__bbmod_material_current == self
+			&& shader_current() == _shader)
 		{
 			return false;
 		}
@@ -220,7 +231,6 @@ function BBMOD_Material(_shader) constructor
 		global.__bbmod_material_current = self;
 
 		// Shader
-		var _shader = Shader;
 		if (shader_current() != _shader)
 		{
 			shader_set(_shader);
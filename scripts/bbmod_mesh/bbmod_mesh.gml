@@ -10,40 +10,40 @@ enum BBMOD_EMesh
 	/// @member {vertex_buffer} A vertex buffer.
 	/// @readonly
 	VertexBuffer,
+	/// @member {real} The primitive type of the vertex buffer, either
+	/// `pr_trianglelist` or `pr_trianglestrip`.
+	/// @readonly
+	PrimitiveType,
+	/// @member {BBMOD_VertexFormat} The vertex format of the vertex buffer.
+	/// It has only attributes which the mesh uses, so it can differ between
+	/// meshes of a single model.
+	/// @see BBMOD_Model.VertexFormat
+	/// @readonly
+	VertexFormat,
 	/// @member The size of the struct.
 	SIZE
 };
 
-/// @func bbmod_mesh_load(_buffer, _format)
+/// @func bbmod_mesh_load(_buffer)
 /// @desc Loads a mesh from a bufffer.
 /// @param {buffer} _buffer The buffer to load the struct from.
-/// @param {BBMOD_VertexFormat} _format A vertex format that the mesh uses.
 /// @return {BBMOD_EMesh} The loaded mesh.
 /// @private
-function bbmod_mesh_load(_buffer, _format)
+function bbmod_mesh_load(_buffer)
 {
-	var _has_vertices = _format.Vertices;
-	var _has_normals = _format.Normals;
-	var _has_uvs = _format.TextureCoords;
-	var _has_colors = _format.Colors;
-	var _has_tangentw = _format.TangentW;
-	var _has_bones = _format.Bones;
-	var _has_ids = _format.Ids;
-
 	var _mesh = array_create(BBMOD_EMesh.SIZE, undefined);
 	_mesh[@ BBMOD_EMesh.MaterialIndex] = buffer_read(_buffer, buffer_u32);
+	_mesh[@ BBMOD_EMesh.PrimitiveType] = (buffer_read(_buffer, buffer_u8) == 1)
+		? pr_trianglestrip
+		: pr_trianglelist;
+
+	var _format = bbmod_vertex_format_load(_buffer);
+	_mesh[@ BBMOD_EMesh.VertexFormat] = _format;
 
 	var _vertex_count = buffer_read(_buffer, buffer_u32);
 	if (_vertex_count > 0)
 	{
-		var _size = _vertex_count * (0
-			+ _has_vertices * 3 * buffer_sizeof(buffer_f32)
-			+ _has_normals * 3 * buffer_sizeof(buffer_f32)
-			+ _has_uvs * 2 * buffer_sizeof(buffer_f32)
-			+ _has_colors * buffer_sizeof(buffer_u32)
-			+ _has_tangentw * 4 * buffer_sizeof(buffer_f32)
-			+ _has_bones * 8 * buffer_sizeof(buffer_f32)
-			+ _has_ids * buffer_sizeof(buffer_f32));
+		var _size = _vertex_count * _format.get_byte_size();
 
 		if (_size > 0)
 		{
@@ -75,6 +75,45 @@ function _bbmod_mesh_freeze(_mesh)
 	vertex_freeze(_mesh[BBMOD_EMesh.VertexBuffer]);
 }
 
+/// @func _bbmod_mesh_get_triangle_list(_mesh)
+/// @desc Returns indices of vertices of a mesh in the order in which they form
+/// a triangle list. Triangle strips are expanded, including their degenerate
+/// triangles.
+/// @param {BBMOD_EMesh} _mesh
+/// @return {real[]} The vertex indices.
+/// @private
+function _bbmod_mesh_get_triangle_list(_mesh)
+{
+	var _vertex_count = vertex_get_number(_mesh[BBMOD_EMesh.VertexBuffer]);
+
+	if (_mesh[BBMOD_EMesh.PrimitiveType] != pr_trianglestrip)
+	{
+		var _indices = array_create(_vertex_count, 0);
+		var i = 0;
+		repeat (_vertex_count)
+		{
+			_indices[@ i] = i;
+			++i;
+		}
+		return _indices;
+	}
+
+	// Every other triangle of a strip has a flipped winding order
+	var _triangle_count = max(_vertex_count - 2, 0);
+	var _indices = array_create(_triangle_count * 3, 0);
+	var i = 0;
+	var j = 0;
+	repeat (_triangle_count)
+	{
+		var _odd = (i & 1);
+		_indices[@ j++] = i + _odd;
+		_indices[@ j++] = i + 1 - _odd;
+		_indices[@ j++] = i + 2;
+		++i;
+	}
+	return _indices;
+}
+
 /// @func _bbmod_mesh_to_dynamic_batch(_mesh, _dynamic_batch)
 /// @param {BBMOD_EMesh} _mesh
 /// @param {BBMOD_DynamicBatch} _dynamic_batch
@@ -84,24 +123,33 @@ function _bbmod_mesh_to_dynamic_batch(_mesh, _dynamic_batch)
 	var _vertex_buffer = _dynamic_batch.VertexBuffer;
 	var _model = _dynamic_batch.Model;
 	var _vertex_format = _model.VertexFormat;
-	var _has_vertices = _vertex_format.Vertices;
-	var _has_normals = _vertex_format.Normals;
-	var _has_uvs = _vertex_format.TextureCoords;
-	var _has_colors = _vertex_format.Colors;
-	var _has_tangentw = _vertex_format.TangentW;
-	var _has_bones = _vertex_format.Bones;
-	var _has_ids = _vertex_format.Ids;
+	var _mesh_vertex_format = _mesh[BBMOD_EMesh.VertexFormat];
+	var _has_vertices = _mesh_vertex_format.Vertices;
+	var _has_normals = _mesh_vertex_format.Normals;
+	var _has_uvs = _mesh_vertex_format.TextureCoords;
+	var _has_colors = _mesh_vertex_format.Colors;
+	var _has_tangentw = _mesh_vertex_format.TangentW;
+	var _has_bones = _mesh_vertex_format.Bones;
+	var _bone_influences = _mesh_vertex_format.BoneInfluences;
+	var _has_ids = _mesh_vertex_format.Ids;
+	var _vertex_size = _mesh_vertex_format.get_byte_size();
+	// Attributes which the mesh does not have are written with default values
+	var _write_normals = _vertex_format.Normals;
+	var _write_uvs = _vertex_format.TextureCoords;
+	var _write_colors = _vertex_format.Colors;
+	var _write_tangentw = _vertex_format.TangentW;
 	var _mesh_vertex_buffer = _mesh[BBMOD_EMesh.VertexBuffer];
-	var _vertex_count = vertex_get_number(_mesh_vertex_buffer);
+	var _indices = _bbmod_mesh_get_triangle_list(_mesh);
 	var _buffer = buffer_create_from_vertex_buffer(_mesh_vertex_buffer, buffer_fixed, 1);
 	var _id = 0;
 
 	repeat (_dynamic_batch.Size)
 	{
-		buffer_seek(_buffer, buffer_seek_start, 0);
-
-		repeat (_vertex_count)
+		var i = 0;
+		repeat (array_length(_indices))
 		{
+			buffer_seek(_buffer, buffer_seek_start, _indices[i++] * _vertex_size);
+
 			if (_has_vertices)
 			{
 				var _x = buffer_read(_buffer, buffer_f32);
@@ -119,6 +167,10 @@ function _bbmod_mesh_to_dynamic_batch(_mesh, _dynamic_batch)
 
 				vertex_normal(_vertex_buffer, _x, _y, _z);
 			}
+			else if (_write_normals)
+			{
+				vertex_normal(_vertex_buffer, 0, 0, 0);
+			}
 
 			if (_has_uvs)
 			{
@@ -127,6 +179,10 @@ function _bbmod_mesh_to_dynamic_batch(_mesh, _dynamic_batch)
 
 				vertex_texcoord(_vertex_buffer, _u, _v);
 			}
+			else if (_write_uvs)
+			{
+				vertex_texcoord(_vertex_buffer, 0, 0);
+			}
 
 			if (_has_colors)
 			{
@@ -137,6 +193,10 @@ function _bbmod_mesh_to_dynamic_batch(_mesh, _dynamic_batch)
 
 				vertex_float4(_vertex_buffer, _a, _b, _g, _r);
 			}
+			else if (_write_colors)
+			{
+				vertex_float4(_vertex_buffer, 255, 255, 255, 255);
+			}
 
 			if (_has_tangentw)
 			{
@@ -147,10 +207,14 @@ function _bbmod_mesh_to_dynamic_batch(_mesh, _dynamic_batch)
 
 				vertex_float4(_vertex_buffer, _x, _y, _z, _w);
 			}
+			else if (_write_tangentw)
+			{
+				vertex_float4(_vertex_buffer, 0, 0, 0, 1);
+			}
 
 			if (_has_bones)
 			{
-				repeat (8)
+				repeat ((_bone_influences > 1) ? _bone_influences * 2 : 1)
 				{
 					buffer_read(_buffer, buffer_f32);
 				}
@@ -180,20 +244,30 @@ function _bbmod_mesh_to_static_batch(_model, _mesh, _static_batch, _transform)
 {
 	var _vertex_buffer = _static_batch.VertexBuffer;
 	var _vertex_format = _model.VertexFormat;
-	var _has_vertices = _vertex_format.Vertices;
-	var _has_normals = _vertex_format.Normals;
-	var _has_uvs = _vertex_format.TextureCoords;
-	var _has_colors = _vertex_format.Colors;
-	var _has_tangentw = _vertex_format.TangentW;
-	var _has_bones = _vertex_format.Bones;
-	var _has_ids = _vertex_format.Ids;
+	var _mesh_vertex_format = _mesh[BBMOD_EMesh.VertexFormat];
+	var _has_vertices = _mesh_vertex_format.Vertices;
+	var _has_normals = _mesh_vertex_format.Normals;
+	var _has_uvs = _mesh_vertex_format.TextureCoords;
+	var _has_colors = _mesh_vertex_format.Colors;
+	var _has_tangentw = _mesh_vertex_format.TangentW;
+	var _has_bones = _mesh_vertex_format.Bones;
+	var _bone_influences = _mesh_vertex_format.BoneInfluences;
+	var _has_ids = _mesh_vertex_format.Ids;
+	var _vertex_size = _mesh_vertex_format.get_byte_size();
+	// Attributes which the mesh does not have are written with default values
+	var _write_normals = _vertex_format.Normals;
+	var _write_uvs = _vertex_format.TextureCoords;
+	var _write_colors = _vertex_format.Colors;
+	var _write_tangentw = _vertex_format.TangentW;
 	var _mesh_vertex_buffer = _mesh[BBMOD_EMesh.VertexBuffer];
+	var _indices = _bbmod_mesh_get_triangle_list(_mesh);
 	var _buffer = buffer_create_from_vertex_buffer(_mesh_vertex_buffer, buffer_fixed, 1);
 
-	buffer_seek(_buffer, buffer_seek_start, 0);
-
-	repeat (vertex_get_number(_mesh_vertex_buffer))
+	var i = 0;
+	repeat (array_length(_indices))
 	{
+		buffer_seek(_buffer, buffer_seek_start, _indices[i++] * _vertex_size);
+
 		if (_has_vertices)
 		{
 			var _x = buffer_read(_buffer, buffer_f32);
@@ -217,6 +291,10 @@ function _bbmod_mesh_to_static_batch(_model, _mesh, _static_batch, _transform)
 
 			vertex_normal(_vertex_buffer, _vec[0], _vec[1], _vec[2]);
 		}
+		else if (_write_normals)
+		{
+			vertex_normal(_vertex_buffer, 0, 0, 0);
+		}
 
 		if (_has_uvs)
 		{
@@ -225,6 +303,10 @@ function _bbmod_mesh_to_static_batch(_model, _mesh, _static_batch, _transform)
 
 			vertex_texcoord(_vertex_buffer, _u, _v);
 		}
+		else if (_write_uvs)
+		{
+			vertex_texcoord(_vertex_buffer, 0, 0);
+		}
 
 		if (_has_colors)
 		{
@@ -235,6 +317,10 @@ function _bbmod_mesh_to_static_batch(_model, _mesh, _static_batch, _transform)
 
 			vertex_float4(_vertex_buffer, _a, _b, _g, _r);
 		}
+		else if (_write_colors)
+		{
+			vertex_float4(_vertex_buffer, 255, 255, 255, 255);
+		}
 
 		if (_has_tangentw)
 		{
@@ -245,10 +331,14 @@ function _bbmod_mesh_to_static_batch(_model, _mesh, _static_batch, _transform)
 
 			vertex_float4(_vertex_buffer, _x, _y, _z, _w);
 		}
+		else if (_write_tangentw)
+		{
+			vertex_float4(_vertex_buffer, 0, 0, 0, 1);
+		}
 
 		if (_has_bones)
 		{
-			repeat (8)
+			repeat ((_bone_influences > 1) ? _bone_influences * 2 : 1)
 			{
 				buffer_read(_buffer, buffer_f32);
 			}
@@ -21,11 +21,20 @@ function BBMOD_Model(_file, _sha1) constructor
 	/// @readonly
 	Version = 0;
 
-	/// @var {BBMOD_VertexFormat} The vertex format of the model.
+	/// @var {BBMOD_VertexFormat} A vertex format with all attributes used by
+	/// any of the meshes. Each mesh has its own vertex format with only the
+	/// attributes it uses, so shaders of its material must match it.
 	/// @see BBMOD_VertexFormat
+	/// @see BBMOD_EMesh.VertexFormat
 	/// @readonly
 	VertexFormat = undefined;
 
+	/// @var {real} Number of copies of each mesh made for dynamic batching or
+	/// 0 if the model was not converted for dynamic batching.
+	/// @see BBMOD_DynamicBatch
+	/// @readonly
+	BatchSize = 0;
+
 	/// @var {BBMOD_EMesh[]} Array of meshes.
 	/// @readonly
 	Meshes = [];
@@ -74,6 +83,14 @@ function BBMOD_Model(_file, _sha1) constructor
 	/// @see BBMOD_Material
 	Materials = [];
 
+	/// @var {Struct[]} An array of shadow proxies loaded with
+	/// {@link BBMOD_Model.load_shadow_proxies}. Each has properties `Node` with
+	/// the legacy node struct whose meshes it replaces and `VertexBuffer` with
+	/// a vertex buffer of positions only.
+	/// @see BBMOD_Model.render_shadow
+	/// @readonly
+	ShadowProxies = [];
+
 	/// @func from_buffer(_buffer)
 	/// @desc Loads model data from a buffer.
 	/// @param {buffer} _buffer The buffer to load the data from.
@@ -84,6 +101,7 @@ function BBMOD_Model(_file, _sha1) constructor
 
 		// Vertex format
 		VertexFormat = bbmod_vertex_format_load(_buffer);
+		BatchSize = buffer_read(_buffer, buffer_u32);
 
 		// Meshes
 		var _meshCount = buffer_read(_buffer, buffer_u32);
@@ -92,7 +110,7 @@ function BBMOD_Model(_file, _sha1) constructor
 		i = 0;
 		repeat (_meshCount)
 		{
-			Meshes[@ i++] = bbmod_mesh_load(_buffer, VertexFormat);
+			Meshes[@ i++] = bbmod_mesh_load(_buffer);
 		}
 
 		// Global inverse transform matrix
@@ -102,6 +120,17 @@ function BBMOD_Model(_file, _sha1) constructor
 		NodeCount = buffer_read(_buffer, buffer_u32);
 		RootNode = bbmod_node_load(_buffer, VertexFormat);
 
+		load_skeleton_and_materials(_buffer);
+		return self;
+	};
+
+	/// @func load_skeleton_and_materials(_buffer)
+	/// @desc Loads the skeleton and material names from a buffer.
+	/// @param {buffer} _buffer The buffer to load the data from.
+	/// @private
+	static load_skeleton_and_materials = function (_buffer) {
+		var i;
+
 		// Skeleton
 		BoneCount = buffer_read(_buffer, buffer_u32);
 
@@ -135,7 +164,129 @@ function BBMOD_Model(_file, _sha1) constructor
 
 			MaterialNames = _material_names;
 		}
+	};
+
+	/// @func from_blob(_buffer)
+	/// @desc Loads model data from a blob created by the DLL. Vertex buffers
+	/// are created directly from offsets stored in the blob and nodes are
+	/// stored flattened, so nothing is parsed per vertex or recursively.
+	/// @param {buffer} _buffer The buffer with the blob.
+	/// @return {BBMOD_Model} Returns `self` to allow method chaining.
+	/// @see BBMOD_DLL.blob_load
+	/// @private
+	static from_blob = function (_buffer) {
+		var i;
+
+		buffer_seek(_buffer, buffer_seek_start, 0);
+		Version = BBMOD_VERSION;
+
+		// Vertex format
+		VertexFormat = bbmod_vertex_format_load(_buffer);
+		BatchSize = buffer_read(_buffer, buffer_u32);
+
+		// Mesh descriptors
+		var _mesh_count = buffer_read(_buffer, buffer_u32);
+		Meshes = array_create(_mesh_count, undefined);
+
+		i = 0;
+		repeat (_mesh_count)
+		{
+			var _mesh = array_create(BBMOD_EMesh.SIZE, undefined);
+			_mesh[@ BBMOD_EMesh.MaterialIndex] = buffer_read(_buffer, buffer_u32);
+			_mesh[@ BBMOD_EMesh.PrimitiveType] = (buffer_read(_buffer, buffer_u32) == 1)
+				? pr_trianglestrip
+				: pr_trianglelist;
+			var _mask = buffer_read(_buffer, buffer_u32);
+			var _bone_influences = (_mask >> 8) & $FF;
+			var _format = new BBMOD_VertexFormat(
+				(_mask & (1 << 0)) != 0,
+				(_mask & (1 << 1)) != 0,
+				(_mask & (1 << 2)) != 0,
+				(_mask & (1 << 3)) != 0,
+				(_mask & (1 << 4)) != 0,
+				(_mask & (1 << 5)) != 0,
+				(_mask & (1 << 6)) != 0,
+				(_bone_influences != 0) ? _bone_influences : 4);
+			_mesh[@ BBMOD_EMesh.VertexFormat] = _format;
+			var _offset = buffer_read(_buffer, buffer_u32);
+			var _vertex_count = buffer_read(_buffer, buffer_u32);
+			if (_vertex_count > 0)
+			{
+				_mesh[@ BBMOD_EMesh.VertexBuffer] = vertex_create_buffer_from_buffer_ext(
+					_buffer, _format.Raw, _offset, _vertex_count);
+			}
+			Meshes[@ i++] = _mesh;
+		}
+
+		// Global inverse transform matrix
+		InverseTransformMatrix = bbmod_load_matrix(_buffer);
+
+		// Nodes, stored in pre-order with an index of their parent
+		NodeCount = buffer_read(_buffer, buffer_u32);
+		var _entry_count = buffer_read(_buffer, buffer_u32);
+		var _nodes = array_create(_entry_count, undefined);
+		var _child_next = array_create(_entry_count, 0);
+
+		i = 0;
+		repeat (_entry_count)
+		{
+			var _parent = buffer_read(_buffer, buffer_s32);
+
+			var _node = array_create(BBMOD_ENode.SIZE, undefined);
+			_node[@ BBMOD_ENode.Name] = buffer_read(_buffer, buffer_string);
+			_node[@ BBMOD_ENode.Index] = buffer_read(_buffer, buffer_f32);
+			_node[@ BBMOD_ENode.IsBone] = buffer_read(_buffer, buffer_bool);
+			_node[@ BBMOD_ENode.Visible] = true;
+			_node[@ BBMOD_ENode.TransformMatrix] = bbmod_load_matrix(_buffer);
+
+			var _node_mesh_count = buffer_read(_buffer, buffer_u32);
+			var _meshes = array_create(_node_mesh_count, undefined);
+			var j = 0;
+			repeat (_node_mesh_count)
+			{
+				_meshes[@ j++] = buffer_read(_buffer, buffer_u32);
+			}
+			_node[@ BBMOD_ENode.Meshes] = _meshes;
+
+			var _child_count = buffer_read(_buffer, buffer_u32);
+			_node[@ BBMOD_ENode.Children] = array_create(_child_count, undefined);
+
+			if (_parent >= 0)
+			{
+				var _siblings = _nodes[_parent][BBMOD_ENode.Children];
+				var _slot = _child_next[_parent];
+				_siblings[@ _slot] = _node;
+				_child_next[@ _parent] = _slot + 1;
+			}
+
+			_nodes[@ i++] = _node;
+		}
+
+		RootNode = _nodes[0];
 
+		load_skeleton_and_materials(_buffer);
+		return self;
+	};
+
+	/// @func from_dll(_dll, _file)
+	/// @desc Loads model data from a file, which is parsed natively by the DLL.
+	/// This is considerably faster than loading the file in GML, so it is
+	/// recommended when loading many models at once.
+	/// @param {BBMOD_DLL} _dll The DLL to parse the file with.
+	/// @param {string} _file The path to the file.
+	/// @return {BBMOD_Model} Returns `self` to allow method chaining.
+	/// @throws {BBMOD_Error} If loading fails.
+	/// @example
+	/// ```gml
+	/// mod_tree = new BBMOD_Model(undefined).from_dll(dll, "tree.bbmod");
+	/// ```
+	static from_dll = function (_dll, _file) {
+		var _blob = _dll.blob_load(_file);
+		var _buffer = buffer_create(_dll.blob_get_size(_blob), buffer_fixed, 1);
+		_dll.blob_write(_blob, _buffer);
+		_dll.blob_destroy(_blob);
+		from_blob(_buffer);
+		buffer_delete(_buffer);
 		return self;
 	};
 
@@ -183,6 +334,267 @@ function BBMOD_Model(_file, _sha1) constructor
 		return self;
 	};
 
+	/// @func load_instances(_file)
+	/// @desc Loads a "*_instances.bbinst" file saved by the converter with
+	/// option `--detect-instances`. Meshes which were identical up to a
+	/// rotation and a translation are stored in the model only once and their
+	/// placements are stored in this file instead.
+	/// @param {string} _file The path to the file.
+	/// @return {Array.<Array.<real[]>>} An array containing an array of
+	/// transformation matrices for each mesh of the model.
+	/// @throws {BBMOD_Error} If loading fails.
+	/// @example
+	/// ```gml
+	/// mod_level = new BBMOD_Model("Level.bbmod");
+	/// var _instances = mod_level.load_instances("Level_instances.bbinst");
+	/// batch = new BBMOD_StaticBatch(mod_level.get_vertex_format(false));
+	/// batch.start();
+	/// for (var i = 0; i < array_length(_instances); ++i)
+	/// {
+	///     var _transforms = _instances[i];
+	///     for (var j = 0; j < array_length(_transforms); ++j)
+	///     {
+	///         batch.add_mesh(mod_level, i, _transforms[j]);
+	///     }
+	/// }
+	/// batch.finish();
+	/// batch.freeze();
+	/// ```
+	/// @see BBMOD_StaticBatch.add_mesh
+	static load_instances = function (_file) {
+		var _buffer = bbmod_load_sidecar(_file, "bbinst");
+
+		var _mesh_count = array_length(Meshes);
+		var _instances = array_create(_mesh_count, undefined);
+		var i = 0;
+		repeat (_mesh_count)
+		{
+			_instances[@ i++] = [];
+		}
+
+		repeat (buffer_read(_buffer, buffer_u32))
+		{
+			var _mesh_index = buffer_read(_buffer, buffer_u32);
+			var _transform = bbmod_load_matrix(_buffer);
+			if (_mesh_index < _mesh_count)
+			{
+				var _transforms = _instances[_mesh_index];
+				_transforms[@ array_length(_transforms)] = _transform;
+			}
+		}
+
+		buffer_delete(_buffer);
+		return _instances;
+	};
+
+	/// @func load_cells(_file)
+	/// @desc Loads a "*_cells.bbcell" file saved by the converter with option
+	/// `--cell-size`. The model then has a child node of the root node for
+	/// each cell, which can be hidden when the cell is not visible.
+	/// @param {string} _file The path to the file.
+	/// @return {Struct[]} An array of cells. Each cell has properties `X`, `Y`
+	/// and `Z` with its coordinates in the grid, `Min` and `Max` with corners
+	/// of its bounding box and `Node` with its legacy node struct.
+	/// @throws {BBMOD_Error} If loading fails.
+	/// @example
+	/// ```gml
+	/// // Create event
+	/// mod_level = new BBMOD_Model("Level.bbmod");
+	/// cells = mod_level.load_cells("Level_cells.bbcell");
+	///
+	/// // Draw event
+	/// for (var i = 0; i < array_length(cells); ++i)
+	/// {
+	///     var _cell = cells[i];
+	///     var _center_x = (_cell.Min[0] + _cell.Max[0]) * 0.5;
+	///     var _center_y = (_cell.Min[1] + _cell.Max[1]) * 0.5;
+	///     var _node = _cell.Node;
+	///     _node[@ BBMOD_ENode.Visible] = (point_distance(x, y, _center_x, _center_y) < 1024);
+	/// }
+	/// mod_level.render();
+	/// ```
+	static load_cells = function (_file) {
+		var _buffer = bbmod_load_sidecar(_file, "bbcell");
+
+		buffer_read(_buffer, buffer_f32); // Cell size
+		var _cell_count = buffer_read(_buffer, buffer_u32);
+		var _nodes = RootNode[BBMOD_ENode.Children];
+
+		if (_cell_count != array_length(_nodes))
+		{
+			buffer_delete(_buffer);
+			throw new BBMOD_Error("Cells do not match the model!");
+		}
+
+		var _cells = array_create(_cell_count, undefined);
+		var i = 0;
+		repeat (_cell_count)
+		{
+			var _x = buffer_read(_buffer, buffer_s32);
+			var _y = buffer_read(_buffer, buffer_s32);
+			var _z = buffer_read(_buffer, buffer_s32);
+			var _min = bbmod_load_vec3(_buffer);
+			var _max = bbmod_load_vec3(_buffer);
+			_cells[@ i] = {
+				X: _x,
+				Y: _y,
+				Z: _z,
+				Min: _min,
+				Max: _max,
+				Node: _nodes[i]
+			};
+			++i;
+		}
+
+		buffer_delete(_buffer);
+		return _cells;
+	};
+
+	/// @func load_hulls(_file)
+	/// @desc Loads a "*_hulls.bbhull" file saved by the converter with option
+	/// `--hull-count`.
+	/// @param {string} _file The path to the file.
+	/// @return {Struct[]} An array of convex hulls. Each hull has properties
+	/// `Node` with the index of the node which references the decomposed mesh,
+	/// `Vertices` with an array of its vertices, each being an array
+	/// `[x, y, z]`, and `Triangles` with an array of indices of vertices of its
+	/// triangles, three per triangle.
+	/// @throws {BBMOD_Error} If loading fails.
+	/// @example
+	/// ```gml
+	/// var _hulls = mod_rock.load_hulls("Rock_hulls.bbhull");
+	/// for (var i = 0; i < array_length(_hulls); ++i)
+	/// {
+	///     colliders[@ array_length(colliders)] = new MyConvexCollider(_hulls[i].Vertices);
+	/// }
+	/// ```
+	static load_hulls = function (_file) {
+		var _buffer = bbmod_load_sidecar(_file, "bbhull");
+
+		var _hull_count = buffer_read(_buffer, buffer_u32);
+		var _hulls = array_create(_hull_count, undefined);
+		var i = 0;
+		repeat (_hull_count)
+		{
+			var _node = buffer_read(_buffer, buffer_u32);
+
+			var _vertex_count = buffer_read(_buffer, buffer_u32);
+			var _vertices = array_create(_vertex_count, undefined);
+			var j = 0;
+			repeat (_vertex_count)
+			{
+				_vertices[@ j++] = bbmod_load_vec3(_buffer);
+			}
+
+			var _index_count = buffer_read(_buffer, buffer_u32) * 3;
+			var _triangles = array_create(_index_count, 0);
+			j = 0;
+			repeat (_index_count)
+			{
+				_triangles[@ j++] = buffer_read(_buffer, buffer_u16);
+			}
+
+			_hulls[@ i++] = {
+				Node: _node,
+				Vertices: _vertices,
+				Triangles: _triangles
+			};
+		}
+
+		buffer_delete(_buffer);
+		return _hulls;
+	};
+
+	/// @func load_shadow_proxies(_file)
+	/// @desc Loads a "*_shadow.bbshdw" file saved by the converter with option
+	/// `--shadow-proxies` into {@link BBMOD_Model.ShadowProxies}.
+	/// @param {string} _file The path to the file.
+	/// @return {BBMOD_Model} Returns `self` to allow method chaining.
+	/// @throws {BBMOD_Error} If loading fails.
+	/// @see BBMOD_Model.render_shadow
+	static load_shadow_proxies = function (_file) {
+		var _buffer = bbmod_load_sidecar(_file, "bbshdw");
+
+		// Find nodes by their indices
+		var _nodes = array_create(NodeCount, undefined);
+		var _stack = global.__bbmod_render_stack;
+		ds_stack_push(_stack, RootNode);
+		while (!ds_stack_empty(_stack))
+		{
+			var _node = ds_stack_pop(_stack);
+			_nodes[@ _node[BBMOD_ENode.Index]] = _node;
+			var _children = _node[BBMOD_ENode.Children];
+			var i = 0;
+			repeat (array_length(_children))
+			{
+				ds_stack_push(_stack, _children[i++]);
+			}
+		}
+
+		destroy_shadow_proxies();
+
+		var _format = new BBMOD_VertexFormat(true, false, false, false, false, false, false);
+		var _proxy_count = buffer_read(_buffer, buffer_u32);
+		ShadowProxies = array_create(_proxy_count, undefined);
+		var i = 0;
+		repeat (_proxy_count)
+		{
+			var _node_index = buffer_read(_buffer, buffer_u32);
+			var _vertex_count = buffer_read(_buffer, buffer_u32);
+			var _vertex_buffer = vertex_create_buffer_from_buffer_ext(
+				_buffer, _format.Raw, buffer_tell(_buffer), _vertex_count);
+			vertex_freeze(_vertex_buffer);
+			buffer_seek(_buffer, buffer_seek_relative, _vertex_count * _format.get_byte_size());
+			ShadowProxies[@ i++] = {
+				Node: _nodes[_node_index],
+				VertexBuffer: _vertex_buffer
+			};
+		}
+
+		buffer_delete(_buffer);
+		return self;
+	};
+
+	/// @func render_shadow()
+	/// @desc Submits shadow proxies of visible nodes for rendering. Use this
+	/// in depth-only passes with a shader which takes only vertex positions.
+	/// @return {BBMOD_Model} Returns `self` to allow method chaining.
+	/// @example
+	/// ```gml
+	/// mod_level.load_shadow_proxies("Level_shadow.bbshdw");
+	///
+	/// // When rendering the shadow map
+	/// shader_set(ShDepth);
+	/// mod_level.render_shadow();
+	/// shader_reset();
+	/// ```
+	/// @see BBMOD_Model.load_shadow_proxies
+	static render_shadow = function () {
+		var i = 0;
+		repeat (array_length(ShadowProxies))
+		{
+			var _proxy = ShadowProxies[i++];
+			var _node = _proxy.Node;
+			if (is_undefined(_node) || _node[BBMOD_ENode.Visible])
+			{
+				vertex_submit(_proxy.VertexBuffer, pr_trianglelist, -1);
+			}
+		}
+		return self;
+	};
+
+	/// @func destroy_shadow_proxies()
+	/// @desc Frees vertex buffers of shadow proxies.
+	/// @private
+	static destroy_shadow_proxies = function () {
+		var i = 0;
+		repeat (array_length(ShadowProxies))
+		{
+			vertex_delete_buffer(ShadowProxies[i++].VertexBuffer);
+		}
+		ShadowProxies = [];
+	};
+
 	/// @func freeze()
 	/// @desc Freezes all vertex buffers used by the model. This should make its
 	/// rendering faster, but it disables creating new batches of the model.
@@ -343,7 +755,8 @@ function BBMOD_Model(_file, _sha1) constructor
 			VertexFormat.Colors,
 			VertexFormat.TangentW,
 			_bones ? VertexFormat.Bones : false,
-			_ids);
+			_ids,
+			VertexFormat.BoneInfluences);
 	};
 
 	/// @func render([_materials[, _transform]])
@@ -351,8 +764,8 @@ function BBMOD_Model(_file, _sha1) constructor
 	/// @param {BBMOD_Material[]/undefined} [_materials] An array of materials,
 	/// one for each material slot of the model. If not specified, then
 	/// {@link BBMOD_Model.Materials} is used. Defaults to `undefined`.
-	/// @param {real[]/undefined} [_transform] An array of transformation matrices
-	/// (for animated models) or `undefined`.
+	/// @param {real[]/buffer/undefined} [_transform] An array or a buffer of
+	/// transformation matrices (for animated models) or `undefined`.
 	/// @return {BBMOD_Model} Returns `self` to allow method chaining.
 	/// @example
 	/// ```gml
@@ -405,6 +818,7 @@ function BBMOD_Model(_file, _sha1) constructor
 		{
 			bbmod_mesh_destroy(Meshes[i++]);
 		}
+		destroy_shadow_proxies();
 	};
 
 	/// @func to_dynamic_batch(_model, _dynamic_batch)
@@ -0,0 +1,307 @@
+/// @func BBMOD_NativeAnimationPlayer(_dll, _model, _native_model[, _paused])
+/// @desc An animation player which samples animations in the DLL instead of
+/// in GML. Each instance of an animated model should have its own animation
+/// player.
+/// @param {BBMOD_DLL} _dll The DLL.
+/// @param {BBMOD_Model} _model A model that the animation player animates.
+/// @param {real} _native_model A handle of the same model loaded with
+/// {@link BBMOD_DLL.model_load}.
+/// @param {bool} [_paused] If `true` then the animation player is created
+/// as paused. Defaults to `false`.
+/// @example
+/// ```gml
+/// /// @desc Create event of OResourceManager
+/// dll = new BBMOD_DLL();
+/// mod_character = new BBMOD_Model("character.bbmod");
+/// native_character = dll.model_load("character.bbmod");
+/// anim_idle = dll.animation_load("idle.bbanim");
+///
+/// /// @desc Create event of OCharacter
+/// var _res = OResourceManager;
+/// model = _res.mod_character;
+/// animation_player = new BBMOD_NativeAnimationPlayer(
+///     _res.dll, model, _res.native_character);
+/// animation_player.play(_res.anim_idle, true);
+///
+/// /// @desc Step event of OCharacter
+/// animation_player.update(delta_time);
+///
+/// /// @desc Draw event of OCharacter
+/// bbmod_material_reset();
+/// model.render(undefined, animation_player.get_transform());
+/// bbmod_material_reset();
+/// ```
+/// @see BBMOD_AnimationPlayer
+/// @see BBMOD_DLL
+function BBMOD_NativeAnimationPlayer(_dll, _model, _native_model, _paused) constructor
+{
+	/// @var {BBMOD_DLL} The DLL.
+	/// @readonly
+	Dll = _dll;
+
+	/// @var {BBMOD_Model} A model that the animation player animates.
+	/// @readonly
+	Model = _model;
+
+	/// @var {real} A handle of the pose in the DLL.
+	/// @private
+	Pose = Dll.pose_create(_native_model);
+
+	/// @var {real} A handle of a pose from which the current transition
+	/// started.
+	/// @private
+	PoseFrom = Dll.pose_create(_native_model);
+
+	/// @var {real} A handle of a pose into which is sampled the layered
+	/// animation.
+	/// @private
+	PoseLayer = Dll.pose_create(_native_model);
+
+	/// @var {real/undefined} A handle of the played animation.
+	/// @private
+	Animation = undefined;
+
+	/// @var {real} Duration of the played animation (in tics).
+	/// @private
+	AnimationDuration = 0;
+
+	/// @var {real} Number of tics per second of the played animation.
+	/// @private
+	AnimationTicsPerSecond = 0;
+
+	/// @var {bool} If `true` then the played animation is looped.
+	/// @private
+	AnimationLoop = false;
+
+	/// @var {real/undefined} Time when the animation started playing (in seconds).
+	/// @private
+	AnimationStart = undefined;
+
+	/// @var {real} Animation time in last frame.
+	/// @private
+	AnimationTimeLast = 0;
+
+	/// @var {real} Duration of the current transition (in seconds).
+	/// @private
+	TransitionDuration = 0;
+
+	/// @var {real} Time since the current transition started (in seconds).
+	/// @private
+	TransitionTime = 0;
+
+	/// @var {real/undefined} A handle of an animation played on top of the
+	/// main animation or `undefined`.
+	/// @private
+	LayerAnimation = undefined;
+
+	/// @var {real/undefined} A handle of a mask of the layered animation.
+	/// @private
+	LayerMask = undefined;
+
+	/// @var {real} Weight of the layered animation.
+	/// @private
+	LayerWeight = 1;
+
+	/// @var {real} Duration of the layered animation (in tics).
+	/// @private
+	LayerDuration = 0;
+
+	/// @var {real} Number of tics per second of the layered animation.
+	/// @private
+	LayerTicsPerSecond = 0;
+
+	/// @var {real} Time when the layered animation started playing (in seconds).
+	/// @private
+	LayerStart = 0;
+
+	/// @var {buffer} A buffer containing transformation matrices of all bones.
+	/// @private
+	TransformBuffer = buffer_create(max(Model.BoneCount, 1) * 64, buffer_fixed, 4);
+
+	/// @var {buffer} A buffer used to retrieve node transforms.
+	/// @private
+	NodeTransformBuffer = buffer_create(64, buffer_fixed, 4);
+
+	/// @var {bool} If `true` then the pose in TransformBuffer is valid.
+	/// @private
+	Animated = false;
+
+	/// @var {bool} If `true`, then the animation playback is paused.
+	Paused = !is_undefined(_paused) ? _paused : false;
+
+	/// @var {real} The current animation playback time.
+	Time = 0;
+
+	/// @var {real} Controls animation playback speed.
+	PlaybackSpeed = 1;
+
+	/// @var {bool} If `true`, then the animation player interpolates between
+	/// frames.
+	InterpolateFrames = true;
+
+	/// @var {real} Duration of crossfades between animations (in seconds).
+	/// Use 0 to switch animations immediately.
+	Transition = 0.1;
+
+	/// @var {function/undefined} A function executed when an animation event
+	/// occurs. It will be given two arguments - the event type and a handle
+	/// of the animation. Use `undefined` for no function.
+	/// @see BBMOD_EV_ANIMATION_END
+	OnEvent = undefined;
+
+	/// @func update(_delta_time)
+	/// @desc Updates the animation player. This should be called every frame in
+	/// the step event.
+	/// @param {real} _delta_time The `delta_time`.
+	/// @return {BBMOD_NativeAnimationPlayer} Returns `self` to allow method chaining.
+	static update = function (_delta_time) {
+		if (Paused || is_undefined(Animation))
+		{
+			return self;
+		}
+
+		Time += _delta_time * 0.000001 * PlaybackSpeed;
+
+		if (is_undefined(AnimationStart))
+		{
+			AnimationStart = Time;
+		}
+
+		var _animation_time = ((Time - AnimationStart) * AnimationTicsPerSecond) mod AnimationDuration;
+
+		if (_animation_time < AnimationTimeLast && !AnimationLoop)
+		{
+			var _animation = Animation;
+			Animation = undefined;
+			if (OnEvent != undefined)
+			{
+				OnEvent(BBMOD_EV_ANIMATION_END, _animation);
+			}
+			return self;
+		}
+
+		AnimationTimeLast = _animation_time;
+
+		var _dll = Dll;
+		var _pose = Pose;
+
+		_dll.pose_sample(_pose, Animation, _animation_time, InterpolateFrames);
+
+		if (TransitionTime < TransitionDuration)
+		{
+			TransitionTime += _delta_time * 0.000001;
+			var _factor = min(TransitionTime / TransitionDuration, 1);
+			_dll.pose_blend(_pose, PoseFrom, 1 - _factor);
+		}
+
+		if (!is_undefined(LayerAnimation))
+		{
+			var _layer_time = ((Time - LayerStart) * LayerTicsPerSecond) mod LayerDuration;
+			_dll.pose_sample(PoseLayer, LayerAnimation, _layer_time, InterpolateFrames);
+			_dll.pose_blend(_pose, PoseLayer, LayerWeight, LayerMask);
+		}
+
+		_dll.pose_transform(_pose, TransformBuffer);
+		Animated = true;
+
+		return self;
+	};
+
+	/// @func play(_animation[, _loop])
+	/// @desc Starts playing an animation. The transition from the current
+	/// pose is blended natively, see {@link BBMOD_NativeAnimationPlayer.Transition}.
+	/// @param {real} _animation A handle of an animation loaded with
+	/// {@link BBMOD_DLL.animation_load}.
+	/// @param {bool} [_loop] If `true` then the animation will be looped. Defaults
+	/// to `false`.
+	/// @return {BBMOD_NativeAnimationPlayer} Returns `self` to allow method chaining.
+	static play = function (_animation, _loop) {
+		if (Animated && Transition > 0)
+		{
+			Dll.pose_copy(PoseFrom, Pose);
+			TransitionDuration = Transition;
+			TransitionTime = 0;
+		}
+		else
+		{
+			TransitionDuration = 0;
+		}
+		Animation = _animation;
+		AnimationDuration = Dll.animation_get_duration(_animation);
+		AnimationTicsPerSecond = Dll.animation_get_tics_per_second(_animation);
+		AnimationLoop = !is_undefined(_loop) ? _loop : false;
+		AnimationStart = undefined;
+		AnimationTimeLast = 0;
+		return self;
+	};
+
+	/// @func set_layer(_animation[, _mask[, _weight]])
+	/// @desc Plays a looping animation on top of the main animation, for
+	/// example on the upper body only.
+	/// @param {real/undefined} _animation A handle of the animation or
+	/// `undefined` to remove the layer.
+	/// @param {real} [_mask] A handle of a mask created with
+	/// {@link BBMOD_DLL.mask_create}. By default the whole body is affected.
+	/// @param {real} [_weight] The weight of the layer, from 0 to 1.
+	/// Defaults to 1.
+	/// @return {BBMOD_NativeAnimationPlayer} Returns `self` to allow method chaining.
+	static set_layer = function (_animation, _mask, _weight) {
+		LayerAnimation = _animation;
+		LayerMask = _mask;
+		LayerWeight = !is_undefined(_weight) ? _weight : 1;
+		if (!is_undefined(_animation))
+		{
+			LayerDuration = Dll.animation_get_duration(_animation);
+			LayerTicsPerSecond = Dll.animation_get_tics_per_second(_animation);
+			LayerStart = Time;
+		}
+		return self;
+	};
+
+	/// @func get_transform()
+	/// @desc Returns current transformation matrices of all bones.
+	/// @return {buffer/real[]} A buffer with the transformation matrices or
+	/// the bind pose if no animation was played yet. Both can be passed to
+	/// {@link BBMOD_Model.render}.
+	static get_transform = function () {
+		gml_pragma("forceinline");
+		if (Animated)
+		{
+			return TransformBuffer;
+		}
+		return Model.get_bindpose_transform();
+	};
+
+	/// @func get_node_transform(_node_index)
+	/// @desc Returns a transformation matrix of a node, which can be used
+	/// for example for attachments.
+	/// @param {real} _node_index An index of a node.
+	/// @return {real[]} The transformation matrix.
+	static get_node_transform = function (_node_index) {
+		if (!Animated)
+		{
+			return matrix_build_identity();
+		}
+		var _buffer = NodeTransformBuffer;
+		Dll.pose_get_node_transform(Pose, _node_index, _buffer);
+		var _matrix = array_create(16, 0);
+		buffer_seek(_buffer, buffer_seek_start, 0);
+		var i = 0;
+		repeat (16)
+		{
+			_matrix[@ i++] = buffer_read(_buffer, buffer_f32);
+		}
+		return _matrix;
+	};
+
+	/// @func destroy()
+	/// @desc Frees memory used by the animation player. Use this in combination
+	/// with `delete` to destroy the struct.
+	static destroy = function () {
+		Dll.pose_destroy(Pose);
+		Dll.pose_destroy(PoseFrom);
+		Dll.pose_destroy(PoseLayer);
+		buffer_delete(TransformBuffer);
+		buffer_delete(NodeTransformBuffer);
+	};
+}
\ No newline at end of file
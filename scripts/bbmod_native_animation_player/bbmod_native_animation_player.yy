@@ -0,0 +1,12 @@
+{
+  "isDnD": false,
+  "isCompatibility": false,
+  "parent": {
+    "name": "Animation",
+    "path": "folders/BBMOD/Scripts/Animation.yy",
+  },
+  "resourceVersion": "1.0",
+  "name": "bbmod_native_animation_player",
+  "tags": [],
+  "resourceType": "GMScript",
+}
\ No newline at end of file
@@ -81,8 +81,8 @@ function bbmod_node_load(_buffer, _format)
 /// @param {BBMOD_ENode} _node The node.
 /// @param {BBMOD_Material[]} _materials An array of materials, one for each
 /// material slot of the model.
-/// @param {real[]/undefined} _transform An array of transformation matrices
-/// (for animated models) or `undefined`.
+/// @param {real[]/buffer/undefined} _transform An array or a buffer of
+/// transformation matrices (for animated models) or `undefined`.
 /// @private
 function bbmod_node_render(_model, _node, _materials, _transform)
 {
@@ -118,13 +118,29 @@ function bbmod_node_render(_model, _node, _materials, _transform)
 				continue;
 			}
 
-			if (_material.apply() && !is_undefined(_transform))
+			// Meshes with fewer bone influences need a matching shader variant
+			var _shader = _material.Shader;
+			var _format = _mesh[BBMOD_EMesh.VertexFormat];
+			if (_format.Bones && _format.BoneInfluences != 4)
 			{
-				shader_set_uniform_f_array(shader_get_uniform(shader_current(), "u_mBones"), _transform);
+				_shader = bbmod_shader_get_skinning_variant(_shader, _format.BoneInfluences);
+			}
+
+			if (_material.apply(_shader) && !is_undefined(_transform))
+			{
+				var _u_bones = shader_get_uniform(shader_current(), "u_mBones");
+				if (is_array(_transform))
+				{
+					shader_set_uniform_f_array(_u_bones, _transform);
+				}
+				else
+				{
+					shader_set_uniform_f_buffer(_u_bones, _transform, 0, buffer_get_size(_transform) div 4);
+				}
 			}
 
 			var _tex_base = _material.BaseOpacity;
-			vertex_submit(_mesh[BBMOD_EMesh.VertexBuffer], pr_trianglelist, _tex_base);
+			vertex_submit(_mesh[BBMOD_EMesh.VertexBuffer], _mesh[BBMOD_EMesh.PrimitiveType], _tex_base);
 		}
 
 		i = 0;
@@ -15,6 +15,11 @@ global.__bbmod_ibl_texture = pointer_null;
 /// @private
 global.__bbmod_ibl_texel = 0;
 
+/// @var {ds_map<shader, shader[]>} Skinning variants of shaders, indexed by
+/// the number of bone influences.
+/// @private
+global.__bbmod_shader_skinning_variants = ds_map_create();
+
 /// @func _bbmod_shader_set_camera_position(_shader[, _camera_position])
 /// @param {shader} _shader
 /// @param {real[]} [_camera_position]
@@ -124,12 +129,65 @@ function bbmod_set_ibl_texture(_texture, _texel)
 		var _material = global.__bbmod_material_current;
 		if (_material != BBMOD_NONE)
 		{
-			var _shader = _material.Shader;
+			// The current shader can be a skinning variant of the material's shader
+			var _shader = shader_current();
 			_bbmod_shader_set_ibl(_shader, _texture, _texel);
 		}
 	}
 }
 
+/// @func bbmod_shader_set_skinning_variant(_shader, _bone_influences, _variant)
+/// @desc Registers a variant of a shader used to render skinned meshes whose
+/// vertices are influenced by fewer than 4 bones. Such meshes are created by
+/// the converter with `--split-influences=true` and have only 1 or 2 bone
+/// indices and weights per vertex, so they cannot be rendered with the
+/// original shader. Variants of {@link BBMOD_ShDefaultAnimated} are registered
+/// by default.
+/// @param {shader} _shader The shader used by a material.
+/// @param {real} _bone_influences The number of bones influencing each vertex,
+/// either 1 or 2.
+/// @param {shader} _variant A shader with the same uniforms as `_shader`,
+/// which skins vertices using only the given number of bones.
+/// @example
+/// ```gml
+/// bbmod_shader_set_skinning_variant(ShCharacter, 1, ShCharacter1);
+/// bbmod_shader_set_skinning_variant(ShCharacter, 2, ShCharacter2);
+/// ```
+/// @see bbmod_shader_get_skinning_variant
+/// @see BBMOD_VertexFormat.BoneInfluences
+function bbmod_shader_set_skinning_variant(_shader, _bone_influences, _variant)
+{
+	var _variants = global.__bbmod_shader_skinning_variants[? _shader];
+	if (is_undefined(_variants))
+	{
+		_variants = array_create(5, undefined);
+		global.__bbmod_shader_skinning_variants[? _shader] = _variants;
+	}
+	_variants[@ _bone_influences] = _variant;
+}
+
+/// @func bbmod_shader_get_skinning_variant(_shader, _bone_influences)
+/// @desc Retrieves a variant of a shader used to render skinned meshes whose
+/// vertices are influenced by the given number of bones.
+/// @param {shader} _shader The shader used by a material.
+/// @param {real} _bone_influences The number of bones influencing each vertex.
+/// @return {shader} The variant or `_shader` if no variant is registered.
+/// @see bbmod_shader_set_skinning_variant
+function bbmod_shader_get_skinning_variant(_shader, _bone_influences)
+{
+	gml_pragma("forceinline");
+	var _variants = global.__bbmod_shader_skinning_variants[? _shader];
+	if (is_undefined(_variants))
+	{
+		return _shader;
+	}
+	var _variant = _variants[_bone_influences];
+	return !is_undefined(_variant) ? _variant : _shader;
+}
+
+bbmod_shader_set_skinning_variant(BBMOD_ShDefaultAnimated, 1, BBMOD_ShDefaultAnimated1);
+bbmod_shader_set_skinning_variant(BBMOD_ShDefaultAnimated, 2, BBMOD_ShDefaultAnimated2);
+
 // FIXME: Initial IBL setup
 global.__bbmod_material_current = BBMOD_NONE;
 var _spr_ibl = sprite_add("BBMOD/Skies/NoonIBL.png", 0, false, true, 0, 0);
@@ -75,6 +75,77 @@ function BBMOD_StaticBatch(_vformat) constructor
 		return self;
 	};
 
+	/// @func add_mesh(_model, _mesh_index, _transform)
+	/// @desc Adds a single mesh of a model to the static batch.
+	/// @param {BBMOD_Model} _model The model.
+	/// @param {real} _mesh_index An index of the mesh.
+	/// @param {real[]} _transform A transformation matrix of the mesh.
+	/// @return {BBMOD_StaticBatch} Returns `self` to allow method chaining.
+	/// @note You must first call {@link BBMOD_StaticBatch.begin} before using this
+	/// function!
+	/// @see BBMOD_Model.load_instances
+	/// @see BBMOD_StaticBatch.finish
+	static add_mesh = function (_model, _mesh_index, _transform) {
+		gml_pragma("forceinline");
+		_bbmod_mesh_to_static_batch(_model, _model.Meshes[_mesh_index], self, _transform);
+		return self;
+	};
+
+	/// @func from_dll(_dll, _model, _transforms, _count)
+	/// @desc Fills the static batch with instances of a model in a single
+	/// call. The vertices are transformed natively on multiple threads, which
+	/// is much faster than adding the instances one by one. This replaces
+	/// any models added to the static batch before, so it must not be used
+	/// between {@link BBMOD_StaticBatch.start} and
+	/// {@link BBMOD_StaticBatch.finish}.
+	/// @param {BBMOD_DLL} _dll The DLL.
+	/// @param {real} _model A handle of the model loaded with
+	/// {@link BBMOD_DLL.model_load}.
+	/// @param {buffer} _transforms A buffer with a matrix for each instance,
+	/// stored as 16 `buffer_f32` values.
+	/// @param {real} _count Number of instances.
+	/// @return {BBMOD_StaticBatch} Returns `self` to allow method chaining.
+	/// @throws {BBMOD_Error} If the model handle is not valid or the batch
+	/// cannot be built.
+	/// @example
+	/// ```gml
+	/// var _count = instance_number(OTree);
+	/// var _transforms = buffer_create(_count * 64, buffer_fixed, 4);
+	/// with (OTree)
+	/// {
+	///     var _transform = matrix_build(x, y, z, 0, 0, direction, 1, 1, 1);
+	///     var i = 0;
+	///     repeat (16)
+	///     {
+	///         buffer_write(_transforms, buffer_f32, _transform[i++]);
+	///     }
+	/// }
+	/// batch = new BBMOD_StaticBatch(mod_tree.get_vertex_format());
+	/// batch.from_dll(dll, native_tree, _transforms, _count);
+	/// batch.freeze();
+	/// buffer_delete(_transforms);
+	/// ```
+	static from_dll = function (_dll, _model, _transforms, _count) {
+		var _size = _dll.model_get_static_batch_size(_model, _count);
+		if (_size == BBMOD_DLL_FAILURE)
+		{
+			throw new BBMOD_Error("Could not get size of the static batch!");
+		}
+		vertex_delete_buffer(VertexBuffer);
+		if (_size == 0)
+		{
+			VertexBuffer = vertex_create_buffer();
+			vertex_begin(VertexBuffer, VertexFormat.Raw);
+			vertex_end(VertexBuffer);
+			return self;
+		}
+		var _buffer = buffer_create(_size, buffer_fixed, 1);
+		_dll.model_to_static_batch(_model, _transforms, _count, _buffer);
+		VertexBuffer = vertex_create_buffer_from_buffer(_buffer, VertexFormat.Raw);
+		buffer_delete(_buffer);
+		return self;
+	};
+
 	/// @func finish()
 	/// @desc Ends adding models into the static batch.
 	/// @return {BBMOD_StaticBatch} Returns `self` to allow method chaining.
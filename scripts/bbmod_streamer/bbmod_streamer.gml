@@ -0,0 +1,180 @@
+/// @macro {real} A type of streamed item which is a "*.bbmod" model.
+/// @see BBMOD_DLL.stream_load
+#macro BBMOD_STREAM_MODEL 0
+
+/// @macro {real} A type of streamed item which is a "*.bbanim" animation.
+/// @see BBMOD_DLL.stream_load
+#macro BBMOD_STREAM_ANIMATION 1
+
+/// @macro {real} A state of a streamed item which waits in the queue.
+/// @see BBMOD_DLL.stream_get_state
+#macro BBMOD_STREAM_QUEUED 0
+
+/// @macro {real} A state of a streamed item which is being loaded.
+/// @see BBMOD_DLL.stream_get_state
+#macro BBMOD_STREAM_LOADING 1
+
+/// @macro {real} A state of a streamed item which is loaded.
+/// @see BBMOD_DLL.stream_get_state
+#macro BBMOD_STREAM_DONE 2
+
+/// @macro {real} A state of a streamed item which failed to load.
+/// @see BBMOD_DLL.stream_get_state
+#macro BBMOD_STREAM_FAILED 3
+
+/// @func BBMOD_Streamer(_dll)
+/// @desc Loads models and animations on background threads of the DLL, so
+/// loading many files does not stall the game.
+/// @param {BBMOD_DLL} _dll The DLL to load the files with.
+/// @example
+/// ```gml
+/// // Create event
+/// streamer = new BBMOD_Streamer(dll);
+/// streamer.load_model("tree.bbmod", 1, function (_model) {
+///     mod_tree = _model;
+/// });
+///
+/// // Step event
+/// streamer.update(4);
+///
+/// // Clean Up event
+/// streamer.destroy();
+/// ```
+function BBMOD_Streamer(_dll) constructor
+{
+	/// @var {BBMOD_DLL} The DLL which loads the files.
+	/// @readonly
+	Dll = _dll;
+
+	/// @var {ds_map} Maps ids of streamed items to arrays
+	/// `[type, file, callback]`.
+	/// @private
+	Requests = ds_map_create();
+
+	/// @func load(_file, _type, _priority, _callback)
+	/// @desc Enqueues a file to be loaded.
+	/// @param {string} _file Path to the file.
+	/// @param {real} _type {@link BBMOD_STREAM_MODEL} or
+	/// {@link BBMOD_STREAM_ANIMATION}.
+	/// @param {real} _priority Files with higher priority are loaded first.
+	/// @param {function} _callback A function executed in
+	/// {@link BBMOD_Streamer.update} with the loaded model or animation, or
+	/// with `undefined` if the file failed to load.
+	/// @return {real} An id of the request, which can be used to cancel it.
+	/// @private
+	static load = function (_file, _type, _priority, _callback) {
+		var _id = Dll.stream_load(_file, _type, _priority);
+		Requests[? _id] = [_type, _file, _callback];
+		return _id;
+	};
+
+	/// @func load_model(_file, _priority, _callback)
+	/// @desc Enqueues a model to be loaded.
+	/// @param {string} _file Path to the "*.bbmod" file.
+	/// @param {real} _priority Files with higher priority are loaded first.
+	/// @param {function} _callback A function executed with the loaded
+	/// {@link BBMOD_Model} or `undefined` if the file failed to load.
+	/// @return {real} An id of the request, which can be used to cancel it.
+	/// @see BBMOD_Streamer.cancel
+	static load_model = function (_file, _priority, _callback) {
+		gml_pragma("forceinline");
+		return load(_file, BBMOD_STREAM_MODEL, _priority, _callback);
+	};
+
+	/// @func load_animation(_file, _priority, _callback)
+	/// @desc Enqueues an animation to be loaded.
+	/// @param {string} _file Path to the "*.bbanim" file.
+	/// @param {real} _priority Files with higher priority are loaded first.
+	/// @param {function} _callback A function executed with the loaded
+	/// {@link BBMOD_Animation} or `undefined` if the file failed to load.
+	/// @return {real} An id of the request, which can be used to cancel it.
+	/// @see BBMOD_Streamer.cancel
+	static load_animation = function (_file, _priority, _callback) {
+		gml_pragma("forceinline");
+		return load(_file, BBMOD_STREAM_ANIMATION, _priority, _callback);
+	};
+
+	/// @func cancel(_id)
+	/// @desc Cancels a request. Its callback will not be executed.
+	/// @param {real} _id The id of the request.
+	/// @return {BBMOD_Streamer} Returns `self` to allow method chaining.
+	static cancel = function (_id) {
+		if (ds_map_exists(Requests, _id))
+		{
+			ds_map_delete(Requests, _id);
+			Dll.stream_remove(_id);
+		}
+		return self;
+	};
+
+	/// @func update([_max])
+	/// @desc Creates models and animations from files which have finished
+	/// loading and executes callbacks of their requests. Should be called
+	/// each step.
+	/// @param {real} [_max] The maximum number of files processed in this
+	/// call. Defaults to all finished files. Use this to spread creating of
+	/// vertex buffers across multiple steps.
+	/// @return {BBMOD_Streamer} Returns `self` to allow method chaining.
+	static update = function (_max) {
+		_max = !is_undefined(_max) ? _max : infinity;
+
+		while (_max > 0)
+		{
+			var _id = Dll.stream_poll();
+			if (is_undefined(_id))
+			{
+				break;
+			}
+
+			var _request = Requests[? _id];
+			if (is_undefined(_request))
+			{
+				Dll.stream_remove(_id);
+				continue;
+			}
+			ds_map_delete(Requests, _id);
+
+			var _asset = undefined;
+
+			if (Dll.stream_get_state(_id) == BBMOD_STREAM_DONE)
+			{
+				var _buffer = buffer_create(Dll.stream_get_size(_id), buffer_fixed, 1);
+				Dll.stream_write(_id, _buffer);
+
+				if (_request[0] == BBMOD_STREAM_MODEL)
+				{
+					_asset = new BBMOD_Model(undefined).from_blob(_buffer);
+				}
+				else
+				{
+					// Staged animations do not contain the file header
+					_asset = new BBMOD_Animation(undefined);
+					_asset.Version = BBMOD_VERSION;
+					_asset.from_buffer(_buffer);
+				}
+
+				buffer_delete(_buffer);
+			}
+
+			Dll.stream_remove(_id);
+
+			var _callback = _request[2];
+			_callback(_asset);
+			--_max;
+		}
+
+		return self;
+	};
+
+	/// @func destroy()
+	/// @desc Cancels all requests and frees memory used by the streamer.
+	static destroy = function () {
+		var _id = ds_map_find_first(Requests);
+		while (!is_undefined(_id))
+		{
+			Dll.stream_remove(_id);
+			_id = ds_map_find_next(Requests, _id);
+		}
+		ds_map_destroy(Requests);
+	};
+}
\ No newline at end of file
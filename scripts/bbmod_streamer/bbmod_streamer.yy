@@ -0,0 +1,12 @@
+{
+  "isDnD": false,
+  "isCompatibility": false,
+  "parent": {
+    "name": "Scripts",
+    "path": "folders/BBMOD/Scripts.yy",
+  },
+  "resourceVersion": "1.0",
+  "name": "bbmod_streamer",
+  "tags": [],
+  "resourceType": "GMScript",
+}
\ No newline at end of file
@@ -13,6 +13,42 @@ function bbmod_load_matrix(_buffer)
 	return _matrix;
 }
 
+/// @func bbmod_load_sidecar(_file, _type)
+/// @desc Loads a file saved next to a model by the converter, e.g. a
+/// "*.bbinst" file, and checks its header.
+/// @param {string} _file The path to the file.
+/// @param {string} _type The expected file type, e.g. "bbinst".
+/// @return {buffer} A buffer with the file, positioned right after the
+/// header. It must be deleted when it is no longer needed.
+/// @throws {BBMOD_Error} If the file does not exist or it has a different
+/// type or version.
+/// @private
+function bbmod_load_sidecar(_file, _type)
+{
+	if (!file_exists(_file))
+	{
+		throw new BBMOD_Error("File " + _file + " does not exist!");
+	}
+
+	var _buffer = buffer_load(_file);
+	buffer_seek(_buffer, buffer_seek_start, 0);
+
+	if (buffer_read(_buffer, buffer_string) != _type)
+	{
+		buffer_delete(_buffer);
+		throw new BBMOD_Error("Not a " + string_upper(_type) + " file!");
+	}
+
+	var _version = buffer_read(_buffer, buffer_u8);
+	if (_version != BBMOD_VERSION)
+	{
+		buffer_delete(_buffer);
+		throw new BBMOD_Error("Invalid version " + string(_version) + "!");
+	}
+
+	return _buffer;
+}
+
 /// @func bbmod_load_quaternion(_buffer)
 /// @desc Loads a quaternion from a buffer.
 /// @param {buffer} _buffer The buffer to load a quaternion from.
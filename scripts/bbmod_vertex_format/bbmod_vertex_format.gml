@@ -1,4 +1,4 @@
-/// @func BBMOD_VertexFormat(_vertices, _normals, _uvs, _colors, _tangentw, _bones, _ids)
+/// @func BBMOD_VertexFormat(_vertices, _normals, _uvs, _colors, _tangentw, _bones, _ids[, _bone_influences])
 /// @desc A wrapper of a raw GameMaker vertex format.
 /// @param {bool} _vertices If `true` then the vertex format must have vertices.
 /// @param {bool} _normals If `true` then the vertex format must have normal vectors.
@@ -9,7 +9,9 @@
 /// @param {bool} _bones If `true` then the vertex format must have vertex weights and bone
 /// indices.
 /// @param {bool} _ids If `true` then the vertex format must have ids for dynamic batching.
-function BBMOD_VertexFormat(_vertices, _normals, _uvs, _colors, _tangentw, _bones, _ids) constructor
+/// @param {real} [_bone_influences] The number of bones influencing each vertex,
+/// either 1, 2 or 4. Defaults to 4.
+function BBMOD_VertexFormat(_vertices, _normals, _uvs, _colors, _tangentw, _bones, _ids, _bone_influences) constructor
 {
 	/// @var {bool} If `true` then the vertex foramt has vertices.
 	/// @readonly
@@ -36,6 +38,13 @@ function BBMOD_VertexFormat(_vertices, _normals, _uvs, _colors, _tangentw, _bone
 	/// indices.
 	Bones = _bones;
 
+	/// @var {real} The number of bones influencing each vertex, either 1, 2
+	/// or 4. Vertices with a single influence have only a bone index and
+	/// need a matching shader variant.
+	/// @see bbmod_shader_get_skinning_variant
+	/// @readonly
+	BoneInfluences = !is_undefined(_bone_influences) ? _bone_influences : 4;
+
 	/// @var {bool} If `true` then the vertex foramt has ids for dynamic batching.
 	/// @readonly
 	Ids = _ids;
@@ -59,7 +68,24 @@ function BBMOD_VertexFormat(_vertices, _normals, _uvs, _colors, _tangentw, _bone
 			| (Colors << 3)
 			| (TangentW << 4)
 			| (Bones << 5)
-			| (Ids << 6));
+			| (Ids << 6)
+			| ((Bones ? BoneInfluences : 0) << 8));
+	};
+
+	/// @func get_byte_size()
+	/// @desc Retrieves the size of a single vertex using the vertex format
+	/// in bytes.
+	/// @return {int} The vertex size in bytes.
+	static get_byte_size = function () {
+		gml_pragma("forceinline");
+		return (0
+			+ Vertices * 3 * buffer_sizeof(buffer_f32)
+			+ Normals * 3 * buffer_sizeof(buffer_f32)
+			+ TextureCoords * 2 * buffer_sizeof(buffer_f32)
+			+ Colors * buffer_sizeof(buffer_u32)
+			+ TangentW * 4 * buffer_sizeof(buffer_f32)
+			+ Bones * ((BoneInfluences > 1) ? BoneInfluences * 2 : 1) * buffer_sizeof(buffer_f32)
+			+ Ids * buffer_sizeof(buffer_f32));
 	};
 
 	var _hash = get_hash();
@@ -99,8 +125,23 @@ function BBMOD_VertexFormat(_vertices, _normals, _uvs, _colors, _tangentw, _bone
 
 		if (Bones)
 		{
-			vertex_format_add_custom(vertex_type_float4, vertex_usage_texcoord);
-			vertex_format_add_custom(vertex_type_float4, vertex_usage_texcoord);
+			switch (BoneInfluences)
+			{
+			case 1:
+				// The weight of a single bone is always 1
+				vertex_format_add_custom(vertex_type_float1, vertex_usage_texcoord);
+				break;
+
+			case 2:
+				vertex_format_add_custom(vertex_type_float2, vertex_usage_texcoord);
+				vertex_format_add_custom(vertex_type_float2, vertex_usage_texcoord);
+				break;
+
+			default:
+				vertex_format_add_custom(vertex_type_float4, vertex_usage_texcoord);
+				vertex_format_add_custom(vertex_type_float4, vertex_usage_texcoord);
+				break;
+			}
 		}
 
 		if (Ids)
@@ -145,7 +186,8 @@ function bbmod_vertex_format_load(_buffer)
 	var _textureCoords = buffer_read(_buffer, buffer_bool);
 	var _colors = buffer_read(_buffer, buffer_bool);
 	var _tangentW = buffer_read(_buffer, buffer_bool);
-	var _bones = buffer_read(_buffer, buffer_bool);
+	// Saved as the number of bone influences, 0 if there are no bones
+	var _bones = buffer_read(_buffer, buffer_u8);
 	var _ids = buffer_read(_buffer, buffer_bool);
 
 	return new BBMOD_VertexFormat(
@@ -154,6 +196,7 @@ function bbmod_vertex_format_load(_buffer)
 		_textureCoords,
 		_colors,
 		_tangentW,
-		_bones,
-		_ids);
+		(_bones != 0),
+		_ids,
+		(_bones != 0) ? _bones : 4);
 }
\ No newline at end of file
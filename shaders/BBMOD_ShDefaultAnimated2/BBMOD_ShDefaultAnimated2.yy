@@ -0,0 +1,11 @@
+{
+  "type": 1,
+  "parent": {
+    "name": "Shaders",
+    "path": "folders/BBMOD/Shaders.yy",
+  },
+  "resourceVersion": "1.0",
+  "name": "BBMOD_ShDefaultAnimated2",
+  "tags": [],
+  "resourceType": "GMShader",
+}
\ No newline at end of file